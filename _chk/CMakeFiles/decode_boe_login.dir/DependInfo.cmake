@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/examples/decode_boe_login.cpp" "CMakeFiles/decode_boe_login.dir/examples/decode_boe_login.cpp.o" "gcc" "CMakeFiles/decode_boe_login.dir/examples/decode_boe_login.cpp.o.d"
+  "/root/repo/generated/cboe_boe_v3/decoder.cpp" "CMakeFiles/decode_boe_login.dir/generated/cboe_boe_v3/decoder.cpp.o" "gcc" "CMakeFiles/decode_boe_login.dir/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "/root/repo/generated/cboe_boe_v3/encoder.cpp" "CMakeFiles/decode_boe_login.dir/generated/cboe_boe_v3/encoder.cpp.o" "gcc" "CMakeFiles/decode_boe_login.dir/generated/cboe_boe_v3/encoder.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
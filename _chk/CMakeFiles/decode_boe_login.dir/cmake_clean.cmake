@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decode_boe_login.dir/examples/decode_boe_login.cpp.o"
+  "CMakeFiles/decode_boe_login.dir/examples/decode_boe_login.cpp.o.d"
+  "CMakeFiles/decode_boe_login.dir/generated/cboe_boe_v3/decoder.cpp.o"
+  "CMakeFiles/decode_boe_login.dir/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "CMakeFiles/decode_boe_login.dir/generated/cboe_boe_v3/encoder.cpp.o"
+  "CMakeFiles/decode_boe_login.dir/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "decode_boe_login"
+  "decode_boe_login.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decode_boe_login.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
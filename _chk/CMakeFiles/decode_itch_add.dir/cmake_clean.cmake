@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decode_itch_add.dir/examples/decode_itch_add.cpp.o"
+  "CMakeFiles/decode_itch_add.dir/examples/decode_itch_add.cpp.o.d"
+  "CMakeFiles/decode_itch_add.dir/generated/nasdaq_itch_5/decoder.cpp.o"
+  "CMakeFiles/decode_itch_add.dir/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "CMakeFiles/decode_itch_add.dir/generated/nasdaq_itch_5/encoder.cpp.o"
+  "CMakeFiles/decode_itch_add.dir/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "decode_itch_add"
+  "decode_itch_add.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decode_itch_add.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
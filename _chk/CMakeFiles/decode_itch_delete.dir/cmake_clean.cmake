@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decode_itch_delete.dir/examples/decode_itch_delete.cpp.o"
+  "CMakeFiles/decode_itch_delete.dir/examples/decode_itch_delete.cpp.o.d"
+  "CMakeFiles/decode_itch_delete.dir/generated/nasdaq_itch_5/decoder.cpp.o"
+  "CMakeFiles/decode_itch_delete.dir/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "CMakeFiles/decode_itch_delete.dir/generated/nasdaq_itch_5/encoder.cpp.o"
+  "CMakeFiles/decode_itch_delete.dir/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "decode_itch_delete"
+  "decode_itch_delete.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decode_itch_delete.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/encode_boe_login.dir/examples/encode_boe_login.cpp.o"
+  "CMakeFiles/encode_boe_login.dir/examples/encode_boe_login.cpp.o.d"
+  "CMakeFiles/encode_boe_login.dir/generated/cboe_boe_v3/decoder.cpp.o"
+  "CMakeFiles/encode_boe_login.dir/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "CMakeFiles/encode_boe_login.dir/generated/cboe_boe_v3/encoder.cpp.o"
+  "CMakeFiles/encode_boe_login.dir/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "encode_boe_login"
+  "encode_boe_login.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/encode_boe_login.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/encode_itch_add.dir/examples/encode_itch_add.cpp.o"
+  "CMakeFiles/encode_itch_add.dir/examples/encode_itch_add.cpp.o.d"
+  "CMakeFiles/encode_itch_add.dir/generated/nasdaq_itch_5/decoder.cpp.o"
+  "CMakeFiles/encode_itch_add.dir/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "CMakeFiles/encode_itch_add.dir/generated/nasdaq_itch_5/encoder.cpp.o"
+  "CMakeFiles/encode_itch_add.dir/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "encode_itch_add"
+  "encode_itch_add.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/encode_itch_add.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
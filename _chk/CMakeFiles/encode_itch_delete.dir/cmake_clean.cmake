@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/encode_itch_delete.dir/examples/encode_itch_delete.cpp.o"
+  "CMakeFiles/encode_itch_delete.dir/examples/encode_itch_delete.cpp.o.d"
+  "CMakeFiles/encode_itch_delete.dir/generated/nasdaq_itch_5/decoder.cpp.o"
+  "CMakeFiles/encode_itch_delete.dir/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "CMakeFiles/encode_itch_delete.dir/generated/nasdaq_itch_5/encoder.cpp.o"
+  "CMakeFiles/encode_itch_delete.dir/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "encode_itch_delete"
+  "encode_itch_delete.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/encode_itch_delete.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
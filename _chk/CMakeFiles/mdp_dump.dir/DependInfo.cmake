@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/generated/cboe_boe_v3/decoder.cpp" "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/decoder.cpp.o" "gcc" "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "/root/repo/generated/cboe_boe_v3/encoder.cpp" "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/encoder.cpp.o" "gcc" "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "/root/repo/generated/cboe_boe_v3/json.cpp" "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/json.cpp.o" "gcc" "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/json.cpp.o.d"
+  "/root/repo/generated/nasdaq_itch_5/decoder.cpp" "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/decoder.cpp.o" "gcc" "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "/root/repo/generated/nasdaq_itch_5/encoder.cpp" "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/encoder.cpp.o" "gcc" "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "/root/repo/generated/nasdaq_itch_5/json.cpp" "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/json.cpp.o" "gcc" "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/json.cpp.o.d"
+  "/root/repo/tools/mdp_dump.cpp" "CMakeFiles/mdp_dump.dir/tools/mdp_dump.cpp.o" "gcc" "CMakeFiles/mdp_dump.dir/tools/mdp_dump.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
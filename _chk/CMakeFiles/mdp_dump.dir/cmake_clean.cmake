@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/decoder.cpp.o"
+  "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/encoder.cpp.o"
+  "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/json.cpp.o"
+  "CMakeFiles/mdp_dump.dir/generated/cboe_boe_v3/json.cpp.o.d"
+  "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/decoder.cpp.o"
+  "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/encoder.cpp.o"
+  "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/json.cpp.o"
+  "CMakeFiles/mdp_dump.dir/generated/nasdaq_itch_5/json.cpp.o.d"
+  "CMakeFiles/mdp_dump.dir/tools/mdp_dump.cpp.o"
+  "CMakeFiles/mdp_dump.dir/tools/mdp_dump.cpp.o.d"
+  "mdp_dump"
+  "mdp_dump.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mdp_dump.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
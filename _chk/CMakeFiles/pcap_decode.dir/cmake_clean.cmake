@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pcap_decode.dir/generated/cboe_boe_v3/decoder.cpp.o"
+  "CMakeFiles/pcap_decode.dir/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "CMakeFiles/pcap_decode.dir/generated/cboe_boe_v3/encoder.cpp.o"
+  "CMakeFiles/pcap_decode.dir/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "CMakeFiles/pcap_decode.dir/generated/cboe_boe_v3/json.cpp.o"
+  "CMakeFiles/pcap_decode.dir/generated/cboe_boe_v3/json.cpp.o.d"
+  "CMakeFiles/pcap_decode.dir/generated/nasdaq_itch_5/decoder.cpp.o"
+  "CMakeFiles/pcap_decode.dir/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "CMakeFiles/pcap_decode.dir/generated/nasdaq_itch_5/encoder.cpp.o"
+  "CMakeFiles/pcap_decode.dir/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "CMakeFiles/pcap_decode.dir/generated/nasdaq_itch_5/json.cpp.o"
+  "CMakeFiles/pcap_decode.dir/generated/nasdaq_itch_5/json.cpp.o.d"
+  "CMakeFiles/pcap_decode.dir/tools/pcap_decode/pcap_decode.cpp.o"
+  "CMakeFiles/pcap_decode.dir/tools/pcap_decode/pcap_decode.cpp.o.d"
+  "pcap_decode"
+  "pcap_decode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pcap_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
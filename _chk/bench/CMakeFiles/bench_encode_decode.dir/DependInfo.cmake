@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/generated/cboe_boe_v3/decoder.cpp" "bench/CMakeFiles/bench_encode_decode.dir/__/generated/cboe_boe_v3/decoder.cpp.o" "gcc" "bench/CMakeFiles/bench_encode_decode.dir/__/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "/root/repo/generated/cboe_boe_v3/encoder.cpp" "bench/CMakeFiles/bench_encode_decode.dir/__/generated/cboe_boe_v3/encoder.cpp.o" "gcc" "bench/CMakeFiles/bench_encode_decode.dir/__/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "/root/repo/generated/nasdaq_itch_5/decoder.cpp" "bench/CMakeFiles/bench_encode_decode.dir/__/generated/nasdaq_itch_5/decoder.cpp.o" "gcc" "bench/CMakeFiles/bench_encode_decode.dir/__/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "/root/repo/generated/nasdaq_itch_5/encoder.cpp" "bench/CMakeFiles/bench_encode_decode.dir/__/generated/nasdaq_itch_5/encoder.cpp.o" "gcc" "bench/CMakeFiles/bench_encode_decode.dir/__/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "/root/repo/bench/bench_encode_decode.cpp" "bench/CMakeFiles/bench_encode_decode.dir/bench_encode_decode.cpp.o" "gcc" "bench/CMakeFiles/bench_encode_decode.dir/bench_encode_decode.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_encode_decode.dir/__/generated/cboe_boe_v3/decoder.cpp.o"
+  "CMakeFiles/bench_encode_decode.dir/__/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "CMakeFiles/bench_encode_decode.dir/__/generated/cboe_boe_v3/encoder.cpp.o"
+  "CMakeFiles/bench_encode_decode.dir/__/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "CMakeFiles/bench_encode_decode.dir/__/generated/nasdaq_itch_5/decoder.cpp.o"
+  "CMakeFiles/bench_encode_decode.dir/__/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "CMakeFiles/bench_encode_decode.dir/__/generated/nasdaq_itch_5/encoder.cpp.o"
+  "CMakeFiles/bench_encode_decode.dir/__/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "CMakeFiles/bench_encode_decode.dir/bench_encode_decode.cpp.o"
+  "CMakeFiles/bench_encode_decode.dir/bench_encode_decode.cpp.o.d"
+  "bench_encode_decode"
+  "bench_encode_decode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_encode_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_gbench.dir/bench_gbench.cpp.o"
+  "CMakeFiles/bench_gbench.dir/bench_gbench.cpp.o.d"
+  "bench_gbench"
+  "bench_gbench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_gbench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/generated/cboe_boe_v3/decoder.cpp" "tests/CMakeFiles/test_mt_decode.dir/__/generated/cboe_boe_v3/decoder.cpp.o" "gcc" "tests/CMakeFiles/test_mt_decode.dir/__/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "/root/repo/generated/cboe_boe_v3/encoder.cpp" "tests/CMakeFiles/test_mt_decode.dir/__/generated/cboe_boe_v3/encoder.cpp.o" "gcc" "tests/CMakeFiles/test_mt_decode.dir/__/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "/root/repo/generated/nasdaq_itch_5/decoder.cpp" "tests/CMakeFiles/test_mt_decode.dir/__/generated/nasdaq_itch_5/decoder.cpp.o" "gcc" "tests/CMakeFiles/test_mt_decode.dir/__/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "/root/repo/generated/nasdaq_itch_5/encoder.cpp" "tests/CMakeFiles/test_mt_decode.dir/__/generated/nasdaq_itch_5/encoder.cpp.o" "gcc" "tests/CMakeFiles/test_mt_decode.dir/__/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "/root/repo/tests/test_mt_decode.cpp" "tests/CMakeFiles/test_mt_decode.dir/test_mt_decode.cpp.o" "gcc" "tests/CMakeFiles/test_mt_decode.dir/test_mt_decode.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
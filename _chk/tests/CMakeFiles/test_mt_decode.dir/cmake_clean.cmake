@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mt_decode.dir/__/generated/cboe_boe_v3/decoder.cpp.o"
+  "CMakeFiles/test_mt_decode.dir/__/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "CMakeFiles/test_mt_decode.dir/__/generated/cboe_boe_v3/encoder.cpp.o"
+  "CMakeFiles/test_mt_decode.dir/__/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "CMakeFiles/test_mt_decode.dir/__/generated/nasdaq_itch_5/decoder.cpp.o"
+  "CMakeFiles/test_mt_decode.dir/__/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "CMakeFiles/test_mt_decode.dir/__/generated/nasdaq_itch_5/encoder.cpp.o"
+  "CMakeFiles/test_mt_decode.dir/__/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "CMakeFiles/test_mt_decode.dir/test_mt_decode.cpp.o"
+  "CMakeFiles/test_mt_decode.dir/test_mt_decode.cpp.o.d"
+  "test_mt_decode"
+  "test_mt_decode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mt_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_roundtrip.dir/__/generated/cboe_boe_v3/decoder.cpp.o"
+  "CMakeFiles/test_roundtrip.dir/__/generated/cboe_boe_v3/decoder.cpp.o.d"
+  "CMakeFiles/test_roundtrip.dir/__/generated/cboe_boe_v3/encoder.cpp.o"
+  "CMakeFiles/test_roundtrip.dir/__/generated/cboe_boe_v3/encoder.cpp.o.d"
+  "CMakeFiles/test_roundtrip.dir/__/generated/nasdaq_itch_5/decoder.cpp.o"
+  "CMakeFiles/test_roundtrip.dir/__/generated/nasdaq_itch_5/decoder.cpp.o.d"
+  "CMakeFiles/test_roundtrip.dir/__/generated/nasdaq_itch_5/encoder.cpp.o"
+  "CMakeFiles/test_roundtrip.dir/__/generated/nasdaq_itch_5/encoder.cpp.o.d"
+  "CMakeFiles/test_roundtrip.dir/test_roundtrip.cpp.o"
+  "CMakeFiles/test_roundtrip.dir/test_roundtrip.cpp.o.d"
+  "test_roundtrip"
+  "test_roundtrip.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_roundtrip.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,291 @@
+// Order-entry round-trip latency benchmark for BOE over loopback TCP.
+//
+// The client logs in to the mock exchange (tests/boe_mock_exchange.hpp), then
+// sends one NewOrderCross at a time and waits for its OrderAcknowledgement.
+// Each round trip is timed from before the cross is encoded to after the ack
+// is decoded, so it covers encode, send, the acceptor's decode / encode,
+// receive, framing and decode on both sides plus two trips through the
+// loopback TCP stack. With two or more CPUs both threads busy-poll
+// non-blocking sockets by default; on one CPU the spinning threads would only
+// take turns, so the default there is blocking recv.
+//
+// With SESSION=1 the client is a boe::Session (runtime/session.hpp) sending
+// sequenced NewOrders from its pre-faulted send ring and polling for the acks,
+// instead of hand-framed NewOrderCross messages.
+//
+// Configuration (environment variables):
+//   COUNT      timed round trips                        (default 100000)
+//   WARMUP     untimed round trips before the first one (default 1000)
+//   ALLOCS     allocation groups per cross (1..16)      (default 2)
+//   BUSY_POLL  1 = spin on non-blocking recv, 0 = block (default 1 on >= 2 CPUs)
+//   SESSION    1 = send NewOrders through boe::Session   (default 0)
+//   CPU_CLIENT / CPU_SERVER  pin client/acceptor to a CPU (Linux only)
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if __has_include("../generated/cboe_boe_v3/handler.hpp")
+#include "tests/boe_mock_exchange.hpp"
+#include "../generated/cboe_boe_v3/session.hpp"
+#define HAS_GENERATED_BOE 1
+#else
+#define HAS_GENERATED_BOE 0
+#endif
+
+#if HAS_GENERATED_BOE && HAS_BOE_MOCK
+
+using namespace std::chrono;
+using market::runtime::Bytes;
+using market::runtime::status;
+namespace boe = cboe::boe::v3;
+
+namespace {
+
+struct BenchConfig {
+    size_t count = 100'000;
+    size_t warmup = 1000;
+    size_t groups = 2;
+    bool busy_poll = true;
+    bool session = false;
+    int cpu_client = -1;
+    int cpu_server = -1;
+};
+
+uint64_t env_u64(const char* name, uint64_t def) {
+    const char* v = std::getenv(name);
+    return v ? std::strtoull(v, nullptr, 10) : def;
+}
+
+// Client side of the session: decoded acknowledgements land here.
+struct Client {
+    bool logged_in = false;
+    uint64_t last_order_id = 0;
+    std::array<char, 20> last_clordid{};
+    size_t acks = 0;
+
+    void on(const boe::LoginResponse& m) { logged_in = m.LoginResponseStatus == 'A'; }
+    void on(const boe::OrderAcknowledgement& m) {
+        last_order_id = m.OrderId;
+        last_clordid = m.ClOrdId;
+        ++acks;
+    }
+};
+
+struct Timings {
+    std::vector<uint64_t> round_trip;
+    std::vector<uint64_t> encode_send;  // encode + send() returning
+    std::vector<uint64_t> decode;       // ack frame complete -> decoded
+};
+
+// Writes the decimal sequence number into the cross id.
+void stamp(boe::NewOrderCross& m, uint64_t seq) {
+    std::memset(m.CrossId.data(), '0', m.CrossId.size());
+    for (size_t i = m.CrossId.size(); i > 0 && seq > 0; --i, seq /= 10) {
+        m.CrossId[i - 1] = static_cast<char>('0' + seq % 10);
+    }
+}
+
+void report(const BenchConfig& cfg, Timings& t, double secs, size_t errors) {
+    auto pct = [](std::vector<uint64_t>& v, double p) -> uint64_t {
+        if (v.empty()) return 0;
+        size_t idx = static_cast<size_t>(p / 100.0 * static_cast<double>(v.size() - 1));
+        return v[idx];
+    };
+    std::sort(t.round_trip.begin(), t.round_trip.end());
+    std::sort(t.encode_send.begin(), t.encode_send.end());
+    std::sort(t.decode.begin(), t.decode.end());
+    auto& rt = t.round_trip;
+    std::cout << "BOE order-entry round trip (loopback TCP, "
+              << (cfg.session ? "session NewOrder" : "allocs=" + std::to_string(cfg.groups))
+              << ", busy_poll=" << cfg.busy_poll << ", warmup=" << cfg.warmup << ")" << std::endl;
+    std::cout << "  round trips: " << rt.size() << " errors=" << errors << " rate="
+              << static_cast<uint64_t>(static_cast<double>(rt.size()) / secs) << "/s" << std::endl;
+    std::cout << "  latency ns: min=" << (rt.empty() ? 0 : rt.front()) << " p50=" << pct(rt, 50)
+              << " p90=" << pct(rt, 90) << " p99=" << pct(rt, 99) << " p99.9=" << pct(rt, 99.9)
+              << " p99.99=" << pct(rt, 99.99) << " max=" << (rt.empty() ? 0 : rt.back()) << std::endl;
+    std::cout << "  client ns: encode+send p50=" << pct(t.encode_send, 50) << " p99=" << pct(t.encode_send, 99);
+    if (!t.decode.empty()) std::cout << " ack decode p50=" << pct(t.decode, 50) << " p99=" << pct(t.decode, 99);
+    std::cout << std::endl;
+}
+
+// The same loop through boe::Session: send() stamps the sequence number and
+// writes from the send ring, poll() reads and dispatches the ack.
+int run_session(const BenchConfig& cfg, int fd, boe_mock::mock_exchange& ex) {
+    market::runtime::session_config scfg;
+    scfg.heartbeat_ns = 60'000'000'000ull;  // no heartbeats inside the timed loop
+    boe::Session s(scfg);
+    Client client;
+    boe::LoginRequest login;
+    login.MessageType = boe::MessageType::LoginRequest;
+    std::memcpy(login.Username.data(), "BNCH", 4);
+    std::memset(login.Password.data(), 'x', login.Password.size());
+    if (s.attach(fd) != status::ok || s.login(login) != status::ok) {
+        std::cerr << "session setup failed" << std::endl;
+        return 1;
+    }
+    while (s.state() == market::runtime::session_state::logging_in) {
+        if (s.poll(client, boe_mock::now_ns()) != status::ok) break;
+    }
+    if (s.state() != market::runtime::session_state::active) {
+        std::cerr << "login failed" << std::endl;
+        return 1;
+    }
+
+    boe::NewOrder order;
+    order.MessageType = boe::MessageType::NewOrder;
+    order.Side = static_cast<uint8_t>(boe::Side::Buy);
+    order.OrderQty = 100;
+    order.Price = 1'000'000;
+    std::memcpy(order.Symbol.data(), "AAPL    ", 8);
+
+    Timings t;
+    t.round_trip.reserve(cfg.count);
+    t.encode_send.reserve(cfg.count);
+    size_t errors = 0;
+    const auto t0 = steady_clock::now();
+    for (size_t i = 0; i < cfg.warmup + cfg.count; ++i) {
+        boe::NewOrderCross id;
+        stamp(id, i);
+        order.ClOrdId = id.CrossId;
+        const size_t acks = client.acks;
+        const uint64_t start = boe_mock::now_ns();
+        if (s.send(order) != status::ok) {
+            std::cerr << "send failed" << std::endl;
+            break;
+        }
+        const uint64_t sent = boe_mock::now_ns();
+        while (client.acks == acks) {
+            if (s.poll(client, boe_mock::now_ns()) != status::ok) break;
+        }
+        const uint64_t done = boe_mock::now_ns();
+        if (client.acks != acks + 1 || client.last_clordid != order.ClOrdId) {
+            if (s.state() != market::runtime::session_state::active) {
+                std::cerr << "exchange disconnected" << std::endl;
+                break;
+            }
+            ++errors;
+            continue;
+        }
+        if (i >= cfg.warmup) {
+            t.round_trip.push_back(done - start);
+            t.encode_send.push_back(sent - start);
+        }
+    }
+    const double secs = duration<double>(steady_clock::now() - t0).count();
+    ::close(fd);
+    ex.stop();
+    errors += ex.errors() + ex.sequence_errors() + s.stats().inbound_gaps;
+    report(cfg, t, secs, errors);
+    return errors == 0 && t.round_trip.size() == cfg.count ? 0 : 1;
+}
+
+int run(const BenchConfig& cfg) {
+    boe_mock::mock_exchange ex({cfg.cpu_server, cfg.busy_poll});
+    const uint16_t port = ex.start();
+    const int fd = port ? boe_mock::connect_loopback(port) : -1;
+    if (fd < 0) {
+        std::cerr << "loopback listen/connect failed" << std::endl;
+        return 1;
+    }
+    boe_mock::pin_thread(cfg.cpu_client);
+    if (cfg.session) return run_session(cfg, fd, ex);
+
+    boe_mock::frame_reader rx;
+    Client client;
+    uint8_t out[boe_mock::kMaxFrame];
+    Bytes frame;
+    size_t consumed = 0;
+
+    boe::LoginRequest login;
+    login.StartOfMessage = 0xBABA;
+    login.MessageType = boe::MessageType::LoginRequest;
+    std::memcpy(login.Username.data(), "BNCH", 4);
+    std::memset(login.Password.data(), 'x', login.Password.size());
+    if (boe_mock::send_message(fd, login, out, sizeof(out)) != status::ok ||
+        !boe_mock::read_frame(fd, rx, frame, cfg.busy_poll) ||
+        boe::dispatch_boe(frame, client, consumed) != status::ok || !client.logged_in) {
+        std::cerr << "login failed" << std::endl;
+        ::close(fd);
+        return 1;
+    }
+
+    boe::NewOrderCross cross;
+    cross.groups.resize(cfg.groups);
+    for (size_t g = 0; g < cfg.groups; ++g) {
+        auto& e = cross.groups[g];
+        e.Side = static_cast<uint8_t>(g % 2 ? boe::Side::Sell : boe::Side::Buy);
+        e.AllocQty = 100;
+        std::memset(e.ClOrdId.data(), 'C', e.ClOrdId.size());
+    }
+    cross.GroupCount = static_cast<uint8_t>(cfg.groups);
+
+    Timings t;
+    t.round_trip.reserve(cfg.count);
+    t.encode_send.reserve(cfg.count);
+    t.decode.reserve(cfg.count);
+    size_t errors = 0;
+    const auto t0 = steady_clock::now();
+    for (size_t i = 0; i < cfg.warmup + cfg.count; ++i) {
+        stamp(cross, i);
+        const uint64_t start = boe_mock::now_ns();
+        if (boe_mock::send_message(fd, cross, out, sizeof(out)) != status::ok) {
+            std::cerr << "send failed" << std::endl;
+            break;
+        }
+        const uint64_t sent = boe_mock::now_ns();
+        if (!boe_mock::read_frame(fd, rx, frame, cfg.busy_poll)) {
+            std::cerr << "exchange disconnected" << std::endl;
+            break;
+        }
+        const uint64_t received = boe_mock::now_ns();
+        const size_t acks = client.acks;
+        if (boe::dispatch_boe(frame, client, consumed) != status::ok || client.acks != acks + 1 ||
+            client.last_clordid != cross.CrossId) {
+            ++errors;
+            continue;
+        }
+        const uint64_t done = boe_mock::now_ns();
+        if (i >= cfg.warmup) {
+            t.round_trip.push_back(done - start);
+            t.encode_send.push_back(sent - start);
+            t.decode.push_back(done - received);
+        }
+    }
+    const double secs = duration<double>(steady_clock::now() - t0).count();
+    ::close(fd);
+    ex.stop();
+    errors += ex.errors();
+    report(cfg, t, secs, errors);
+    return errors == 0 && t.round_trip.size() == cfg.count ? 0 : 1;
+}
+
+}  // namespace
+
+int main() {
+    BenchConfig cfg;
+    cfg.count = env_u64("COUNT", cfg.count);
+    cfg.warmup = env_u64("WARMUP", cfg.warmup);
+    cfg.groups = std::clamp<size_t>(env_u64("ALLOCS", cfg.groups), 1, 16);
+    cfg.busy_poll = env_u64("BUSY_POLL", std::thread::hardware_concurrency() > 1 ? 1 : 0) != 0;
+    cfg.session = env_u64("SESSION", 0) != 0;
+    cfg.cpu_client = static_cast<int>(env_u64("CPU_CLIENT", static_cast<uint64_t>(-1)));
+    cfg.cpu_server = static_cast<int>(env_u64("CPU_SERVER", static_cast<uint64_t>(-1)));
+    return run(cfg);
+}
+
+#else
+
+int main() {
+    std::cerr << "BOE generated handlers or POSIX sockets not available. Generate code first." << std::endl;
+    return 2;
+}
+
+#endif
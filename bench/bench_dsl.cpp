@@ -0,0 +1,150 @@
+// Constexpr DSL codecs vs generated codecs.
+//
+// The DSL layouts describe the generated structs, so both sides encode and
+// decode identical bytes. DSL calls go through noinline wrappers so neither side
+// is inlined into the timing loop (the generated codec lives in its own unit).
+//
+// Usage: bench_dsl   (ITER env var sets iterations)
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "runtime/config.hpp"
+#include "runtime/dsl.hpp"
+
+#include "../generated/cboe_boe_v3/decoder.hpp"
+#include "../generated/cboe_boe_v3/encoder.hpp"
+#include "../generated/nasdaq_itch_5/decoder.hpp"
+#include "../generated/nasdaq_itch_5/encoder.hpp"
+
+using namespace std::chrono;
+namespace dsl = market::runtime::dsl;
+namespace boe = cboe::boe::v3;
+namespace itch = nasdaq::itch::v5;
+using market::runtime::status;
+
+using AddOrderLayout = dsl::message<itch::AddOrder,
+    dsl::constant<&itch::AddOrder::Type, 'A'>,
+    dsl::field<&itch::AddOrder::Timestamp>,
+    dsl::field<&itch::AddOrder::OrderId>,
+    dsl::field<&itch::AddOrder::Side>,
+    dsl::field<&itch::AddOrder::Shares>,
+    dsl::field<&itch::AddOrder::Symbol>,
+    dsl::field<&itch::AddOrder::Price>>;
+
+using NewOrderCrossLayout = dsl::message<boe::NewOrderCross,
+    dsl::presence<&boe::NewOrderCross::PresenceBits, std::endian::little>,
+    dsl::field<&boe::NewOrderCross::CrossId>,
+    dsl::field<&boe::NewOrderCross::GroupCount>,
+    dsl::group<&boe::NewOrderCross::groups, &boe::NewOrderCross::GroupCount,
+        dsl::field<&boe::NewOrderCrossGroups::Side>,
+        dsl::field<&boe::NewOrderCrossGroups::AllocQty, std::endian::little>,
+        dsl::field<&boe::NewOrderCrossGroups::ClOrdId>,
+        dsl::optional<&boe::NewOrderCrossGroups::Account, 9>>>;
+
+template<typename Layout, typename M>
+MARKET_NOINLINE status dsl_encode(const M& m, uint8_t* out, size_t n, size_t& written) {
+    return Layout::encode(m, out, n, written);
+}
+
+template<typename Layout, typename M>
+MARKET_NOINLINE status dsl_decode(const uint8_t* in, size_t n, M& out, size_t& consumed) {
+    return Layout::decode(in, n, out, consumed);
+}
+
+template<typename Func>
+double benchmark_ns_per_op(Func&& func, size_t iterations) {
+    size_t warmup = iterations / 20;
+    for (size_t i = 0; i < warmup; ++i) {
+        func();
+    }
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto end = steady_clock::now();
+    return static_cast<double>(duration_cast<nanoseconds>(end - start).count()) /
+           static_cast<double>(iterations);
+}
+
+static void report(const char* name, double gen_ns, double dsl_ns, size_t iterations, size_t size) {
+    std::cout << name << " generated: " << gen_ns << " ns/msg, dsl: " << dsl_ns
+              << " ns/msg (x" << (gen_ns > 0 ? dsl_ns / gen_ns : 0.0) << ", N=" << iterations
+              << ", size=" << size << ")" << std::endl;
+}
+
+int main() {
+    const char* iter_env = std::getenv("ITER");
+    size_t iterations = iter_env ? std::strtoul(iter_env, nullptr, 10) : 1'000'000;
+    std::cout << "Running DSL benchmarks with " << iterations << " iterations" << std::endl;
+
+    // ===== ITCH AddOrder =====
+    {
+        itch::AddOrder msg{};
+        msg.Type = 'A';
+        msg.Timestamp = 123456u;
+        msg.OrderId = 0x1234567890ABCDEFULL;
+        msg.Side = 'B';
+        msg.Shares = 1000u;
+        std::memcpy(msg.Symbol.data(), "TESTSMBL", 8);
+        msg.Price = 50000u;
+
+        std::array<uint8_t, 64> buffer{};
+        size_t written = 0, consumed = 0;
+        itch::AddOrder out{};
+
+        const double gen_enc = benchmark_ns_per_op([&]() {
+            (void)itch::Encoder::encode(msg, buffer.data(), buffer.size(), written);
+        }, iterations);
+        const double dsl_enc = benchmark_ns_per_op([&]() {
+            (void)dsl_encode<AddOrderLayout>(msg, buffer.data(), buffer.size(), written);
+        }, iterations);
+        const double gen_dec = benchmark_ns_per_op([&]() {
+            (void)itch::Decoder::decode(buffer.data(), written, out, consumed);
+        }, iterations);
+        const double dsl_dec = benchmark_ns_per_op([&]() {
+            (void)dsl_decode<AddOrderLayout>(buffer.data(), written, out, consumed);
+        }, iterations);
+        report("ITCH::AddOrder encode", gen_enc, dsl_enc, iterations, written);
+        report("ITCH::AddOrder decode", gen_dec, dsl_dec, iterations, written);
+    }
+
+    // ===== BOE NewOrderCross (2 groups, Account present) =====
+    {
+        boe::NewOrderCross msg{};
+        msg.PresenceBits = 1ULL << 9;
+        std::memcpy(msg.CrossId.data(), "CROSS123456789012345", 20);
+        for (int i = 0; i < 2; ++i) {
+            boe::NewOrderCrossGroups g{};
+            g.Side = static_cast<uint8_t>(i ? boe::Side::Sell : boe::Side::Buy);
+            g.AllocQty = 1000u;
+            std::memcpy(g.ClOrdId.data(), "ORDER12345678901234X", 20);
+            std::memcpy(g.Account.data(), "ACCOUNT123456789", 16);
+            msg.groups.push_back(g);
+        }
+
+        std::array<uint8_t, 256> buffer{};
+        size_t written = 0, consumed = 0;
+        boe::NewOrderCross out{};
+
+        const double gen_enc = benchmark_ns_per_op([&]() {
+            (void)boe::Encoder::encode(msg, buffer.data(), buffer.size(), written);
+        }, iterations);
+        const double dsl_enc = benchmark_ns_per_op([&]() {
+            (void)dsl_encode<NewOrderCrossLayout>(msg, buffer.data(), buffer.size(), written);
+        }, iterations);
+        const double gen_dec = benchmark_ns_per_op([&]() {
+            (void)boe::Decoder::decode(buffer.data(), written, out, consumed);
+        }, iterations);
+        const double dsl_dec = benchmark_ns_per_op([&]() {
+            (void)dsl_decode<NewOrderCrossLayout>(buffer.data(), written, out, consumed);
+        }, iterations);
+        report("BOE::NewOrderCross encode", gen_enc, dsl_enc, iterations, written);
+        report("BOE::NewOrderCross decode", gen_dec, dsl_dec, iterations, written);
+    }
+
+    return 0;
+}
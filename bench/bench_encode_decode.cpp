@@ -3,6 +3,7 @@
 #include <cstring>
 #include <iostream>
 #include <cstdlib>
+#include <vector>
 
 // Include generated headers (only if they exist)
 #if __has_include("../generated/cboe_boe_v3/messages.hpp")
@@ -18,6 +19,7 @@
 #include "../generated/nasdaq_itch_5/messages.hpp"
 #include "../generated/nasdaq_itch_5/encoder.hpp"
 #include "../generated/nasdaq_itch_5/decoder.hpp"
+#include "../generated/nasdaq_itch_5/wire.hpp"
 #define HAS_GENERATED_ITCH 1
 #else
 #define HAS_GENERATED_ITCH 0
@@ -237,6 +239,141 @@ int main() {
         std::cout << "ITCH::DeleteOrder encode: " << static_cast<int>(encode_ns) 
                   << " ns/msg (N=" << iterations << ", size=" << written << ")" << std::endl;
     }
+
+    // ===== ITCH AddOrder from columns: per-message encode vs encode_batch =====
+    {
+        constexpr size_t kRows = 1024;
+        std::vector<uint32_t> ts(kRows), shares(kRows), px(kRows);
+        std::vector<uint64_t> ids(kRows);
+        std::vector<char> sides(kRows);
+        std::vector<std::array<char, 8>> syms(kRows);
+        for (size_t i = 0; i < kRows; ++i) {
+            ts[i] = static_cast<uint32_t>(i);
+            ids[i] = 0x1234567890ABCDEFULL + i;
+            sides[i] = (i & 1) ? 'S' : 'B';
+            shares[i] = static_cast<uint32_t>(100 + i);
+            std::memcpy(syms[i].data(), "TESTSMBL", 8);
+            px[i] = static_cast<uint32_t>(50000 + i);
+        }
+        AddOrderColumns cols;
+        cols.Timestamp = ts.data();
+        cols.OrderId = ids.data();
+        cols.Side = sides.data();
+        cols.Shares = shares.data();
+        cols.Symbol = syms.data();
+        cols.Price = px.data();
+
+        std::vector<uint8_t> out(kRows * 32);
+        const size_t batches = iterations / kRows ? iterations / kRows : 1;
+        size_t written = 0;
+
+        auto rows_ns = benchmark_ns_per_op([&]() {
+            size_t off = 0;
+            AddOrder m;
+            m.Type = 'A';
+            for (size_t i = 0; i < kRows; ++i) {
+                m.Timestamp = ts[i];
+                m.OrderId = ids[i];
+                m.Side = sides[i];
+                m.Shares = shares[i];
+                m.Symbol = syms[i];
+                m.Price = px[i];
+                size_t w = 0;
+                (void)nasdaq::itch::v5::Encoder::encode(m, out.data() + off, out.size() - off, w);
+                off += w;
+            }
+            written = off;
+        }, batches) / kRows;
+
+        auto batch_ns = benchmark_ns_per_op([&]() {
+            (void)nasdaq::itch::v5::Encoder::encode_batch(cols, kRows, out.data(), out.size(), written);
+        }, batches) / kRows;
+
+        std::cout << "ITCH::AddOrder columns, per-message encode: " << rows_ns
+                  << " ns/msg, encode_batch: " << batch_ns << " ns/msg (N=" << batches * kRows
+                  << ", size=" << written / kRows << ")" << std::endl;
+    }
+
+    // ===== ITCH AddOrder capture scan: Decoder::decode vs wire overlay =====
+    {
+        constexpr size_t kRows = 1024;
+        std::vector<uint8_t> capture(kRows * sizeof(AddOrderWire));
+        AddOrder m;
+        m.Type = 'A';
+        std::memcpy(m.Symbol.data(), "TESTSMBL", 8);
+        for (size_t i = 0; i < kRows; ++i) {
+            m.OrderId = 0x1234567890ABCDEFULL + i;
+            m.Shares = static_cast<uint32_t>(100 + i);
+            m.Price = static_cast<uint32_t>(50000 + i);
+            size_t w = 0;
+            (void)nasdaq::itch::v5::Encoder::encode(m, capture.data() + i * sizeof(AddOrderWire), sizeof(AddOrderWire), w);
+        }
+        const size_t passes = iterations / kRows ? iterations / kRows : 1;
+        volatile uint64_t sink = 0;
+
+        auto decode_ns = benchmark_ns_per_op([&]() {
+            uint64_t notional = 0;
+            AddOrder d;
+            for (size_t i = 0; i < kRows; ++i) {
+                size_t consumed = 0;
+                (void)nasdaq::itch::v5::Decoder::decode(capture.data() + i * sizeof(AddOrderWire),
+                                                        sizeof(AddOrderWire), d, consumed);
+                notional += uint64_t{d.Shares} * d.Price;
+            }
+            sink = notional;
+        }, passes) / kRows;
+
+        auto overlay_ns = benchmark_ns_per_op([&]() {
+            uint64_t notional = 0;
+            for (const AddOrderWire& w : market::runtime::overlay_array<AddOrderWire>(
+                     market::runtime::Bytes{capture.data(), capture.size()})) {
+                notional += uint64_t{w.Shares} * w.Price;
+            }
+            sink = notional;
+        }, passes) / kRows;
+
+        std::cout << "ITCH::AddOrder scan, Decoder::decode: " << decode_ns << " ns/msg, AddOrderWire overlay: "
+                  << overlay_ns << " ns/msg (N=" << passes * kRows << ")" << std::endl;
+    }
+
+    // ===== Symbol keys: per-message trim/upper-case loop vs symbol_key vs batch =====
+    {
+        constexpr size_t kRows = 1024;
+        const char* names[] = {"AAPL    ", "msft    ", "BRK A   ", "QQQ     ", "SPY     ", "GOOGL   ", "T       "};
+        std::vector<std::array<char, 8>> syms(kRows);
+        for (size_t i = 0; i < kRows; ++i) std::memcpy(syms[i].data(), names[i % 7], 8);
+        std::vector<uint64_t> keys(kRows);
+        const size_t passes = iterations / kRows ? iterations / kRows : 1;
+
+        auto loop_ns = benchmark_ns_per_op([&]() {
+            for (size_t i = 0; i < kRows; ++i) {
+                const char* p = syms[i].data();
+                size_t len = 8;
+                while (len > 0 && (p[len - 1] == ' ' || p[len - 1] == '\0')) --len;
+                uint64_t k = 0;
+                bool ok = len > 0;
+                for (size_t j = 0; j < 8; ++j) {
+                    char c = j < len ? p[j] : '\0';
+                    if (j < len && (c < 0x20 || c > 0x7E)) ok = false;
+                    if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 32);
+                    k = (k << 8) | static_cast<uint8_t>(c);
+                }
+                keys[i] = ok ? k : 0;
+            }
+        }, passes) / kRows;
+
+        auto swar_ns = benchmark_ns_per_op([&]() {
+            for (size_t i = 0; i < kRows; ++i) keys[i] = market::runtime::symbol_key(syms[i]);
+        }, passes) / kRows;
+
+        auto batch_ns = benchmark_ns_per_op([&]() {
+            (void)market::runtime::symbol_keys(syms.data(), kRows, keys.data());
+        }, passes) / kRows;
+
+        std::cout << "Symbol keys, scalar loop: " << loop_ns << " ns/sym, symbol_key: " << swar_ns
+                  << " ns/sym, symbol_keys batch: " << batch_ns << " ns/sym (N=" << passes * kRows << ")"
+                  << std::endl;
+    }
 #endif
 
     std::cout << std::endl;
@@ -0,0 +1,190 @@
+// Runtime schema interpreter vs generated decoder.
+//
+// Usage: bench_interp [generated_dir]   (ITER env var sets iterations)
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "runtime/schema_interp.hpp"
+
+#if __has_include("../generated/nasdaq_itch_5/decoder.hpp") && __has_include("../generated/cboe_boe_v3/decoder.hpp")
+#include "../generated/cboe_boe_v3/decoder.hpp"
+#include "../generated/cboe_boe_v3/encoder.hpp"
+#include "../generated/nasdaq_itch_5/decoder.hpp"
+#include "../generated/nasdaq_itch_5/encoder.hpp"
+#define HAS_GENERATED 1
+#else
+#define HAS_GENERATED 0
+#endif
+
+#ifndef MARKET_GENERATED_DIR
+#define MARKET_GENERATED_DIR "generated"
+#endif
+
+using namespace std::chrono;
+
+template<typename Func>
+double benchmark_ns_per_op(Func&& func, size_t iterations) {
+    size_t warmup = iterations / 20;
+    for (size_t i = 0; i < warmup; ++i) {
+        func();
+    }
+    auto start = steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto end = steady_clock::now();
+    return static_cast<double>(duration_cast<nanoseconds>(end - start).count()) /
+           static_cast<double>(iterations);
+}
+
+#if HAS_GENERATED
+
+static void report(const char* name, double gen_ns, double interp_ns, size_t iterations, size_t size) {
+    std::cout << name << " generated: " << gen_ns << " ns/msg, interpreter: " << interp_ns
+              << " ns/msg (x" << (gen_ns > 0 ? interp_ns / gen_ns : 0.0) << ", N=" << iterations
+              << ", size=" << size << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    using market::runtime::interp::interpreter;
+    using market::runtime::interp::record;
+    using market::runtime::interp::schema;
+
+    const char* iter_env = std::getenv("ITER");
+    size_t iterations = iter_env ? std::strtoul(iter_env, nullptr, 10) : 1'000'000;
+    const std::string dir = argc > 1 ? argv[1] : MARKET_GENERATED_DIR;
+
+    schema itch_schema;
+    schema boe_schema;
+    if (itch_schema.load_file(dir + "/nasdaq_itch_5/schema.bin") != market::runtime::status::ok ||
+        boe_schema.load_file(dir + "/cboe_boe_v3/schema.bin") != market::runtime::status::ok) {
+        std::cerr << "Cannot load schema.bin descriptors from " << dir << std::endl;
+        return 1;
+    }
+    interpreter itch(itch_schema);
+    interpreter boe(boe_schema);
+    record rec;
+
+    std::cout << "Running interpreter benchmarks with " << iterations << " iterations" << std::endl;
+
+    // ===== ITCH AddOrder =====
+    {
+        using namespace nasdaq::itch::v5;
+        AddOrder msg;
+        msg.Type = 'A';
+        msg.Timestamp = 123456u;
+        msg.OrderId = 0x1234567890ABCDEFULL;
+        msg.Side = 'B';
+        msg.Shares = 1000u;
+        std::memcpy(msg.Symbol.data(), "TESTSMBL", 8);
+        msg.Price = 50000u;
+        std::array<uint8_t, 64> buffer{};
+        size_t written = 0, consumed = 0;
+        nasdaq::itch::v5::Encoder::encode(msg, buffer.data(), buffer.size(), written);
+
+        AddOrder out;
+        auto gen_ns = benchmark_ns_per_op([&]() {
+            auto st = nasdaq::itch::v5::Decoder::decode(buffer.data(), written, out, consumed);
+            (void)st;
+        }, iterations);
+        auto interp_ns = benchmark_ns_per_op([&]() {
+            auto st = itch.decode(buffer.data(), written, rec, consumed);
+            (void)st;
+        }, iterations);
+        report("ITCH::AddOrder", gen_ns, interp_ns, iterations, written);
+    }
+
+    // ===== ITCH DeleteOrder =====
+    {
+        using namespace nasdaq::itch::v5;
+        DeleteOrder msg;
+        msg.Type = 'D';
+        msg.Timestamp = 654321u;
+        msg.OrderId = 0xFEDCBA0987654321ULL;
+        std::array<uint8_t, 64> buffer{};
+        size_t written = 0, consumed = 0;
+        nasdaq::itch::v5::Encoder::encode(msg, buffer.data(), buffer.size(), written);
+
+        DeleteOrder out;
+        auto gen_ns = benchmark_ns_per_op([&]() {
+            auto st = nasdaq::itch::v5::Decoder::decode(buffer.data(), written, out, consumed);
+            (void)st;
+        }, iterations);
+        auto interp_ns = benchmark_ns_per_op([&]() {
+            auto st = itch.decode(buffer.data(), written, rec, consumed);
+            (void)st;
+        }, iterations);
+        report("ITCH::DeleteOrder", gen_ns, interp_ns, iterations, written);
+    }
+
+    // ===== BOE LoginRequest =====
+    {
+        using namespace cboe::boe::v3;
+        LoginRequest msg;
+        std::memcpy(msg.Username.data(), "TEST", 4);
+        std::memcpy(msg.Password.data(), "PASSWORD123456789012", 20);
+        msg.MessageType = MessageType::LoginRequest;
+        std::array<uint8_t, 64> buffer{};
+        size_t written = 0, consumed = 0;
+        cboe::boe::v3::Encoder::encode(msg, buffer.data(), buffer.size(), written);
+
+        LoginRequest out;
+        auto gen_ns = benchmark_ns_per_op([&]() {
+            auto st = cboe::boe::v3::Decoder::decode(buffer.data(), written, out, consumed);
+            (void)st;
+        }, iterations);
+        auto interp_ns = benchmark_ns_per_op([&]() {
+            auto st = boe.decode(buffer.data(), written, rec, consumed);
+            (void)st;
+        }, iterations);
+        report("BOE::LoginRequest", gen_ns, interp_ns, iterations, written);
+    }
+
+    // ===== BOE NewOrderCross (+Account) =====
+    {
+        using namespace cboe::boe::v3;
+        NewOrderCross msg;
+        msg.PresenceBits = (1ULL << 9);
+        std::memcpy(msg.CrossId.data(), "CROSS123456789012345", 20);
+        msg.GroupCount = 2;
+        NewOrderCrossGroups group;
+        group.Side = static_cast<uint8_t>(Side::Buy);
+        group.AllocQty = 1000;
+        std::memcpy(group.ClOrdId.data(), "ORDER12345678901234X", 20);
+        std::memcpy(group.Account.data(), "ACCOUNT123456789", 16);
+        msg.groups = {group, group};
+        std::array<uint8_t, 256> buffer{};
+        size_t written = 0, consumed = 0;
+        cboe::boe::v3::Encoder::encode(msg, buffer.data(), buffer.size(), written);
+
+        const size_t idx = static_cast<size_t>(boe_schema.find_message("NewOrderCross"));
+        NewOrderCross out;
+        auto gen_ns = benchmark_ns_per_op([&]() {
+            auto st = cboe::boe::v3::Decoder::decode(buffer.data(), written, out, consumed);
+            (void)st;
+        }, iterations);
+        auto interp_ns = benchmark_ns_per_op([&]() {
+            auto st = boe.decode_as(idx, buffer.data(), written, rec, consumed);
+            (void)st;
+        }, iterations);
+        report("BOE::NewOrderCross(+Account)", gen_ns, interp_ns, iterations, written);
+    }
+
+    std::cout << std::endl;
+    std::cout << "Benchmark completed successfully!" << std::endl;
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cerr << "Generated decoders not found. Generate code first." << std::endl;
+    return 2;
+}
+
+#endif
@@ -0,0 +1,572 @@
+// End-to-end wire-to-book latency benchmark for ITCH.
+//
+// A publisher thread sends pre-encoded ITCH packets through either an in-process
+// SPSC ring or a loopback UDP socket. The consumer thread frames each packet,
+// dispatches every message through dispatch_itch, decodes it and applies it to an
+// order book. Latency is measured per message from the packet send timestamp to
+// the moment the book update for that message has completed.
+//
+// Configuration (environment variables):
+//   COUNT      total messages to send            (default 1000000)
+//   RATE       messages per second, 0 = flat out  (default 1000000)
+//   BATCH      messages per packet                (default 1)
+//   TRANSPORT  ring | udp                         (default ring)
+//   LIVE       resting orders kept on the book    (default 4096)
+//   CPU_PUB / CPU_SUB  pin publisher/consumer to a CPU (Linux only)
+//   CATCHUP    1 = switch to the batch (catch-up) dispatch path while the ring
+//              backlog exceeds CATCHUP_DEPTH packets (default 0 = always live)
+//   CATCHUP_DEPTH  backlog that enters catch-up (default 256; exits at 1/16)
+//   WARMUP     synthetic warm-up rounds run on a scratch book before the first
+//              packet (default 0); compare the reported `first` latency
+//   STATS      shared-memory statistics segment (e.g. /wire_to_book) with the
+//              consumer's message/packet counters, dispatch results, ring depth
+//              and latency histogram; watch it with `mdp_top /wire_to_book`
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "runtime/bytes.hpp"
+#include "runtime/catchup.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/status.hpp"
+
+#if __has_include("../generated/nasdaq_itch_5/handler.hpp")
+#include "../generated/nasdaq_itch_5/encoder.hpp"
+#include "../generated/nasdaq_itch_5/handler.hpp"
+#include "../generated/nasdaq_itch_5/warmup.hpp"
+#define HAS_GENERATED_ITCH 1
+#else
+#define HAS_GENERATED_ITCH 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "runtime/stats_registry.hpp"
+#define HAS_UDP 1
+#else
+#define HAS_UDP 0
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if HAS_GENERATED_ITCH
+
+using namespace std::chrono;
+using market::runtime::Bytes;
+using market::runtime::load_be;
+using market::runtime::status;
+using market::runtime::store_be;
+
+namespace {
+
+// Packet layout (MoldUDP64-style, with the send timestamp carried in place of the
+// session id so the receiver can compute wire-to-book latency):
+//   u64 sequence | u64 send_ns | u16 count | count x (u16 length | message)
+constexpr size_t kPacketHeader = 18;
+constexpr size_t kMaxPacket = 1472;  // fits a standard Ethernet MTU UDP payload
+
+struct BenchConfig {
+    size_t count = 1'000'000;
+    uint64_t rate = 1'000'000;
+    size_t batch = 1;
+    size_t live = 4096;
+    std::string transport = "ring";
+    int cpu_pub = -1;
+    int cpu_sub = -1;
+    size_t warmup = 0;
+    bool catchup = false;
+    size_t catchup_depth = 256;
+    std::string stats;
+};
+
+uint64_t env_u64(const char* name, uint64_t def) {
+    const char* v = std::getenv(name);
+    return v ? std::strtoull(v, nullptr, 10) : def;
+}
+
+inline uint64_t now_ns() {
+    return static_cast<uint64_t>(
+        duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void pin_thread(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+// Fixed-slot single-producer/single-consumer packet ring.
+class PacketRing {
+public:
+    explicit PacketRing(size_t slots) : slots_(slots), sizes_(slots), data_(slots * kMaxPacket) {}
+
+    bool try_push(const uint8_t* p, size_t n) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_cache_ == slots_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head - tail_cache_ == slots_) return false;
+        }
+        const size_t idx = head % slots_;
+        std::memcpy(&data_[idx * kMaxPacket], p, n);
+        sizes_[idx] = n;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Returns a view of the next packet or an empty span; call pop() when done with it.
+    Bytes front() {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_cache_) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail == head_cache_) return {};
+        }
+        const size_t idx = tail % slots_;
+        return Bytes{&data_[idx * kMaxPacket], sizes_[idx]};
+    }
+
+    void pop() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    // Consumer side: packets queued behind the current one.
+    size_t depth() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+    }
+
+private:
+    const size_t slots_;
+    std::vector<size_t> sizes_;
+    std::vector<uint8_t> data_;
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t head_cache_ = 0;  // consumer-side copy of head_
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t tail_cache_ = 0;  // producer-side copy of tail_
+};
+
+// Minimal price-level order book: order map plus aggregated size per price level.
+struct OrderBook {
+    struct Order {
+        uint32_t price;
+        uint32_t shares;
+        char side;
+    };
+
+    std::unordered_map<uint64_t, Order> orders;
+    std::map<uint32_t, uint64_t, std::greater<>> bids;
+    std::map<uint32_t, uint64_t> asks;
+    uint64_t updates = 0;
+
+    explicit OrderBook(size_t live) { orders.reserve(live * 2); }
+
+    void on(const nasdaq::itch::v5::AddOrder& m) {
+        orders.emplace(m.OrderId, Order{m.Price, m.Shares, m.Side});
+        if (m.Side == 'B') {
+            bids[m.Price] += m.Shares;
+        } else {
+            asks[m.Price] += m.Shares;
+        }
+        ++updates;
+    }
+
+    void on(const nasdaq::itch::v5::DeleteOrder& m) {
+        auto it = orders.find(m.OrderId);
+        if (it == orders.end()) return;
+        const Order& o = it->second;
+        if (o.side == 'B') {
+            remove_level(bids, o.price, o.shares);
+        } else {
+            remove_level(asks, o.price, o.shares);
+        }
+        orders.erase(it);
+        ++updates;
+    }
+
+    template <class Levels>
+    static void remove_level(Levels& levels, uint32_t price, uint32_t shares) {
+        auto lvl = levels.find(price);
+        if (lvl == levels.end()) return;
+        if (lvl->second <= shares) {
+            levels.erase(lvl);
+        } else {
+            lvl->second -= shares;
+        }
+    }
+};
+
+// Pre-encodes the message stream: adds until `live` orders rest, then alternates
+// add / delete-oldest so the book stays at a steady depth.
+std::vector<std::vector<uint8_t>> build_stream(const BenchConfig& cfg) {
+    using namespace nasdaq::itch::v5;
+    std::vector<std::vector<uint8_t>> msgs;
+    msgs.reserve(cfg.count);
+    uint64_t next_id = 1;
+    uint64_t oldest_id = 1;
+    uint8_t buf[64];
+    for (size_t i = 0; i < cfg.count; ++i) {
+        size_t written = 0;
+        const bool add = (next_id - oldest_id) < cfg.live || (i % 2 == 0);
+        if (add) {
+            AddOrder m{};
+            m.Type = 'A';
+            m.Timestamp = static_cast<uint32_t>(i);
+            m.OrderId = next_id++;
+            m.Side = (i % 3 == 0) ? 'S' : 'B';
+            m.Shares = 100 + static_cast<uint32_t>(i % 900);
+            std::memcpy(m.Symbol.data(), "BENCHSYM", 8);
+            m.Price = 100000 + static_cast<uint32_t>(i % 64) * (m.Side == 'B' ? 1u : 2u);
+            Encoder::encode(m, buf, sizeof(buf), written);
+        } else {
+            DeleteOrder m{};
+            m.Type = 'D';
+            m.Timestamp = static_cast<uint32_t>(i);
+            m.OrderId = oldest_id++;
+            Encoder::encode(m, buf, sizeof(buf), written);
+        }
+        msgs.emplace_back(buf, buf + written);
+    }
+    return msgs;
+}
+
+// Consumer statistics exported for mdp_top (STATS=/segment). Updates are plain
+// stores into the segment; without STATS the bench skips them.
+#if HAS_UDP
+struct FeedStats {
+    market::runtime::stats_registry reg;
+    market::runtime::stats_counter packets;
+    market::runtime::stats_counter messages;
+    market::runtime::stats_counter gaps;
+    market::runtime::stats_status_counts results;
+    market::runtime::stats_gauge depth;
+    market::runtime::stats_histogram latency;
+
+    bool open(const std::string& name) {
+        if (reg.create(name.c_str()) != status::ok) return false;
+        packets = reg.counter("itch.packets");
+        messages = reg.counter("itch.messages");
+        gaps = reg.counter("itch.sequence_gaps");
+        results = reg.status_counts("itch.dispatch");
+        depth = reg.gauge("ring.depth");
+        latency = reg.histogram("wire_to_book_ns");
+        return true;
+    }
+};
+#else
+struct FeedStats {
+    struct {
+        void add(uint64_t = 1) {}
+    } packets, messages, gaps;
+    struct {
+        void record(status, uint64_t = 1) {}
+    } results;
+    struct {
+        void set(int64_t) {}
+    } depth;
+    struct {
+        void record(uint64_t) {}
+    } latency;
+    struct {
+        void touch(uint64_t) {}
+    } reg;
+    bool open(const std::string&) { return false; }
+};
+#endif
+
+// Consumer side: frame packet, dispatch each message to the book, record latency.
+// In catch-up mode the whole packet goes through the batch path and the packet
+// gets a single completion timestamp instead of one per message.
+struct Receiver {
+    OrderBook& book;
+    std::vector<uint64_t>& latencies;
+    size_t received = 0;
+    size_t errors = 0;
+    uint64_t next_seq = 0;
+    uint64_t gaps = 0;
+    uint64_t batch_packets = 0;
+    FeedStats* stats = nullptr;
+
+    void on_packet(Bytes pkt, market::runtime::feed_mode mode = market::runtime::feed_mode::live) {
+        if (pkt.size() < kPacketHeader) {
+            ++errors;
+            return;
+        }
+        const uint64_t seq = load_be<uint64_t>(pkt.data());
+        const uint64_t send_ns = load_be<uint64_t>(pkt.data() + 8);
+        const uint16_t count = load_be<uint16_t>(pkt.data() + 16);
+        if (seq != next_seq) gaps += seq - next_seq;
+        if (stats) {
+            stats->packets.add();
+            if (seq != next_seq) stats->gaps.add(seq - next_seq);
+        }
+        next_seq = seq + count;
+
+        if (mode == market::runtime::feed_mode::catch_up) {
+            size_t consumed = 0, done_msgs = 0;
+            auto st = nasdaq::itch::v5::dispatch_itch_framed(pkt.subspan(kPacketHeader), count, book, consumed,
+                                                             done_msgs);
+            const uint64_t done = now_ns();
+            if (st != status::ok) ++errors;
+            for (size_t i = 0; i < done_msgs && received < latencies.size(); ++i) {
+                latencies[received++] = done - send_ns;
+            }
+            ++batch_packets;
+            if (stats) {
+                stats->results.record(status::ok, done_msgs);
+                if (st != status::ok) stats->results.record(st);
+                stats->messages.add(done_msgs);
+                stats->reg.touch(done);
+            }
+            return;
+        }
+
+        size_t off = kPacketHeader;
+        for (uint16_t i = 0; i < count && off + 2 <= pkt.size(); ++i) {
+            const uint16_t len = load_be<uint16_t>(pkt.data() + off);
+            off += 2;
+            if (off + len > pkt.size()) {
+                ++errors;
+                return;
+            }
+            size_t consumed = 0;
+            auto st = nasdaq::itch::v5::dispatch_itch(Bytes{pkt.data() + off, len}, book, consumed);
+            const uint64_t done = now_ns();
+            if (st != status::ok) {
+                ++errors;
+            } else if (received < latencies.size()) {
+                latencies[received++] = done - send_ns;
+            }
+            if (stats) {
+                stats->results.record(st);
+                stats->messages.add();
+                if (st == status::ok) stats->latency.record(done - send_ns);
+                stats->reg.touch(done);
+            }
+            off += len;
+        }
+    }
+};
+
+// Publisher side: packs BATCH messages per packet and paces them to RATE.
+template <class SendFn>
+void publish(const BenchConfig& cfg, const std::vector<std::vector<uint8_t>>& msgs, SendFn&& send) {
+    pin_thread(cfg.cpu_pub);
+    uint8_t pkt[kMaxPacket];
+    const uint64_t start = now_ns();
+    const double ns_per_msg = cfg.rate ? 1e9 / static_cast<double>(cfg.rate) : 0.0;
+    size_t i = 0;
+    while (i < msgs.size()) {
+        size_t off = kPacketHeader;
+        uint16_t count = 0;
+        const size_t first = i;
+        while (i < msgs.size() && count < cfg.batch && off + 2 + msgs[i].size() <= kMaxPacket) {
+            store_be<uint16_t>(pkt + off, static_cast<uint16_t>(msgs[i].size()));
+            std::memcpy(pkt + off + 2, msgs[i].data(), msgs[i].size());
+            off += 2 + msgs[i].size();
+            ++count;
+            ++i;
+        }
+        if (ns_per_msg > 0.0) {
+            const uint64_t due = start + static_cast<uint64_t>(ns_per_msg * static_cast<double>(first));
+            while (now_ns() < due) {
+            }
+        }
+        store_be<uint64_t>(pkt, first);
+        store_be<uint16_t>(pkt + 16, count);
+        store_be<uint64_t>(pkt + 8, now_ns());
+        send(pkt, off);
+    }
+}
+
+void report(const BenchConfig& cfg, std::vector<uint64_t>& lat, size_t received, double secs,
+            const Receiver& rx) {
+    lat.resize(received);
+    const uint64_t first = lat.empty() ? 0 : lat.front();
+    std::sort(lat.begin(), lat.end());
+    auto pct = [&](double p) -> uint64_t {
+        if (lat.empty()) return 0;
+        size_t idx = static_cast<size_t>(p / 100.0 * static_cast<double>(lat.size() - 1));
+        return lat[idx];
+    };
+    std::cout << "Wire-to-book latency (transport=" << cfg.transport << ", rate="
+              << (cfg.rate ? std::to_string(cfg.rate) : std::string("max")) << " msg/s, batch="
+              << cfg.batch << ", live=" << cfg.live << ")" << std::endl;
+    // Messages that arrived but failed to decode are errors, not losses
+    const size_t missing = cfg.count - received;
+    const size_t lost = missing > rx.errors ? missing - rx.errors : 0;
+    std::cout << "  messages: sent=" << cfg.count << " received=" << received
+              << " lost=" << lost << " errors=" << rx.errors
+              << " seq_gaps=" << rx.gaps << " catch_up_packets=" << rx.batch_packets << std::endl;
+    std::cout << "  throughput: " << static_cast<uint64_t>(static_cast<double>(received) / secs)
+              << " msg/s" << std::endl;
+    std::cout << "  latency ns: min=" << (lat.empty() ? 0 : lat.front()) << " p50=" << pct(50)
+              << " p90=" << pct(90) << " p99=" << pct(99) << " p99.9=" << pct(99.9)
+              << " p99.99=" << pct(99.99) << " max=" << (lat.empty() ? 0 : lat.back())
+              << " first=" << first << " (warmup=" << cfg.warmup << ")" << std::endl;
+}
+
+// Runs on the consumer thread so its caches and predictors are the ones trained.
+void warm_consumer(const BenchConfig& cfg) {
+    if (cfg.warmup == 0) return;
+    market::runtime::prefault_stack();
+    OrderBook scratch(cfg.live);
+    nasdaq::itch::v5::warmup(scratch, cfg.warmup);
+}
+
+int run_ring(const BenchConfig& cfg, const std::vector<std::vector<uint8_t>>& msgs, FeedStats* stats) {
+    PacketRing ring(4096);
+    OrderBook book(cfg.live);
+    std::vector<uint64_t> lat(cfg.count);
+    Receiver rx{book, lat};
+    rx.stats = stats;
+
+    const auto t0 = steady_clock::now();
+    std::thread consumer([&] {
+        pin_thread(cfg.cpu_sub);
+        warm_consumer(cfg);
+        market::runtime::catchup_thresholds t;
+        t.enter_depth = cfg.catchup ? cfg.catchup_depth : static_cast<size_t>(-1);
+        t.exit_depth = cfg.catchup_depth / 16;
+        t.enter_lag_ns = t.exit_lag_ns = static_cast<uint64_t>(-1);  // depth-driven only
+        market::runtime::backlog_detector backlog(t);
+        while (rx.next_seq < cfg.count) {
+            Bytes pkt = ring.front();
+            if (pkt.empty()) continue;
+            if (rx.stats) rx.stats->depth.set(static_cast<int64_t>(ring.depth()));
+            rx.on_packet(pkt, backlog.update(ring.depth(), 0));
+            ring.pop();
+        }
+    });
+    publish(cfg, msgs, [&](const uint8_t* p, size_t n) {
+        while (!ring.try_push(p, n)) {
+        }
+    });
+    consumer.join();
+    const double secs = duration<double>(steady_clock::now() - t0).count();
+    report(cfg, lat, rx.received, secs, rx);
+    return rx.errors == 0 ? 0 : 1;
+}
+
+#if HAS_UDP
+int run_udp(const BenchConfig& cfg, const std::vector<std::vector<uint8_t>>& msgs, FeedStats* stats) {
+    int rx_fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    int tx_fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (rx_fd < 0 || tx_fd < 0) {
+        std::cerr << "socket() failed" << std::endl;
+        return 1;
+    }
+    int rcvbuf = 16 << 20;
+    ::setsockopt(rx_fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if (::bind(rx_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        std::cerr << "bind() failed" << std::endl;
+        return 1;
+    }
+    socklen_t alen = sizeof(addr);
+    ::getsockname(rx_fd, reinterpret_cast<sockaddr*>(&addr), &alen);
+
+    OrderBook book(cfg.live);
+    std::vector<uint64_t> lat(cfg.count);
+    Receiver rx{book, lat};
+    rx.stats = stats;
+    std::atomic<bool> done{false};
+
+    const auto t0 = steady_clock::now();
+    std::thread consumer([&] {
+        pin_thread(cfg.cpu_sub);
+        warm_consumer(cfg);
+        uint8_t pkt[kMaxPacket];
+        uint64_t idle_since = 0;
+        while (rx.next_seq < cfg.count) {
+            ssize_t n = ::recv(rx_fd, pkt, sizeof(pkt), MSG_DONTWAIT);
+            if (n > 0) {
+                rx.on_packet(Bytes{pkt, static_cast<size_t>(n)});
+                idle_since = 0;
+                continue;
+            }
+            // Busy-poll; give up 100ms after the publisher finished (datagrams lost).
+            if (done.load(std::memory_order_acquire)) {
+                const uint64_t t = now_ns();
+                if (idle_since == 0) idle_since = t;
+                if (t - idle_since > 100'000'000) break;
+            }
+        }
+    });
+    publish(cfg, msgs, [&](const uint8_t* p, size_t n) {
+        ::sendto(tx_fd, p, n, 0, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    });
+    done.store(true, std::memory_order_release);
+    consumer.join();
+    const double secs = duration<double>(steady_clock::now() - t0).count();
+    ::close(rx_fd);
+    ::close(tx_fd);
+    report(cfg, lat, rx.received, secs, rx);
+    return rx.errors == 0 ? 0 : 1;
+}
+#endif
+
+}  // namespace
+
+int main() {
+    BenchConfig cfg;
+    cfg.count = env_u64("COUNT", cfg.count);
+    cfg.rate = env_u64("RATE", cfg.rate);
+    cfg.batch = std::max<size_t>(1, env_u64("BATCH", cfg.batch));
+    cfg.live = std::max<size_t>(1, env_u64("LIVE", cfg.live));
+    if (const char* t = std::getenv("TRANSPORT")) cfg.transport = t;
+    cfg.cpu_pub = static_cast<int>(env_u64("CPU_PUB", static_cast<uint64_t>(-1)));
+    cfg.cpu_sub = static_cast<int>(env_u64("CPU_SUB", static_cast<uint64_t>(-1)));
+    cfg.warmup = env_u64("WARMUP", cfg.warmup);
+    cfg.catchup = env_u64("CATCHUP", 0) != 0;
+    cfg.catchup_depth = std::max<size_t>(16, env_u64("CATCHUP_DEPTH", cfg.catchup_depth));
+    if (const char* s = std::getenv("STATS")) cfg.stats = s;
+
+    const auto msgs = build_stream(cfg);
+    FeedStats stats;
+    FeedStats* sp = nullptr;
+    if (!cfg.stats.empty()) {
+        if (!stats.open(cfg.stats)) {
+            std::cerr << "Cannot create statistics segment " << cfg.stats << std::endl;
+            return 1;
+        }
+        sp = &stats;
+    }
+
+    if (cfg.transport == "ring") return run_ring(cfg, msgs, sp);
+#if HAS_UDP
+    if (cfg.transport == "udp") return run_udp(cfg, msgs, sp);
+#endif
+    std::cerr << "Unsupported TRANSPORT: " << cfg.transport << std::endl;
+    return 1;
+}
+
+#else
+
+int main() {
+    std::cerr << "ITCH generated handlers not found. Generate code first." << std::endl;
+    return 2;
+}
+
+#endif
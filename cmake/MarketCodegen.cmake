@@ -0,0 +1,134 @@
+# Build-integrated code generation.
+#
+#   market_add_schema(<name>)
+#       Render schemas/<name>.yaml (or an SBE schemas/<name>.xml) into
+#       generated/<name>/ as part of the build.
+#       Defines the target market_codegen_<name> and sets MARKET_HAS_<name>
+#       (TRUE when the generated code is available or will be produced).
+#
+#   market_use_generated(<target> <name> [JSON])
+#       Compile the schema's per-message codec units (msg/*.cpp, and json/*.cpp
+#       with JSON) into <target> and order it after the code generation step.
+#
+#   market_add_capi(<name>)
+#       Build the schema's C ABI (capi.h / capi.cpp: batch decode into caller
+#       arrays) as the shared library market_<name>_c. Only MARKET_API symbols
+#       are exported.
+#
+# Each schema is its own custom command, so schemas render in parallel and a
+# change to one schema only regenerates that schema. generate.py rewrites a file
+# only when its content changes; a stamp file records that the step ran, so
+# unchanged headers keep their mtime and do not trigger recompiles.
+#
+# Without Python 3 + jinja2 + PyYAML (or with MARKET_CODEGEN=OFF) the build falls
+# back to whatever was pre-generated into generated/.
+
+option(MARKET_CODEGEN "Regenerate generated/ from schemas as part of the build" ON)
+
+set(MARKET_SCHEMA_DIR "${CMAKE_SOURCE_DIR}/schemas")
+set(MARKET_GENERATED_DIR "${CMAKE_SOURCE_DIR}/generated")
+set(MARKET_GENERATOR "${CMAKE_SOURCE_DIR}/codegen/generate.py")
+
+set(_market_codegen_ok FALSE)
+if(MARKET_CODEGEN)
+    find_package(Python3 COMPONENTS Interpreter QUIET)
+    if(Python3_Interpreter_FOUND)
+        execute_process(
+            COMMAND "${Python3_EXECUTABLE}" -c "import jinja2, yaml"
+            RESULT_VARIABLE _market_py_rc
+            OUTPUT_QUIET ERROR_QUIET)
+        if(_market_py_rc EQUAL 0)
+            set(_market_codegen_ok TRUE)
+        endif()
+    endif()
+    if(NOT _market_codegen_ok)
+        message(STATUS "market: Python 3 with jinja2/PyYAML not found; using pre-generated sources")
+    endif()
+endif()
+
+file(GLOB MARKET_CODEGEN_TEMPLATES CONFIGURE_DEPENDS "${CMAKE_SOURCE_DIR}/codegen/templates/*.j2")
+file(GLOB MARKET_CODEGEN_MODULES CONFIGURE_DEPENDS "${CMAKE_SOURCE_DIR}/codegen/*.py")
+
+if(_market_codegen_ok AND NOT TARGET market_codegen)
+    add_custom_target(market_codegen)
+endif()
+
+function(market_add_schema name)
+    set(schema "${MARKET_SCHEMA_DIR}/${name}.yaml")
+    if(NOT EXISTS "${schema}" AND EXISTS "${MARKET_SCHEMA_DIR}/${name}.xml")
+        set(schema "${MARKET_SCHEMA_DIR}/${name}.xml")
+    endif()
+    set(out_dir "${MARKET_GENERATED_DIR}/${name}")
+
+    if(NOT _market_codegen_ok OR NOT EXISTS "${schema}")
+        if(EXISTS "${out_dir}/fwd.hpp")
+            set(MARKET_HAS_${name} TRUE PARENT_SCOPE)
+        else()
+            set(MARKET_HAS_${name} FALSE PARENT_SCOPE)
+        endif()
+        return()
+    endif()
+
+    # Output list comes from the generator itself; re-run when the schema changes
+    # in case it adds or removes generated files.
+    execute_process(
+        COMMAND "${Python3_EXECUTABLE}" "${MARKET_GENERATOR}" --schema "${schema}" --out "${out_dir}" --list-outputs
+        OUTPUT_VARIABLE outputs
+        RESULT_VARIABLE rc
+        ERROR_VARIABLE err)
+    if(NOT rc EQUAL 0)
+        message(FATAL_ERROR "market: ${schema}: ${err}")
+    endif()
+    string(STRIP "${outputs}" outputs)
+    string(REPLACE "\n" ";" outputs "${outputs}")
+    set_property(DIRECTORY "${CMAKE_SOURCE_DIR}" APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${schema}")
+
+    file(MAKE_DIRECTORY "${CMAKE_BINARY_DIR}/codegen")
+    set(stamp "${CMAKE_BINARY_DIR}/codegen/${name}.stamp")
+    add_custom_command(
+        OUTPUT "${stamp}"
+        BYPRODUCTS ${outputs}
+        COMMAND "${Python3_EXECUTABLE}" "${MARKET_GENERATOR}" --schema "${schema}" --out "${out_dir}"
+        COMMAND "${CMAKE_COMMAND}" -E touch "${stamp}"
+        DEPENDS "${schema}" ${MARKET_CODEGEN_MODULES} ${MARKET_CODEGEN_TEMPLATES}
+        COMMENT "Generating ${name} from schema"
+        VERBATIM)
+    add_custom_target(market_codegen_${name} DEPENDS "${stamp}")
+    add_dependencies(market_codegen market_codegen_${name})
+
+    set_property(GLOBAL PROPERTY MARKET_GENERATED_OUTPUTS_${name} "${outputs}")
+    set(MARKET_HAS_${name} TRUE PARENT_SCOPE)
+endfunction()
+
+function(market_use_generated target name)
+    set(dir "${MARKET_GENERATED_DIR}/${name}")
+    get_property(outputs GLOBAL PROPERTY MARKET_GENERATED_OUTPUTS_${name})
+    if(NOT outputs)
+        file(GLOB outputs CONFIGURE_DEPENDS "${dir}/msg/*.cpp" "${dir}/json/*.cpp")
+    endif()
+    set(srcs ${outputs})
+    if("JSON" IN_LIST ARGN)
+        list(FILTER srcs INCLUDE REGEX "/(msg|json)/[^/]+\\.cpp$")
+    else()
+        list(FILTER srcs INCLUDE REGEX "/msg/[^/]+\\.cpp$")
+    endif()
+    target_sources(${target} PRIVATE ${srcs})
+    if(TARGET market_codegen_${name})
+        set_source_files_properties(${srcs} TARGET_DIRECTORY ${target} PROPERTIES GENERATED TRUE)
+        add_dependencies(${target} market_codegen_${name})
+    endif()
+endfunction()
+
+function(market_add_capi name)
+    set(target market_${name}_c)
+    set(src "${MARKET_GENERATED_DIR}/${name}/capi.cpp")
+    add_library(${target} SHARED "${src}")
+    target_include_directories(${target} PUBLIC $<BUILD_INTERFACE:${CMAKE_SOURCE_DIR}>)
+    set_target_properties(${target} PROPERTIES
+        CXX_VISIBILITY_PRESET hidden
+        VISIBILITY_INLINES_HIDDEN ON)
+    market_use_generated(${target} ${name})
+    if(TARGET market_codegen_${name})
+        set_source_files_properties("${src}" TARGET_DIRECTORY ${target} PROPERTIES GENERATED TRUE)
+    endif()
+endfunction()
@@ -2,10 +2,14 @@
 
 import argparse
 import os
+import struct
 import sys
 import yaml
+from concurrent.futures import ProcessPoolExecutor
 from jinja2 import Environment, FileSystemLoader
 
+from sbe import load_sbe
+
 
 def generate_namespace(protocol, version):
     """Convert protocol and version to C++ namespace."""
@@ -55,6 +59,12 @@ def validate_schema(schema, schema_path):
         if not isinstance(enum_def, dict):
             error(f"enums.{enum_name}", "Enum definition must be a dictionary")
         
+        # `{type: u16, values: {...}}` pins the wire width (SBE encodingType)
+        if isinstance(enum_def.get('values'), dict):
+            if enum_def.get('type') not in ('u8', 'u16', 'u32', 'u64'):
+                error(f"enums.{enum_name}.type", "Pinned enum type must be u8/u16/u32/u64")
+            enum_def = enum_def['values']
+        
         enum_values = set()
         for value_name, value in enum_def.items():
             if not isinstance(value, (int, str)):
@@ -73,7 +83,7 @@ def validate_schema(schema, schema_path):
     # Validate type syntax
     def validate_type(field, path):
         type_str = field['type']
-        if type_str in ['u8', 'u16', 'u32', 'u64']:
+        if type_str in ['u8', 'u16', 'u32', 'u64', 'i8', 'i16', 'i32', 'i64']:
             return
         if type_str == 'char':
             # Check for length field for char arrays
@@ -85,6 +95,21 @@ def validate_schema(schema, schema_path):
                 except (ValueError, TypeError):
                     error(path, f"Invalid char length: {field['length']}")
             return
+        if type_str in ('vstring', 'bytes'):
+            # Variable length: a u8/u16 length prefix followed by the data
+            prefix = field.get('length_prefix', 'u8')
+            if prefix not in ('u8', 'u16'):
+                error(path, f"Invalid length_prefix '{prefix}' for {type_str}. Must be u8 or u16")
+            if 'value' in field:
+                error(path, f"{type_str} fields cannot carry a constant value")
+            if field.get('purpose') == 'presence_map':
+                error(path, f"{type_str} cannot be a presence map")
+            if 'max_length' in field:
+                max_length = field['max_length']
+                limit = 0xFF if prefix == 'u8' else 0xFFFF
+                if not isinstance(max_length, int) or max_length <= 0 or max_length > limit:
+                    error(path, f"max_length must be an integer in 1..{limit} for a {prefix} length prefix")
+            return
         if type_str.startswith('char[') and type_str.endswith(']'):
             try:
                 size = int(type_str[5:-1])
@@ -107,7 +132,7 @@ def validate_schema(schema, schema_path):
             if enum_name not in enum_names:
                 error(path, f"Referenced enum '{enum_name}' does not exist")
             return
-        error(path, f"Invalid type '{type_str}'. Allowed: u8/u16/u32/u64, char, char[N], enum:Name, or enum with enum_type")
+        error(path, f"Invalid type '{type_str}'. Allowed: u8/u16/u32/u64, i8/i16/i32/i64, char, char[N], vstring, bytes, enum:Name, or enum with enum_type")
     
     # Validate endianness if present
     def validate_endianness(endian_str, path):
@@ -238,6 +263,9 @@ def validate_schema(schema, schema_path):
                     count_field = group['count_field']
                     if count_field not in field_names:
                         error(f"messages.{message_name}.groups[{group_idx}].count_field", f"Count field '{count_field}' not found in message fields")
+                    count_type = next(f.get('type') for f in fields if f['name'] == count_field)
+                    if count_type not in ('u8', 'u16', 'u32', 'u64'):
+                        error(f"messages.{message_name}.groups[{group_idx}].count_field", f"Count field '{count_field}' must be an unsigned integer")
                 
                 if 'fields' in group:
                     group_fields = group['fields']
@@ -274,6 +302,137 @@ def validate_schema(schema, schema_path):
                                 error(f"messages.{message_name}.groups[{group_idx}].fields[{field_idx}].optional_bit", f"optional_bit {optional_bit} exceeds presence map width {presence_map_width}")
                             if presence_map_field is None:
                                 error(f"messages.{message_name}.groups[{group_idx}].fields[{field_idx}].optional_bit", "optional_bit specified but no presence map found in message")
+        
+        validate_layout(message_name, message_def, enum_names, error)
+
+
+INT_TYPES = ('u8', 'u16', 'u32', 'u64', 'i8', 'i16', 'i32', 'i64')
+
+
+def validate_layout(message_name, message_def, enum_names, error):
+    """Explicit-layout keys (SBE): header fields, field offsets, block lengths,
+    group dimension headers, null values and non-wire constants."""
+    path = f"messages.{message_name}"
+    fields = message_def['fields']
+    
+    def is_enum(f):
+        return f['type'] == 'enum' or f['type'].startswith('enum:')
+    
+    def check_field(f, fpath):
+        if 'offset' in f and (not isinstance(f['offset'], int) or isinstance(f['offset'], bool) or f['offset'] < 0):
+            error(f"{fpath}.offset", "Must be a non-negative integer")
+        for key in ('null_value', 'default'):
+            if key in f:
+                if not isinstance(f[key], int) or isinstance(f[key], bool):
+                    error(f"{fpath}.{key}", "Must be an integer")
+                if f['type'] not in INT_TYPES and not is_enum(f):
+                    error(f"{fpath}.{key}", f"Only integer and enum fields take a {key}")
+                if 'value' in f:
+                    error(f"{fpath}.{key}", f"Constant fields cannot have a {key}")
+        if 'header' in f and not isinstance(f['header'], bool):
+            error(f"{fpath}.header", "Must be true or false")
+        purpose = f.get('purpose')
+        if purpose not in (None, 'presence_map', 'block_length', 'template_id'):
+            error(f"{fpath}.purpose", f"Unknown purpose '{purpose}'. Must be presence_map, block_length or template_id")
+        if purpose in ('block_length', 'template_id'):
+            if not f.get('header'):
+                error(f"{fpath}.purpose", f"A {purpose} field must be a header field")
+            if f['type'] not in ('u8', 'u16', 'u32', 'u64'):
+                error(f"{fpath}.type", f"A {purpose} field must be an unsigned integer")
+        if purpose == 'template_id' and 'value' not in f:
+            error(f"{fpath}.value", "A template_id field needs the template id as its value")
+    
+    def check_constants(constants, cpath, field_names):
+        if not isinstance(constants, list):
+            error(cpath, "Must be a list")
+        names = set()
+        for i, c in enumerate(constants):
+            if not isinstance(c, dict) or 'name' not in c or 'type' not in c or 'value' not in c:
+                error(f"{cpath}[{i}]", "Constant must have 'name', 'type' and 'value'")
+            if c['name'] in names or c['name'] in field_names:
+                error(f"{cpath}[{i}].name", f"Duplicate name '{c['name']}'")
+            names.add(c['name'])
+            if c['type'] in INT_TYPES:
+                if not isinstance(c['value'], int):
+                    error(f"{cpath}[{i}].value", "Must be an integer")
+            elif c['type'] == 'char':
+                if not isinstance(c['value'], str) or len(c['value']) != int(c.get('length', 1)):
+                    error(f"{cpath}[{i}].value", "Must be a string of the constant's length")
+            elif c['type'] == 'enum':
+                if c.get('enum_type') not in enum_names:
+                    error(f"{cpath}[{i}].enum_type", f"Referenced enum '{c.get('enum_type')}' does not exist")
+                if not isinstance(c['value'], str):
+                    error(f"{cpath}[{i}].value", "Must name an enumerator")
+            else:
+                error(f"{cpath}[{i}].type", f"Invalid constant type '{c['type']}'")
+    
+    seen_body = False
+    for i, f in enumerate(fields):
+        check_field(f, f"{path}.fields[{i}]")
+        if f.get('header'):
+            if seen_body:
+                error(f"{path}.fields[{i}].header", "Header fields must precede all other fields")
+            if 'offset' in f or 'optional_bit' in f or f['type'] in ('vstring', 'bytes'):
+                error(f"{path}.fields[{i}]", "Header fields must be fixed-size, required and without offset")
+        else:
+            seen_body = True
+    
+    block_fields = [f['name'] for f in fields if f.get('purpose') == 'block_length']
+    if len(block_fields) > 1:
+        error(path, "Multiple block_length fields found")
+    if 'block_length' in message_def:
+        block_length = message_def['block_length']
+        if not isinstance(block_length, int) or isinstance(block_length, bool) or block_length <= 0:
+            error(f"{path}.block_length", "Must be a positive integer")
+        if not block_fields:
+            error(f"{path}.block_length", "A message with block_length needs a header field with purpose: block_length")
+        for i, f in enumerate(fields):
+            if 'optional_bit' in f or f['type'] in ('vstring', 'bytes') or f.get('purpose') == 'presence_map':
+                error(f"{path}.fields[{i}]", "Messages with block_length must have fixed-size, required fields only")
+    elif block_fields:
+        error(path, "A block_length field needs the message's block_length")
+    
+    field_names = {f['name'] for f in fields}
+    if 'constants' in message_def:
+        check_constants(message_def['constants'], f"{path}.constants", field_names)
+    
+    for gi, g in enumerate(message_def.get('groups', []) or []):
+        gpath = f"{path}.groups[{gi}]"
+        gfields = g.get('fields', [])
+        for fi, f in enumerate(gfields):
+            check_field(f, f"{gpath}.fields[{fi}]")
+            if f.get('header') or f.get('purpose') in ('block_length', 'template_id'):
+                error(f"{gpath}.fields[{fi}]", "Group fields cannot be header fields")
+        if 'constants' in g:
+            check_constants(g['constants'], f"{gpath}.constants", {f['name'] for f in gfields})
+        if ('block_length' in g) != ('dimension' in g):
+            error(gpath, "block_length and dimension go together")
+        if 'block_length' not in g:
+            continue
+        if 'count_field' in g:
+            error(f"{gpath}.count_field", "A group with a dimension header carries its own count")
+        if not isinstance(g['block_length'], int) or isinstance(g['block_length'], bool) or g['block_length'] <= 0:
+            error(f"{gpath}.block_length", "Must be a positive integer")
+        for fi, f in enumerate(gfields):
+            if 'optional_bit' in f or f['type'] in ('vstring', 'bytes'):
+                error(f"{gpath}.fields[{fi}]", "Groups with block_length must have fixed-size, required fields only")
+        dim = g['dimension']
+        if not isinstance(dim, dict):
+            error(f"{gpath}.dimension", "Must be a dictionary")
+        sizes = {'u8': 1, 'u16': 2, 'u32': 4}
+        if dim.get('block_length') not in ('u8', 'u16'):
+            error(f"{gpath}.dimension.block_length", "Must be u8 or u16")
+        if dim.get('count') not in sizes:
+            error(f"{gpath}.dimension.count", "Must be u8, u16 or u32")
+        count_offset = dim.get('count_offset', sizes[dim['block_length']])
+        if not isinstance(count_offset, int) or count_offset < sizes[dim['block_length']]:
+            error(f"{gpath}.dimension.count_offset", "Must follow the block length")
+        size = dim.get('size', count_offset + sizes[dim['count']])
+        if not isinstance(size, int) or size < count_offset + sizes[dim['count']]:
+            error(f"{gpath}.dimension.size", "Too small for the block length and count")
+        if 'endian' in dim and dim['endian'] not in ('le', 'be'):
+            error(f"{gpath}.dimension.endian", f"Invalid endianness '{dim['endian']}'. Must be 'le' or 'be'")
+
 
 def build_model(schema):
     """Build a generation model with computed enum widths and message metadata."""
@@ -287,9 +446,17 @@ def build_model(schema):
     # Enums info
     enums_info = {}
     for enum_name, enum_def in schema.get('enums', {}).items():
+        pinned = enum_def['type'] if isinstance(enum_def.get('values'), dict) else None
+        if pinned:
+            enum_def = enum_def['values']
         values = {k: parse_enum_value(v) for k, v in enum_def.items()}
         max_val = max(values.values()) if values else 0
-        if max_val <= 0xFF:
+        if pinned:
+            width_bytes = {'u8': 1, 'u16': 2, 'u32': 4, 'u64': 8}[pinned]
+            underlying = f'uint{8 * width_bytes}_t'
+            if max_val >= 1 << (8 * width_bytes):
+                raise ValueError(f"enum {enum_name}: value {max_val} does not fit {pinned}")
+        elif max_val <= 0xFF:
             underlying = 'uint8_t'
             width_bytes = 1
         elif max_val <= 0xFFFF:
@@ -319,10 +486,17 @@ def build_model(schema):
             return 'uint32_t'
         if t == 'u64':
             return 'uint64_t'
+        if t in ('i8', 'i16', 'i32', 'i64'):
+            return f'int{t[1:]}_t'
         if t == 'char':
-            if 'length' in field:
+            # length 1 is a plain char, matching how the codec templates access it
+            if 'length' in field and int(field['length']) > 1:
                 return f"std::array<char, {int(field['length'])}>"
             return 'char'
+        if t == 'vstring':
+            return 'std::string_view'
+        if t == 'bytes':
+            return 'market::runtime::Bytes'
         if t == 'enum':
             return field['enum_type']
         if t.startswith('enum:'):
@@ -332,6 +506,20 @@ def build_model(schema):
             return t
         return t
 
+    def field_c_type(field):
+        """(C element type, array length or None) for the C ABI records.
+        Variable-length fields become an offset/length pair (see capi.h.j2)."""
+        t = field['type']
+        if t in ('vstring', 'bytes'):
+            return 'uint32_t', None
+        if t == 'char':
+            n = int(field.get('length', 1))
+            return 'char', (n if n > 1 else None)
+        if t in INT_TYPES:
+            return field_cxx_type(field), None
+        enum_name = field['enum_type'] if t == 'enum' else t.split(':', 1)[1]
+        return enums_info[enum_name]['underlying'], None
+
     def field_size_bytes(field):
         t = field['type']
         if t == 'u8':
@@ -342,8 +530,13 @@ def build_model(schema):
             return 4
         if t == 'u64':
             return 8
+        if t in ('i8', 'i16', 'i32', 'i64'):
+            return int(t[1:]) // 8
         if t == 'char':
             return int(field.get('length', 1))
+        if t in ('vstring', 'bytes'):
+            # Fixed part only (the length prefix); the data follows
+            return 2 if field.get('length_prefix') == 'u16' else 1
         if t == 'enum':
             enum_name = field['enum_type']
             return enums_info[enum_name]['width_bytes']
@@ -355,6 +548,88 @@ def build_model(schema):
             return {'u8':1,'u16':2,'u32':4,'u64':8}[t]
         raise ValueError(f"Unsupported field type for size: {t}")
 
+    def variable_info(field):
+        """Length-prefix layout of vstring/bytes fields; `max_length` bounds the
+        data (the prefix range unless the schema sets a tighter limit)."""
+        if field['type'] not in ('vstring', 'bytes'):
+            return {'is_variable': False}
+        prefix = field_size_bytes(field)
+        return {
+            'is_variable': True,
+            'prefix_type': 'uint8_t' if prefix == 1 else 'uint16_t',
+            'max_length': int(field.get('max_length', 0xFF if prefix == 1 else 0xFFFF)),
+        }
+
+    def model_field(f):
+        # Signed integers share the unsigned wire code (two's complement); only
+        # the member type differs.
+        signed = f['type'] in ('i8', 'i16', 'i32', 'i64')
+        mf = {
+            'name': f['name'],
+            'type': 'u' + f['type'][1:] if signed else f['type'],
+            'signed': signed,
+            'cxx_type': field_cxx_type(f),
+            'size': field_size_bytes(f),
+            'endian': f.get('endian'),
+            'has_value': 'value' in f,
+            'value': f.get('value'),
+            'optional_bit': f.get('optional_bit'),
+            'is_presence_map': f.get('purpose') == 'presence_map',
+            'is_block_length': f.get('purpose') == 'block_length',
+            'is_template_id': f.get('purpose') == 'template_id',
+            # 8-byte space/NUL padded exchange symbol: gets normalised-key helpers
+            'is_symbol': f['name'] == 'Symbol' and f['type'] == 'char' and int(f.get('length', 1)) == 8,
+            'header': bool(f.get('header')),
+            'enum_type': f.get('enum_type'),
+            'null_value': f.get('null_value'),
+            'null_literal': None,
+            'default_literal': None,
+            'pad_before': 0,
+        }
+        is_enum = f['type'] == 'enum' or f['type'].startswith('enum:')
+        for key in ('null_value', 'default'):
+            if key in f:
+                # enum literals are wrapped in a cast by the templates
+                lit = str(f[key]) if is_enum else int_literal(f[key], f['type'])
+                mf['null_literal' if key == 'null_value' else 'default_literal'] = lit
+        if mf['default_literal'] is None:
+            mf['default_literal'] = mf['null_literal']
+        mf['c_type'], mf['c_len'] = field_c_type(f)
+        mf.update(variable_info(f))
+        return mf
+
+    def lay_out(where, src_fields, model_fields, start):
+        """Apply `offset` (relative to `start`) as padding before each field.
+        Returns the end offset of the last field, or None when it is not static."""
+        at = 0
+        for src, mf in zip(src_fields, model_fields):
+            if 'offset' in src:
+                if at is None:
+                    raise ValueError(f"{where}.{src['name']}: offset after an optional or variable-length field")
+                target = start + src['offset']
+                if target < at:
+                    raise ValueError(f"{where}.{src['name']}: offset {src['offset']} overlaps the previous field")
+                mf['pad_before'] = target - at
+                at = target
+            if at is not None:
+                at = None if (mf['optional_bit'] is not None or mf['is_variable']) else at + mf['size']
+        return at
+
+    def model_constants(constants):
+        out = []
+        for c in constants or []:
+            mc = {'name': c['name'], 'enum_type': None}
+            if c['type'] == 'enum':
+                mc.update(enum_type=c['enum_type'], value=c['value'])
+            elif c['type'] == 'char' and int(c.get('length', 1)) > 1:
+                mc.update(cxx_type='std::string_view', literal=cxx_string(c['value']))
+            elif c['type'] == 'char':
+                mc.update(cxx_type='char', literal=cxx_char(c['value']))
+            else:
+                mc.update(cxx_type=field_cxx_type(c), literal=int_literal(c['value'], c['type']))
+            out.append(mc)
+        return out
+
     # Messages info
     messages_info = []
     for msg_name, msg_def in schema.get('messages', {}).items():
@@ -377,56 +652,126 @@ def build_model(schema):
                 break
 
         # model fields
-        model_fields = []
-        for f in fields:
-            mf = {
-                'name': f['name'],
-                'type': f['type'],
-                'cxx_type': field_cxx_type(f),
-                'size': field_size_bytes(f),
-                'endian': f.get('endian'),
-                'has_value': 'value' in f,
-                'value': f.get('value'),
-                'optional_bit': f.get('optional_bit'),
-                'is_presence_map': f.get('purpose') == 'presence_map',
-                'enum_type': f.get('enum_type'),
-            }
-            model_fields.append(mf)
+        model_fields = [model_field(f) for f in fields]
+
+        # Explicit layout: header fields lead, offsets count from the end of
+        # the header (the SBE root block), block_length pads the block.
+        block_start = sum(f['size'] for f in model_fields if f['header'])
+        root_extent = lay_out(msg_name, fields, model_fields, block_start)
+        block_length = msg_def.get('block_length')
+        tail_pad = 0
+        if block_length is not None:
+            if root_extent - block_start > block_length:
+                raise ValueError(f"{msg_name}: fields take {root_extent - block_start} bytes, "
+                                 f"more than block_length {block_length}")
+            tail_pad = block_start + block_length - root_extent
 
         # groups info
         groups_info = []
         for g in msg_def.get('groups', []) or []:
-            group_fields = []
-            for gf in g.get('fields', []):
-                mgf = {
-                    'name': gf['name'],
-                    'type': gf['type'],
-                    'cxx_type': field_cxx_type(gf),
-                    'size': field_size_bytes(gf),
-                    'endian': gf.get('endian'),
-                    'has_value': 'value' in gf,
-                    'value': gf.get('value'),
-                    'optional_bit': gf.get('optional_bit'),
-                    'enum_type': gf.get('enum_type'),
+            group_fields = [model_field(gf) for gf in g.get('fields', [])]
+            entry_extent = lay_out(f"{msg_name}.{g['name']}", g.get('fields', []), group_fields, 0)
+            dimension = None
+            group_tail_pad = 0
+            if 'block_length' in g:
+                if entry_extent > g['block_length']:
+                    raise ValueError(f"{msg_name}.{g['name']}: fields take {entry_extent} bytes, "
+                                     f"more than block_length {g['block_length']}")
+                group_tail_pad = g['block_length'] - entry_extent
+                dim = g['dimension']
+                widths = {'u8': 1, 'u16': 2, 'u32': 4}
+                count_offset = dim.get('count_offset', widths[dim['block_length']])
+                dimension = {
+                    'block_length_size': widths[dim['block_length']],
+                    'count_size': widths[dim['count']],
+                    'count_offset': count_offset,
+                    'count_max': (1 << (8 * widths[dim['count']])) - 1,
+                    'size': dim.get('size', count_offset + widths[dim['count']]),
+                    'endian': dim.get('endian', 'be'),
                 }
-                group_fields.append(mgf)
             vec_name = g['name'].lower()
             groups_info.append({
                 'name': g['name'],
                 'vector_name': vec_name,
                 'count_field': g.get('count_field'),
                 'fields': group_fields,
+                'block_length': g.get('block_length'),
+                'dimension': dimension,
+                'entry_extent': entry_extent,
+                'tail_pad': group_tail_pad,
+                'constants': model_constants(g.get('constants')),
             })
         count_field_map = {g['count_field']: g['vector_name'] for g in groups_info if g.get('count_field')}
 
         # compute fixed bytes (fields without optional bits and excluding groups)
         fixed_bytes = 0
         has_optional = False
+        has_variable = (any(f['is_variable'] for f in model_fields) or
+                        any(gf['is_variable'] for g in groups_info for gf in g['fields']))
         for f in model_fields:
             if f['optional_bit'] is not None:
                 has_optional = True
             else:
-                fixed_bytes += f['size']
+                fixed_bytes += f['pad_before'] + f['size']
+        fixed_bytes += tail_pad
+
+        # Largest message make_synthetic() builds (warmup.hpp): 16 bytes per
+        # variable-length field, two entries per group.
+        def synthetic(fs):
+            return sum(f['pad_before'] + f['size'] + (16 if f['is_variable'] else 0) for f in fs)
+        synthetic_bytes = synthetic(model_fields) + tail_pad
+        for g in groups_info:
+            if g['dimension']:
+                synthetic_bytes += g['dimension']['size'] + 2 * g['block_length']
+            else:
+                synthetic_bytes += 2 * synthetic(g['fields'])
+
+        # Fixed-size messages have every field at a static offset; they get wire
+        # overlays (wire.hpp) and columnar batch encoding.
+        fixed_size = not has_optional and not groups_info and not has_variable
+        wire_offsets = []
+        at = 0
+        for f in model_fields:
+            at += f['pad_before']
+            wire_offsets.append(at)
+            at += f['size']
+
+        # Columnar batch encoding (encode_columns): each field is either a
+        # caller column or filled by the encoder (constants, length, block
+        # length, an empty presence map, the MessageType discriminator the
+        # decoder checks).
+        columns = None
+        if fixed_size:
+            message_types = enums_info.get('MessageType', {}).get('values', {})
+            columns = []
+            for f, at in zip(model_fields, wire_offsets):
+                if f['has_value'] and f['type'] == 'char' and f['size'] > 1:
+                    columns = None
+                    break
+                if f['has_value']:
+                    fill = 'value'
+                elif f['name'] == length_field_name:
+                    fill = 'length'
+                elif f['is_block_length']:
+                    fill = 'block_length'
+                elif f['is_presence_map']:
+                    fill = 'zero'
+                elif (f['type'] == 'enum' and f['name'] == 'MessageType' and f['enum_type'] == 'MessageType'
+                      and msg_name in message_types):
+                    fill = 'discriminator'
+                else:
+                    fill = 'column'
+                columns.append({'field': f, 'offset': at, 'fill': fill})
+
+        # presence-map bits used by optional fields (message and group level)
+        optional_mask = 0
+        for f in model_fields:
+            if f['optional_bit'] is not None:
+                optional_mask |= 1 << int(f['optional_bit'])
+        for g in groups_info:
+            for gf in g['fields']:
+                if gf['optional_bit'] is not None:
+                    optional_mask |= 1 << int(gf['optional_bit'])
 
         messages_info.append({
             'name': msg_name,
@@ -439,101 +784,416 @@ def build_model(schema):
             'fixed_bytes': fixed_bytes,
             'has_optional': has_optional,
             'has_groups': bool(groups_info),
+            'has_variable': has_variable,
+            'optional_mask': optional_mask,
+            'block_length': block_length,
+            'block_start': block_start,
+            'root_extent': root_extent,
+            'tail_pad': tail_pad,
+            'explicit_layout': (block_length is not None or
+                                any(f['pad_before'] for f in model_fields) or
+                                any(g['dimension'] or any(f['pad_before'] for f in g['fields'])
+                                    for g in groups_info)),
+            'template_id': next((parse_enum_value(f['value']) for f in model_fields if f['is_template_id']), None),
+            'constants': model_constants(msg_def.get('constants')),
+            'synthetic_bytes': synthetic_bytes,
+            'fixed_size': fixed_size,
+            'has_symbol': any(f['is_symbol'] for f in model_fields) or
+                          any(gf['is_symbol'] for g in groups_info for gf in g['fields']),
+            'wire_fields': list(zip(model_fields, wire_offsets)) if fixed_size else None,
+            'columns': columns,
         })
 
+    # Template-id dispatch (SBE): every message carrying a template_id header
+    # field must have it at the same place.
+    template_id = None
+    for msg in messages_info:
+        for f in msg['fields']:
+            if not f['is_template_id']:
+                continue
+            at = sum(p['size'] for p in msg['fields'][:msg['fields'].index(f)])
+            info = {'offset': at, 'size': f['size'], 'endian': f['endian'] or 'be',
+                    'header_size': msg['block_start']}
+            if template_id is None:
+                template_id = info
+            elif info != template_id:
+                raise ValueError(f"{msg['name']}: template_id header field differs from other messages")
+    ids = [m['template_id'] for m in messages_info if m['template_id'] is not None]
+    if len(ids) != len(set(ids)):
+        raise ValueError("Duplicate template ids")
+
     return {
         'enums': list(enums_info.values()),
         'enums_map': enums_info,
         'messages': messages_info,
+        'template_id': template_id,
     }
 
 
-def main():
-    parser = argparse.ArgumentParser(description='Generate C++ code from YAML schema')
-    parser.add_argument('--schema', required=True, help='Input YAML schema file')
-    parser.add_argument('--out', required=True, help='Output directory')
-    parser.add_argument('--check', action='store_true', help='Validate schema only, no code generation')
-    
-    args = parser.parse_args()
-    
-    # Read and parse YAML schema
+def int_literal(value, type_str):
+    """C++ literal for an integer of schema type u8..u64 / i8..i64."""
+    bits = int(type_str[1:])
+    signed = type_str.startswith('i')
+    lo, hi = (-(1 << (bits - 1)), (1 << (bits - 1)) - 1) if signed else (0, (1 << bits) - 1)
+    if not lo <= value <= hi:
+        raise ValueError(f"value {value} out of range for {type_str}")
+    if signed and value == lo:
+        return f'INT{bits}_MIN'
+    if value == hi:
+        return f'INT{bits}_MAX' if signed else f'UINT{bits}_MAX'
+    return f'{value}ull' if bits == 64 and not signed else str(value)
+
+
+def cxx_char(c):
+    return "'\\''" if c == "'" else ("'\\\\'" if c == '\\' else f"'{c}'")
+
+
+def cxx_string(s):
+    return '"' + s.replace('\\', '\\\\').replace('"', '\\"') + '"'
+
+
+# Binary schema descriptor (see runtime/schema_interp.hpp for the reader).
+DESCRIPTOR_MAGIC = b'MDSD'
+DESCRIPTOR_FORMAT_VERSION = 2
+
+FIELD_KIND_UINT = 0
+FIELD_KIND_CHAR = 1
+FIELD_KIND_ENUM = 2
+FIELD_KIND_VSTRING = 3  # size = length prefix width
+FIELD_KIND_BYTES = 4
+
+FIELD_FLAG_BIG_ENDIAN = 0x01
+FIELD_FLAG_HAS_VALUE = 0x02
+FIELD_FLAG_OPTIONAL = 0x04
+FIELD_FLAG_PRESENCE_MAP = 0x08
+FIELD_FLAG_LENGTH = 0x10
+FIELD_FLAG_DISCRIMINATOR = 0x20
+
+NO_INDEX = 0xFFFF
+
+
+def build_descriptor(protocol, version, model):
+    """Compile the generation model into the compact binary descriptor consumed by
+    the runtime schema interpreter. All integers are little-endian."""
+
+    def pack_str(s):
+        b = s.encode('utf-8')
+        if len(b) > 255:
+            raise ValueError(f"Name too long for descriptor: {s}")
+        return struct.pack('<B', len(b)) + b
+
+    def field_kind(f):
+        if f['type'] == 'char':
+            return FIELD_KIND_CHAR
+        if f['type'] == 'vstring':
+            return FIELD_KIND_VSTRING
+        if f['type'] == 'bytes':
+            return FIELD_KIND_BYTES
+        if f['type'] == 'enum' or f['type'].startswith('enum:'):
+            return FIELD_KIND_ENUM
+        return FIELD_KIND_UINT
+
+    def const_value(f):
+        v = f['value']
+        if isinstance(v, str) and f['type'] == 'char':
+            return ord(v[0])
+        if isinstance(v, str):
+            return int(v, 16) if v.lower().startswith('0x') else int(v)
+        return int(v)
+
+    def discriminator(msg):
+        # Prefer an enum MessageType field whose enumerator matches the message
+        # name (BOE style), then the first constant-valued field (ITCH Type).
+        message_types = model['enums_map'].get('MessageType', {}).get('values', {})
+        for prefer_enum in (True, False):
+            for i, f in enumerate(msg['fields']):
+                if f['optional_bit'] is not None or f['is_variable']:
+                    break
+                if prefer_enum:
+                    if f['type'] == 'enum' and f['enum_type'] == 'MessageType' and msg['name'] in message_types:
+                        return i, message_types[msg['name']]
+                elif f['has_value'] and f['type'] in ('char', 'u8', 'u16', 'u32', 'u64') and f['size'] <= 8:
+                    return i, const_value(f)
+        return None, 0
+
+    def pack_field(f, flags_extra=0, value=None):
+        flags = flags_extra
+        if f.get('endian') == 'be':
+            flags |= FIELD_FLAG_BIG_ENDIAN
+        if f['optional_bit'] is not None:
+            flags |= FIELD_FLAG_OPTIONAL
+        if f.get('is_presence_map'):
+            flags |= FIELD_FLAG_PRESENCE_MAP
+        if value is None and f['has_value'] and f['type'] in ('char', 'u8', 'u16', 'u32', 'u64') and f['size'] <= 8:
+            value = const_value(f)
+        if value is not None:
+            flags |= FIELD_FLAG_HAS_VALUE
+        elif f['is_variable']:
+            value = f['max_length']  # not a constant: the data length limit
+        return (pack_str(f['name']) +
+                struct.pack('<BHBBQ', field_kind(f), f['size'], flags,
+                            f['optional_bit'] if f['optional_bit'] is not None else 0,
+                            value if value is not None else 0))
+
     try:
-        with open(args.schema, 'r') as f:
-            schema = yaml.safe_load(f)
-    except Exception as e:
-        print(f"Error reading schema: {e}", file=sys.stderr)
-        sys.exit(1)
-    
-    # Validate schema
+        schema_version = int(version)
+    except (TypeError, ValueError):
+        schema_version = 0
+
+    out = bytearray()
+    out += DESCRIPTOR_MAGIC
+    out += struct.pack('<HH', DESCRIPTOR_FORMAT_VERSION, schema_version & 0xFFFF)
+    # Explicit layouts (field offsets, block lengths, group dimension headers)
+    # have no descriptor encoding yet: the interpreter does not know those
+    # messages and reports them as unknown_type.
+    messages = [m for m in model['messages'] if not m['explicit_layout']]
+    out += pack_str(protocol)
+    out += struct.pack('<H', len(messages))
+    for msg in messages:
+        names = [f['name'] for f in msg['fields']]
+        disc_index, disc_value = discriminator(msg)
+        out += pack_str(msg['name'])
+        out += struct.pack('<HHHH',
+                           len(msg['fields']),
+                           names.index(msg['presence_field']) if msg['presence_field'] else NO_INDEX,
+                           names.index(msg['length_field']) if msg['length_field'] else NO_INDEX,
+                           disc_index if disc_index is not None else NO_INDEX)
+        for i, f in enumerate(msg['fields']):
+            extra = 0
+            if f['name'] == msg['length_field']:
+                extra |= FIELD_FLAG_LENGTH
+            if i == disc_index:
+                extra |= FIELD_FLAG_DISCRIMINATOR
+            out += pack_field(f, extra, disc_value if i == disc_index else None)
+        out += struct.pack('<H', len(msg['groups']))
+        for g in msg['groups']:
+            out += pack_str(g['name'])
+            out += struct.pack('<HH', names.index(g['count_field']), len(g['fields']))
+            for gf in g['fields']:
+                out += pack_field(gf)
+    return bytes(out)
+
+
+TEMPLATE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'templates')
+
+# Template files rendered once per schema (output name = template name without .j2)
+TEMPLATES = [
+    'fwd.hpp.j2',
+    'messages.hpp.j2',
+    'messages.cpp.j2',
+    'encoder.hpp.j2',
+    'decoder.hpp.j2',
+    'handler.hpp.j2',
+    'warmup.hpp.j2',
+    'json.hpp.j2',
+    'capi.h.j2',
+    'capi.cpp.j2',
+    'wire.hpp.j2',
+    'session.hpp.j2',
+    'schema.md.j2'
+]
+
+# Templates rendered once per message, each into its own translation unit so
+# compile time and memory grow linearly with the schema and rebuilds after a
+# schema edit only touch the messages that changed.
+MESSAGE_TEMPLATES = {
+    'msg.hpp.j2': 'msg/{name}.hpp',
+    'msg.cpp.j2': 'msg/{name}.cpp',
+    'msg_json.cpp.j2': 'json/{name}.cpp',
+}
+
+# Record of the previous run's outputs, used to delete files for messages that
+# no longer exist (a stale msg/*.cpp would otherwise still be compiled).
+MANIFEST = '.manifest'
+
+
+def output_names(schema):
+    """Files generate_schema() produces for a schema, relative to its output directory."""
+    names = [t[:-3] for t in TEMPLATES] + ['schema.bin']
+    for msg_name in schema.get('messages', {}):
+        names += [pattern.format(name=msg_name) for pattern in MESSAGE_TEMPLATES.values()]
+    return names
+
+
+def write_if_changed(path, data):
+    """Write `data` (str or bytes) only if the file content differs.
+
+    Unchanged outputs keep their mtime, so build tools do not recompile
+    everything that includes them after an unrelated schema or template edit.
+    Returns True if the file was written.
+    """
+    if isinstance(data, str):
+        data = data.encode('utf-8')
     try:
-        validate_schema(schema, args.schema)
-        print(f"Schema OK: {args.schema}")
-    except ValueError as e:
-        print(f"Error: {e}", file=sys.stderr)
-        sys.exit(1)
-    
-    if args.check:
-        # Lint only
-        sys.exit(0)
-    
+        with open(path, 'rb') as f:
+            if f.read() == data:
+                return False
+    except FileNotFoundError:
+        pass
+    tmp = f"{path}.tmp{os.getpid()}"
+    with open(tmp, 'wb') as f:
+        f.write(data)
+    os.replace(tmp, path)
+    return True
+
+
+# libyaml's loader is an order of magnitude faster than the pure-Python one and
+# dominates generation time on large schemas; fall back when PyYAML lacks it.
+_YamlLoader = getattr(yaml, 'CSafeLoader', yaml.SafeLoader)
+
+
+def load_schema(schema_path):
+    """Read and validate a schema (YAML, or SBE XML via sbe.py). Raises
+    ValueError with a readable message."""
+    if schema_path.endswith('.xml'):
+        schema = load_sbe(schema_path)
+        validate_schema(schema, schema_path)
+        return schema
+    try:
+        with open(schema_path, 'r') as f:
+            schema = yaml.load(f, Loader=_YamlLoader)
+    except Exception as e:
+        raise ValueError(f"reading schema {schema_path}: {e}")
+    validate_schema(schema, schema_path)
+    return schema
+
+
+def generate_schema(schema_path, out_dir):
+    """Render every template for one schema into `out_dir`.
+
+    Returns (written, unchanged) file counts.
+    """
+    schema = load_schema(schema_path)
+
     # Extract protocol info
     protocol = schema.get('protocol', 'unknown')
     version = schema.get('version', 1)
     namespace = generate_namespace(protocol, version)
-    
+
     # Setup Jinja2 environment
     env = Environment(
-        loader=FileSystemLoader('codegen/templates'),
+        loader=FileSystemLoader(TEMPLATE_DIR),
         trim_blocks=True,
         lstrip_blocks=True
     )
-    
+
     # Build generation model with computed metadata
     model = build_model(schema)
-    
+
     # Template context
     context = {
         'schema': schema,
         'protocol': protocol,
         'version': version,
         'namespace': namespace,
+        'c_prefix': namespace.replace('::', '_'),
         'model': model
     }
-    
-    # Template files to generate
-    templates = [
-        'messages.hpp.j2',
-        'messages.cpp.j2',
-        'encoder.hpp.j2',
-        'encoder.cpp.j2',
-        'decoder.hpp.j2',
-        'decoder.cpp.j2',
-        'handler.hpp.j2',
-        'json.hpp.j2',
-        'json.cpp.j2',
-        'schema.md.j2'
-    ]
-    
-    # Create output directory
-    os.makedirs(args.out, exist_ok=True)
-    
-    # Generate files
-    for template_name in templates:
+
+    outputs = {}
+    for template_name in TEMPLATES:
+        try:
+            outputs[template_name[:-3]] = env.get_template(template_name).render(**context)
+        except Exception as e:
+            raise ValueError(f"processing template {template_name}: {e}")
+    for template_name, pattern in MESSAGE_TEMPLATES.items():
         try:
             template = env.get_template(template_name)
-            output = template.render(**context)
-            
-            # Remove .j2 extension for output filename
-            output_file = os.path.join(args.out, template_name[:-3])
-            
-            with open(output_file, 'w') as f:
-                f.write(output)
-                
+            for msg in model['messages']:
+                outputs[pattern.format(name=msg['name'])] = template.render(msg=msg, **context)
         except Exception as e:
-            print(f"Error processing template {template_name}: {e}", file=sys.stderr)
-            sys.exit(1)
-    
-    print(f"Generated to {args.out}")
+            raise ValueError(f"processing template {template_name}: {e}")
+
+    # Binary descriptor for the runtime schema interpreter
+    try:
+        outputs['schema.bin'] = build_descriptor(protocol, version, model)
+    except Exception as e:
+        raise ValueError(f"building schema descriptor: {e}")
+
+    written = 0
+    for name, data in outputs.items():
+        path = os.path.join(out_dir, name)
+        os.makedirs(os.path.dirname(path), exist_ok=True)
+        written += write_if_changed(path, data)
+
+    # Remove outputs of the previous run that this one did not produce
+    manifest = os.path.join(out_dir, MANIFEST)
+    try:
+        with open(manifest, 'r') as f:
+            previous = set(f.read().split())
+    except FileNotFoundError:
+        previous = set()
+    for name in sorted(previous - set(outputs)):
+        try:
+            os.remove(os.path.join(out_dir, name))
+        except FileNotFoundError:
+            pass
+    write_if_changed(manifest, '\n'.join(sorted(outputs)) + '\n')
+
+    return written, len(outputs) - written
+
+
+def _generate_job(job):
+    schema_path, out_dir = job
+    try:
+        return schema_path, out_dir, generate_schema(schema_path, out_dir), None
+    except ValueError as e:
+        return schema_path, out_dir, None, str(e)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate C++ code from YAML schema')
+    parser.add_argument('--schema', required=True, nargs='+',
+                        help='Input YAML schema file(s)')
+    parser.add_argument('--out', required=True,
+                        help='Output directory (with several schemas: parent directory, '
+                             'one subdirectory per schema file name)')
+    parser.add_argument('--check', action='store_true', help='Validate schema only, no code generation')
+    parser.add_argument('--list-outputs', action='store_true',
+                        help='Print the files that would be generated, one per line, and exit')
+    parser.add_argument('-j', '--jobs', type=int, default=0,
+                        help='Schemas rendered in parallel (default: one per schema, up to CPU count)')
+
+    args = parser.parse_args()
+
+    if len(args.schema) == 1:
+        jobs = [(args.schema[0], args.out)]
+    else:
+        jobs = [(s, os.path.join(args.out, os.path.splitext(os.path.basename(s))[0])) for s in args.schema]
+
+    if args.check or args.list_outputs:
+        for schema_path, out_dir in jobs:
+            try:
+                schema = load_schema(schema_path)
+            except ValueError as e:
+                print(f"Error: {e}", file=sys.stderr)
+                sys.exit(1)
+            if args.check:
+                print(f"Schema OK: {schema_path}")
+            else:
+                for name in output_names(schema):
+                    print(os.path.join(out_dir, name))
+        sys.exit(0)
+
+    # Schemas are independent; render them in separate processes
+    workers = args.jobs or min(len(jobs), os.cpu_count() or 1)
+    if workers > 1 and len(jobs) > 1:
+        with ProcessPoolExecutor(max_workers=workers) as pool:
+            results = list(pool.map(_generate_job, jobs))
+    else:
+        results = [_generate_job(job) for job in jobs]
+
+    failed = False
+    for schema_path, out_dir, counts, error in results:
+        if error:
+            print(f"Error: {error}", file=sys.stderr)
+            failed = True
+            continue
+        written, unchanged = counts
+        print(f"Schema OK: {schema_path}")
+        print(f"Generated to {out_dir} ({written} updated, {unchanged} unchanged)")
+    if failed:
+        sys.exit(1)
 
 
 if __name__ == '__main__':
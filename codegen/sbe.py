@@ -0,0 +1,394 @@
+#!/usr/bin/env python3
+"""SBE (Simple Binary Encoding) XML front end.
+
+Translates an SBE 1.0 message schema, as published for CME MDP 3.0, into the
+schema dictionary the YAML front end produces, so validation, the generation
+model and every template are shared:
+
+- the messageHeader composite becomes leading `header` fields on every message
+  (block length, template id checked as a constant, schema id, version),
+- composite fields are flattened: a composite with one non-constant member
+  becomes a single field named after the SBE field, otherwise one field per
+  member (`<Field><Member>`); constant members become `constants`,
+- types with presence="optional" carry their `null_value` (explicit or the SBE
+  default for the primitive type),
+- field offsets and message/group blockLength are kept (`offset`,
+  `block_length`), and group dimension composites become `dimension`,
+- enums pin their wire width to the encodingType; sets become unsigned fields
+  with a bit-mask enum of their choices.
+
+Not supported (rejected with an error): nested groups, <data> variable-length
+fields, float/double, signed enum encodings and non-char arrays.
+
+Run directly to print the translated schema as YAML:
+
+    python codegen/sbe.py schemas/cme_mdp3_v9.xml
+"""
+
+import sys
+import xml.etree.ElementTree as ET
+
+# SBE primitive -> (schema type, size, SBE default null value)
+PRIMITIVES = {
+    'char': ('char', 1, 0),
+    'int8': ('i8', 1, -(1 << 7)),
+    'int16': ('i16', 2, -(1 << 15)),
+    'int32': ('i32', 4, -(1 << 31)),
+    'int64': ('i64', 8, -(1 << 63)),
+    'uint8': ('u8', 1, (1 << 8) - 1),
+    'uint16': ('u16', 2, (1 << 16) - 1),
+    'uint32': ('u32', 4, (1 << 32) - 1),
+    'uint64': ('u64', 8, (1 << 64) - 1),
+}
+
+# messageHeader members with a fixed meaning (SBE names)
+HEADER_BLOCK_LENGTH = 'blockLength'
+HEADER_TEMPLATE_ID = 'templateId'
+HEADER_SCHEMA_ID = 'schemaId'
+HEADER_VERSION = 'version'
+
+
+class SbeError(ValueError):
+    pass
+
+
+def _local(tag):
+    """Element tag without its XML namespace ({uri}message -> message)."""
+    return tag.rsplit('}', 1)[-1]
+
+
+def _title(name):
+    return name[:1].upper() + name[1:]
+
+
+def _int(text, where):
+    try:
+        return int(str(text).strip(), 0)
+    except ValueError:
+        raise SbeError(f"{where}: expected an integer, got '{text}'")
+
+
+class _Schema:
+    def __init__(self, root, path):
+        self.path = path
+        self.types = {}
+        self.endian = 'be' if root.get('byteOrder', 'littleEndian') == 'bigEndian' else 'le'
+        self.schema_id = _int(root.get('id', '0'), 'messageSchema id')
+        self.version = _int(root.get('version', '0'), 'messageSchema version')
+        self.package = root.get('package') or 'sbe'
+        self.header_type = root.get('headerType', 'messageHeader')
+        for types in root:
+            if _local(types.tag) != 'types':
+                continue
+            for t in types:
+                kind = _local(t.tag)
+                if kind in ('type', 'composite', 'enum', 'set'):
+                    self.types[t.get('name')] = t
+        self.enums = {}
+
+    def error(self, where, message):
+        raise SbeError(f"{self.path}: {where}: {message}")
+
+    # -- primitive types ----------------------------------------------------
+
+    def primitive(self, elem, where):
+        """(schema type, size, length, presence, null value, constant text) of a <type>."""
+        prim = elem.get('primitiveType')
+        if prim not in PRIMITIVES:
+            self.error(where, f"unsupported primitiveType '{prim}'")
+        stype, size, default_null = PRIMITIVES[prim]
+        length = _int(elem.get('length', '1'), where)
+        if length != 1 and prim != 'char':
+            self.error(where, f"arrays of {prim} are not supported")
+        presence = elem.get('presence', 'required')
+        null = elem.get('nullValue')
+        if presence == 'optional':
+            null = _int(null, where) if null is not None else default_null
+        else:
+            null = None
+        return stype, size * length, length, presence, null, (elem.text or '').strip()
+
+    def resolve(self, type_name, where):
+        elem = self.types.get(type_name)
+        if elem is None:
+            if type_name in PRIMITIVES:
+                return ET.Element('type', {'name': type_name, 'primitiveType': type_name})
+            self.error(where, f"unknown type '{type_name}'")
+        return elem
+
+    def encoding(self, elem, where):
+        """Underlying <type> (or primitive) of an enum or set."""
+        enc = elem.get('encodingType')
+        target = self.resolve(enc, where)
+        if _local(target.tag) != 'type':
+            self.error(where, f"encodingType '{enc}' must be a primitive type")
+        return target
+
+    # -- enums and sets -----------------------------------------------------
+
+    def enum(self, elem):
+        """Register an <enum> or <set> as a schema enum; returns its name."""
+        name = elem.get('name')
+        if name in self.enums:
+            return name
+        where = f"{_local(elem.tag)} {name}"
+        stype, size, _, _, _, _ = self.primitive(self.encoding(elem, where), where)
+        if stype.startswith('i'):
+            self.error(where, "signed enum encodings are not supported")
+        values = {}
+        if _local(elem.tag) == 'enum':
+            for v in elem:
+                if _local(v.tag) != 'validValue':
+                    continue
+                text = (v.text or '').strip()
+                if stype == 'char':
+                    if len(text) != 1:
+                        self.error(where, f"char enum value '{text}' must be one character")
+                    values[v.get('name')] = ord(text)
+                else:
+                    values[v.get('name')] = _int(text, where)
+        else:
+            # set: one bit per choice
+            for c in elem:
+                if _local(c.tag) == 'choice':
+                    values[c.get('name')] = 1 << _int(c.text, where)
+        self.enums[name] = {'type': 'u8' if stype == 'char' else stype, 'values': values}
+        return name
+
+    # -- fields -------------------------------------------------------------
+
+    def constant_value(self, elem, value_ref, where):
+        """Constant of a presence="constant" field: `valueRef` (Enum.Value) or the type's text."""
+        if value_ref:
+            enum_name, _, value_name = value_ref.partition('.')
+            enum = self.resolve(enum_name, where)
+            if _local(enum.tag) != 'enum':
+                self.error(where, f"valueRef '{value_ref}' does not name an enum value")
+            self.enum(enum)
+            if value_name not in self.enums[enum_name]['values']:
+                self.error(where, f"valueRef '{value_ref}': no such value")
+            return {'type': 'enum', 'enum_type': enum_name, 'value': value_name}
+        stype, _, length, _, _, text = self.primitive(elem, where)
+        if stype == 'char':
+            if length == 1 and len(text) != 1:
+                self.error(where, f"char constant '{text}' must be one character")
+            return {'type': 'char', 'length': length, 'value': text} if length > 1 else {'type': 'char', 'value': text}
+        return {'type': stype, 'value': _int(text, where)}
+
+    def lower(self, name, type_name, presence, value_ref, where):
+        """Schema fields and constants for one SBE field or composite member.
+
+        Returns (fields, constants, size); field offsets are relative to the
+        start of the lowered value."""
+        elem = self.resolve(type_name, where) if isinstance(type_name, str) else type_name
+        kind = _local(elem.tag)
+
+        if kind in ('enum', 'set'):
+            enum_name = self.enum(elem)
+            if presence == 'constant':
+                return [], [{'name': name, **self.constant_value(elem, value_ref, where)}], 0
+            enc_where = f"{where} ({enum_name})"
+            enc = self.encoding(elem, enc_where)
+            stype, size, _, enc_presence, null, _ = self.primitive(enc, enc_where)
+            if kind == 'set':
+                field = {'name': name, 'type': stype, 'enum_type': enum_name}
+            else:
+                field = {'name': name, 'type': 'enum', 'enum_type': enum_name}
+            if size > 1:
+                field['endian'] = self.endian
+            if enc_presence == 'optional' or presence == 'optional':
+                field['null_value'] = null if null is not None else PRIMITIVES[enc.get('primitiveType')][2]
+            return [field], [], size
+
+        if kind == 'type':
+            stype, size, length, type_presence, null, text = self.primitive(elem, where)
+            if presence == 'constant' or type_presence == 'constant':
+                return [], [{'name': name, **self.constant_value(elem, value_ref, where)}], 0
+            field = {'name': name, 'type': stype}
+            if stype == 'char' and length > 1:
+                field['length'] = length
+            elif size > 1:
+                field['endian'] = self.endian
+            if presence == 'optional' and null is None and stype != 'char':
+                null = PRIMITIVES[elem.get('primitiveType')][2]
+            if null is not None and stype != 'char':
+                field['null_value'] = null
+            return [field], [], size
+
+        if kind == 'composite':
+            members = [m for m in elem if _local(m.tag) in ('type', 'enum', 'set', 'composite', 'ref')]
+            variable = [m for m in members if not (_local(m.tag) == 'type' and m.get('presence') == 'constant')]
+            fields, constants, offset = [], [], 0
+            for m in members:
+                mname = m.get('name')
+                mwhere = f"{where}.{mname}"
+                if _local(m.tag) == 'ref':
+                    m = self.resolve(m.get('type'), mwhere)
+                # A single wire member takes the field's own name
+                lowered = name if len(variable) == 1 and m in variable else name + _title(mname)
+                if m.get('offset') is not None:
+                    at = _int(m.get('offset'), mwhere)
+                    if at < offset:
+                        self.error(mwhere, f"offset {at} overlaps the previous member")
+                    offset = at
+                sub_fields, sub_consts, sub_size = self.lower(lowered, m, presence if presence == 'optional' else None,
+                                                              None, mwhere)
+                for f in sub_fields:
+                    f['_at'] = offset + f.pop('_at', 0)
+                fields += sub_fields
+                constants += sub_consts
+                offset += sub_size
+            return fields, constants, offset
+
+        self.error(where, f"unsupported type kind '{kind}'")
+
+    def block(self, elem, where):
+        """Fields and constants of a message or group block, with SBE offsets."""
+        fields, constants, offset = [], [], 0
+        for child in elem:
+            kind = _local(child.tag)
+            if kind != 'field':
+                continue
+            fname = child.get('name')
+            fwhere = f"{where}.{fname}"
+            sub_fields, sub_consts, size = self.lower(fname, child.get('type'), child.get('presence', 'required'),
+                                                      child.get('valueRef'), fwhere)
+            constants += sub_consts
+            if not sub_fields:
+                continue
+            if child.get('offset') is not None:
+                at = _int(child.get('offset'), fwhere)
+                if at < offset:
+                    self.error(fwhere, f"offset {at} overlaps the previous field")
+                offset = at
+            for f in sub_fields:
+                at = offset + f.pop('_at', 0)
+                f['offset'] = at
+                fields.append(f)
+            offset += size
+        return fields, constants, offset
+
+    def header_fields(self, template_id, where):
+        header = self.resolve(self.header_type, where)
+        fields, _, size = self.lower('', header, None, None, f"{where} header")
+        out = []
+        names = {}
+        for f in fields:
+            f.pop('_at', None)
+            sbe_name = f['name'][:1].lower() + f['name'][1:]
+            f['header'] = True
+            if sbe_name == HEADER_BLOCK_LENGTH:
+                f['purpose'] = 'block_length'
+            elif sbe_name == HEADER_TEMPLATE_ID:
+                f['purpose'] = 'template_id'
+                f['value'] = template_id
+            elif sbe_name == HEADER_SCHEMA_ID:
+                f['value'] = self.schema_id
+            elif sbe_name == HEADER_VERSION:
+                f['default'] = self.version
+            names[sbe_name] = f
+            out.append(f)
+        for required in (HEADER_BLOCK_LENGTH, HEADER_TEMPLATE_ID):
+            if required not in names:
+                self.error(self.header_type, f"header composite has no '{required}' member")
+        return out, size
+
+    def group(self, elem, where):
+        name = elem.get('name')
+        gwhere = f"{where}.{name}"
+        for child in elem:
+            if _local(child.tag) == 'group':
+                self.error(gwhere, "nested repeating groups are not supported")
+            if _local(child.tag) == 'data':
+                self.error(gwhere, "<data> fields are not supported")
+        dim_type = elem.get('dimensionType', 'groupSize')
+        dim = self.resolve(dim_type, gwhere)
+        dim_fields, _, dim_size = self.lower('', dim, None, None, f"{gwhere} ({dim_type})")
+        members = {f['name'][:1].lower() + f['name'][1:]: f for f in dim_fields}
+        if 'blockLength' not in members or 'numInGroup' not in members:
+            self.error(dim_type, "dimension composite needs blockLength and numInGroup")
+        fields, constants, extent = self.block(elem, gwhere)
+        block_length = _int(elem.get('blockLength', extent), gwhere)
+        if block_length < extent:
+            self.error(gwhere, f"blockLength {block_length} is smaller than its fields ({extent} bytes)")
+        return {
+            'name': name,
+            'block_length': block_length,
+            'dimension': {
+                'block_length': members['blockLength']['type'],
+                'count': members['numInGroup']['type'],
+                'count_offset': members['numInGroup']['_at'],
+                'size': dim_size,
+                'endian': self.endian,
+            },
+            'fields': fields,
+            **({'constants': constants} if constants else {}),
+        }
+
+    def message(self, elem):
+        name = elem.get('name')
+        where = f"message {name}"
+        template_id = _int(elem.get('id'), where)
+        header, header_size = self.header_fields(template_id, where)
+        fields, constants, extent = self.block(elem, where)
+        block_length = _int(elem.get('blockLength', extent), where)
+        if block_length < extent:
+            self.error(where, f"blockLength {block_length} is smaller than its fields ({extent} bytes)")
+        groups = []
+        for child in elem:
+            kind = _local(child.tag)
+            if kind == 'group':
+                groups.append(self.group(child, where))
+            elif kind == 'data':
+                self.error(f"{where}.{child.get('name')}", "<data> fields are not supported")
+        msg = {'block_length': block_length, 'fields': header + fields}
+        if constants:
+            msg['constants'] = constants
+        if groups:
+            msg['groups'] = groups
+        return name, msg
+
+
+def load_sbe(path):
+    """Parse an SBE XML schema into a YAML-equivalent schema dictionary."""
+    try:
+        root = ET.parse(path).getroot()
+    except (OSError, ET.ParseError) as e:
+        raise SbeError(f"reading SBE schema {path}: {e}")
+    if _local(root.tag) != 'messageSchema':
+        raise SbeError(f"{path}: root element must be messageSchema, got {_local(root.tag)}")
+    s = _Schema(root, path)
+    # Every enum and set, in declaration order (also those only used by valueRef)
+    for elem in s.types.values():
+        if _local(elem.tag) in ('enum', 'set'):
+            s.enum(elem)
+    messages = {}
+    for elem in root:
+        if _local(elem.tag) == 'message':
+            name, msg = s.message(elem)
+            if name in messages:
+                s.error(f"message {name}", "duplicate message name")
+            messages[name] = msg
+    return {
+        'protocol': s.package.replace('.', '_'),
+        'version': s.version,
+        'enums': s.enums,
+        'messages': messages,
+    }
+
+
+def main():
+    import yaml
+    if len(sys.argv) != 2:
+        print(f"usage: {sys.argv[0]} <schema.xml>", file=sys.stderr)
+        sys.exit(2)
+    try:
+        schema = load_sbe(sys.argv[1])
+    except SbeError as e:
+        print(f"Error: {e}", file=sys.stderr)
+        sys.exit(1)
+    yaml.safe_dump(schema, sys.stdout, sort_keys=False, width=120)
+
+
+if __name__ == '__main__':
+    main()
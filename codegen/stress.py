@@ -0,0 +1,340 @@
+#!/usr/bin/env python3
+"""Generator scalability stress test.
+
+Builds a synthetic venue-sized schema (hundreds of messages, thousands of
+fields, enums, presence maps, repeating groups and variable-length fields), runs generate.py on it and
+reports:
+
+  - generation time and generated lines of code (shared headers vs per-message units)
+  - C++ compile time and peak memory per translation unit, and the whole set
+  - optionally (--unity) the same code compiled as one translation unit, which is
+    what the old single decoder.cpp/encoder.cpp layout amounted to
+
+It then links a driver that round-trips every message through Encoder/Decoder
+and decodes the concatenated stream through the C ABI (capi.h) in one call,
+checks that regenerating is a no-op (no file rewritten) and that dropping a
+message deletes its stale outputs. Exit status is non-zero on any failure or
+when a --max-* budget is exceeded, so a small configuration runs under ctest.
+
+Usage:
+  python3 codegen/stress.py --messages 400 --fields 30 --unity
+"""
+
+import argparse
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+import yaml
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+REPO = os.path.dirname(HERE)
+GENERATOR = os.path.join(HERE, 'generate.py')
+
+
+def synthetic_schema(n_messages, n_fields, seed):
+    """BOE-style schema: fixed header, MessageType enum, mixed field types."""
+    rng = random.Random(seed)
+    names = [f"Msg{i:04d}" for i in range(n_messages)]
+    enums = {
+        'MessageType': {name: i + 1 for i, name in enumerate(names)},
+        'Side': {'Buy': 1, 'Sell': 2, 'SellShort': 5},
+        'OrdType': {'Market': 1, 'Limit': 2, 'Stop': 3, 'StopLimit': 4},
+        'Capacity': {'Agency': 0x41, 'Principal': 0x50, 'Riskless': 0x52},
+    }
+    messages = {}
+    for i, name in enumerate(names):
+        fields = [
+            {'name': 'StartOfMessage', 'type': 'u16', 'endian': 'le', 'value': 0xBABA},
+            {'name': 'MessageLength', 'type': 'u16', 'endian': 'le'},
+            {'name': 'MessageType', 'type': 'enum', 'enum_type': 'MessageType'},
+        ]
+        has_presence = i % 4 == 1
+        has_group = i % 5 == 2
+        if has_presence:
+            fields.append({'name': 'PresenceBits', 'type': 'u64', 'endian': 'le', 'purpose': 'presence_map'})
+        optional_bit = 0
+        for j in range(n_fields):
+            kind = rng.randrange(7)
+            f = {'name': f"F{j:03d}"}
+            if kind == 0:
+                f.update(type='u8')
+            elif kind == 1:
+                f.update(type='u16', endian='le')
+            elif kind == 2:
+                f.update(type='u32', endian='le')
+            elif kind == 3:
+                f.update(type='u64', endian='le')
+            elif kind == 4:
+                f.update(type='char', length=rng.choice([1, 4, 8, 20]))
+            elif kind == 5:
+                f.update(type='enum', enum_type=rng.choice(['Side', 'OrdType', 'Capacity']))
+            else:
+                f.update(type='u32', endian='be')
+            if has_presence and kind in (1, 2, 3) and optional_bit < 64:
+                f['optional_bit'] = optional_bit
+                optional_bit += 1
+            fields.append(f)
+        if i % 6 == 3:
+            fields.append({'name': 'Text', 'type': 'vstring', 'max_length': 40})
+            fields.append({'name': 'Payload', 'type': 'bytes', 'length_prefix': 'u16', 'endian': 'le'})
+        msg = {'fields': fields}
+        if has_group:
+            fields.append({'name': 'LegCount', 'type': 'u8'})
+            msg['groups'] = [{
+                'name': 'Legs',
+                'count_field': 'LegCount',
+                'fields': [
+                    {'name': 'LegSide', 'type': 'enum', 'enum_type': 'Side'},
+                    {'name': 'LegQty', 'type': 'u32', 'endian': 'le'},
+                    {'name': 'LegSymbol', 'type': 'char', 'length': 8},
+                    {'name': 'LegText', 'type': 'vstring'},
+                ],
+            }]
+        messages[name] = msg
+    return {'protocol': 'stress_synthetic', 'version': 1, 'enums': enums, 'messages': messages}
+
+
+def count_lines(paths):
+    total = 0
+    for p in paths:
+        with open(p, 'rb') as f:
+            total += f.read().count(b'\n')
+    return total
+
+
+def run_generator(schema_path, out_dir):
+    t0 = time.perf_counter()
+    proc = subprocess.run([sys.executable, GENERATOR, '--schema', schema_path, '--out', out_dir],
+                          capture_output=True, text=True)
+    elapsed = time.perf_counter() - t0
+    if proc.returncode != 0:
+        raise RuntimeError(f"generate.py failed:\n{proc.stderr}")
+    return elapsed, proc.stdout
+
+
+def object_path(obj_dir, src):
+    return os.path.join(obj_dir, os.path.basename(os.path.dirname(src)) + '_' + os.path.basename(src) + '.o')
+
+
+def compile_units(cxx, flags, sources, obj_dir, jobs):
+    """Compile each source in its own process; returns {src: (seconds, max_rss_kb)}."""
+    results = {}
+    pending = list(sources)
+    running = {}
+    while pending or running:
+        while pending and len(running) < jobs:
+            src = pending.pop(0)
+            obj = object_path(obj_dir, src)
+            proc = subprocess.Popen([cxx, *flags, '-c', src, '-o', obj])
+            running[proc.pid] = (src, time.perf_counter())
+        pid, status, usage = os.wait4(-1, 0)
+        if pid not in running:
+            continue
+        src, t0 = running.pop(pid)
+        if os.waitstatus_to_exitcode(status) != 0:
+            raise RuntimeError(f"compile failed: {src}")
+        results[src] = (time.perf_counter() - t0, usage.ru_maxrss)
+    return results
+
+
+def write_driver(path, schema):
+    msgs = list(schema['messages'])
+    lines = [
+        '#include "messages.hpp"',
+        '#include "encoder.hpp"',
+        '#include "decoder.hpp"',
+        '#include "capi.h"',
+        '#include "wire.hpp"',
+        '#include <array>',
+        '#include <cstdio>',
+        '#include <cstring>',
+        '#include <vector>',
+        'using namespace stress::synthetic::v1;',
+        'static std::vector<uint8_t> stream;',
+        'template<class M> static bool roundtrip(M& m) {',
+        '    std::array<uint8_t, 4096> a{}, b{};',
+        '    size_t wa = 0, wb = 0, consumed = 0;',
+        '    if (Encoder::encode(m, a.data(), a.size(), wa) != market::runtime::status::ok) return false;',
+        '    M d{};',
+        '    if (Decoder::decode(a.data(), wa, d, consumed) != market::runtime::status::ok || consumed != wa) return false;',
+        '    if (Encoder::encode(d, b.data(), b.size(), wb) != market::runtime::status::ok) return false;',
+        '    stream.insert(stream.end(), a.begin(), a.begin() + static_cast<long>(wa));',
+        '    return wa == wb && std::memcmp(a.data(), b.data(), wa) == 0;',
+        '}',
+        'int main() {',
+        '    int failed = 0;',
+    ]
+    for name in msgs:
+        lines += [
+            '    {',
+            f'        {name} m{{}};',
+            f'        m.MessageType = MessageType::{name};',
+        ]
+        if any(f.get('purpose') == 'presence_map' for f in schema['messages'][name]['fields']):
+            lines.append('        m.PresenceBits = ~uint64_t{0};')
+        if schema['messages'][name].get('groups'):
+            lines.append('        m.legs.resize(2);')
+            lines.append('        m.legs[1].LegText = "leg";')
+        if any(f['name'] == 'Text' for f in schema['messages'][name]['fields']):
+            lines.append('        m.Text = "variable";')
+            lines.append('        m.Payload = market::runtime::Bytes{reinterpret_cast<const uint8_t*>("\\x01\\x02\\x03"), 3};')
+        lines += [
+            f'        if (!roundtrip(m)) {{ std::printf("roundtrip failed: {name}\\n"); ++failed; }}',
+            '    }',
+        ]
+    # The whole stream through the C ABI in one call (generic probe dispatch,
+    # flattened groups)
+    lines += [
+        '    stress_synthetic_v1_batch out{};',
+    ]
+    for name in msgs:
+        lines += [
+            f'    std::vector<stress_synthetic_v1_{name}> rec_{name}(1);',
+            f'    out.{name} = rec_{name}.data();',
+            f'    out.{name}_capacity = 1;',
+        ]
+        if schema['messages'][name].get('groups'):
+            lines += [
+                f'    std::vector<stress_synthetic_v1_{name}Legs> legs_{name}(2);',
+                f'    out.{name}_legs = legs_{name}.data();',
+                f'    out.{name}_legs_capacity = 2;',
+            ]
+    lines += [
+        f'    std::vector<stress_synthetic_v1_entry> entries({len(msgs)});',
+        '    size_t consumed = 0;',
+        '    const size_t n = stress_synthetic_v1_decode_batch(stream.data(), stream.size(), &out,',
+        '                                                      entries.data(), entries.size(), &consumed);',
+        f'    if (n != {len(msgs)} || consumed != stream.size()) {{',
+        '        std::printf("capi: %zu entries, %zu of %zu bytes\\n", n, consumed, stream.size());',
+        '        ++failed;',
+        '    }',
+        '    for (size_t i = 0; i < n; ++i) {',
+        '        if (entries[i].type != i || entries[i].status != MARKET_STATUS_OK || entries[i].row != 0) {',
+        '            std::printf("capi: bad entry %zu\\n", i);',
+        '            ++failed;',
+        '        }',
+        '    }',
+    ]
+    for name in msgs:
+        lines.append(f'    if (rec_{name}[0].MessageType != static_cast<decltype(rec_{name}[0].MessageType)>(MessageType::{name})) ++failed;')
+        if schema['messages'][name].get('groups'):
+            lines.append(f'    if (rec_{name}[0].legs_count != 2 || rec_{name}[0].legs_first != 0 || out.{name}_legs_count != 2) ++failed;')
+            lines.append(f'    if (legs_{name}[1].LegText_length != 3 || std::memcmp(stream.data() + legs_{name}[1].LegText_offset, "leg", 3) != 0) ++failed;')
+        if any(f['name'] == 'Text' for f in schema['messages'][name]['fields']):
+            lines.append(f'    if (rec_{name}[0].Text_length != 8 || std::memcmp(stream.data() + rec_{name}[0].Text_offset, "variable", 8) != 0 ||')
+            lines.append(f'        rec_{name}[0].Payload_length != 3 || stream[rec_{name}[0].Payload_offset + 2] != 3) ++failed;')
+    lines += ['    return failed ? 1 : 0;', '}']
+    with open(path, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+def main():
+    ap = argparse.ArgumentParser(description='Stress-test code generation and compile time on a synthetic schema')
+    ap.add_argument('--messages', type=int, default=300)
+    ap.add_argument('--fields', type=int, default=25, help='fields per message (besides the header)')
+    ap.add_argument('--seed', type=int, default=1)
+    ap.add_argument('--cxx', default=os.environ.get('CXX', 'c++'))
+    ap.add_argument('--opt', default='-O2')
+    ap.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1)
+    ap.add_argument('--unity', action='store_true', help='also compile all units as one translation unit')
+    ap.add_argument('--out', help='work directory (default: temporary, removed afterwards)')
+    ap.add_argument('--max-gen-seconds', type=float, help='fail if generation takes longer')
+    ap.add_argument('--max-unit-seconds', type=float, help='fail if any translation unit compiles slower')
+    ap.add_argument('--max-unit-rss-mb', type=float, help='fail if any translation unit peaks above this')
+    args = ap.parse_args()
+
+    work = args.out or tempfile.mkdtemp(prefix='mdp_codegen_stress_')
+    os.makedirs(work, exist_ok=True)
+    failures = []
+    try:
+        schema = synthetic_schema(args.messages, args.fields, args.seed)
+        schema_path = os.path.join(work, 'stress_synthetic.yaml')
+        with open(schema_path, 'w') as f:
+            yaml.safe_dump(schema, f, sort_keys=False)
+        gen_dir = os.path.join(work, 'generated')
+        shutil.rmtree(gen_dir, ignore_errors=True)
+
+        gen_s, _ = run_generator(schema_path, gen_dir)
+        units = sorted(os.path.join(gen_dir, 'msg', f) for f in os.listdir(os.path.join(gen_dir, 'msg'))
+                       if f.endswith('.cpp'))
+        json_units = sorted(os.path.join(gen_dir, 'json', f) for f in os.listdir(os.path.join(gen_dir, 'json')))
+        shared = [os.path.join(gen_dir, f) for f in ('fwd.hpp', 'messages.hpp', 'encoder.hpp', 'decoder.hpp')]
+        msg_headers = [u[:-4] + '.hpp' for u in units]
+        n_fields = sum(len(m['fields']) for m in schema['messages'].values())
+        print(f"schema: {args.messages} messages, {n_fields} fields")
+        print(f"generate: {gen_s:.2f}s")
+        print(f"loc: fwd.hpp={count_lines(shared[:1])} shared headers={count_lines(shared)} "
+              f"message headers={count_lines(msg_headers)} codec units={count_lines(units)} "
+              f"json units={count_lines(json_units)}")
+        if args.max_gen_seconds and gen_s > args.max_gen_seconds:
+            failures.append(f"generation took {gen_s:.2f}s > {args.max_gen_seconds}s")
+
+        flags = ['-std=c++20', args.opt, f'-I{REPO}', f'-I{gen_dir}']
+        obj_dir = os.path.join(work, 'obj')
+        os.makedirs(obj_dir, exist_ok=True)
+        t0 = time.perf_counter()
+        res = compile_units(args.cxx, flags, units, obj_dir, args.jobs)
+        wall = time.perf_counter() - t0
+        secs = [r[0] for r in res.values()]
+        rss = [r[1] / 1024.0 for r in res.values()]
+        slowest = max(res, key=lambda k: res[k][0])
+        print(f"compile ({len(units)} units, -j{args.jobs}): wall={wall:.2f}s sum={sum(secs):.2f}s "
+              f"max={max(secs):.2f}s ({os.path.basename(slowest)}) peak_rss={max(rss):.0f}MB")
+        if args.max_unit_seconds and max(secs) > args.max_unit_seconds:
+            failures.append(f"slowest unit {max(secs):.2f}s > {args.max_unit_seconds}s")
+        if args.max_unit_rss_mb and max(rss) > args.max_unit_rss_mb:
+            failures.append(f"unit peak RSS {max(rss):.0f}MB > {args.max_unit_rss_mb}MB")
+
+        if args.unity:
+            unity = os.path.join(work, 'unity.cpp')
+            with open(unity, 'w') as f:
+                f.writelines(f'#include "{u}"\n' for u in units)
+            ur = compile_units(args.cxx, flags, [unity], obj_dir, 1)[unity]
+            print(f"compile (single unit): {ur[0]:.2f}s peak_rss={ur[1] / 1024.0:.0f}MB")
+
+        driver = os.path.join(work, 'driver.cpp')
+        write_driver(driver, schema)
+        exe = os.path.join(work, 'driver')
+        objs = [object_path(obj_dir, u) for u in units]
+        t0 = time.perf_counter()
+        capi = os.path.join(gen_dir, 'capi.cpp')
+        subprocess.run([args.cxx, *flags, driver, capi, *objs, '-o', exe], check=True)
+        print(f"driver: built in {time.perf_counter() - t0:.2f}s")
+        if subprocess.run([exe]).returncode != 0:
+            failures.append("round-trip driver failed")
+        else:
+            print(f"roundtrip: {args.messages} messages ok")
+
+        # Regenerating unchanged input must not rewrite anything
+        before = {p: os.stat(p).st_mtime_ns for p in units + shared}
+        _, out = run_generator(schema_path, gen_dir)
+        if '(0 updated' not in out or any(os.stat(p).st_mtime_ns != t for p, t in before.items()):
+            failures.append(f"regeneration rewrote unchanged files: {out.strip()}")
+
+        # Dropping a message removes its stale outputs
+        dropped = next(iter(schema['messages']))
+        del schema['messages'][dropped]
+        del schema['enums']['MessageType'][dropped]
+        with open(schema_path, 'w') as f:
+            yaml.safe_dump(schema, f, sort_keys=False)
+        run_generator(schema_path, gen_dir)
+        if os.path.exists(os.path.join(gen_dir, 'msg', f'{dropped}.cpp')):
+            failures.append(f"stale output for removed message {dropped} was kept")
+    except (RuntimeError, subprocess.CalledProcessError) as e:
+        failures.append(str(e))
+    finally:
+        if not args.out:
+            shutil.rmtree(work, ignore_errors=True)
+
+    for f in failures:
+        print(f"FAIL: {f}", file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
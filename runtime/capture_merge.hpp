@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "runtime/context.hpp"
+#include "runtime/pcap.hpp"
+#include "runtime/status.hpp"
+
+namespace market::runtime {
+
+// K-way merge of several capture files into one stream in global timestamp
+// order, e.g. the A and B lines of a feed or several venues for cross-venue
+// research. Each input keeps its own mmap'd cursor; a loser tree selects the
+// next packet with ceil(log2 k) comparisons and no data movement. Packets with
+// equal timestamps come out in source order, so the merge is deterministic.
+//
+//   capture_merge m;
+//   m.add("itch_a.pcap", /*tag=*/0, 42);
+//   m.add("itch_b.pcap", /*tag=*/1, 42);
+//   m.for_each([&](Bytes payload, const msg_context& ctx) {
+//       size_t off = 0, consumed = 0;
+//       while (off < payload.size() &&
+//              nasdaq::itch::v5::dispatch_itch(payload.subspan(off), h, consumed, ctx) == status::ok)
+//           off += consumed;
+//   });
+class capture_merge {
+public:
+    struct packet {
+        pcap_packet pkt;
+        uint32_t tag{0};      // caller-supplied source tag (feed/line/venue id)
+        size_t source{0};     // index in add() order
+        uint64_t index{0};    // packet number within its source, from 1
+    };
+
+    // Add an input before the first next(). `tag` is reported with each packet
+    // (and as msg_context::feed); `payload_offset` strips link/network headers.
+    status add(const std::string& path, uint32_t tag, size_t payload_offset = 0) {
+        source s;
+        const status st = s.reader.open(path, payload_offset);
+        if (st != status::ok) return st;
+        s.tag = tag;
+        sources_.push_back(std::move(s));
+        built_ = false;
+        return status::ok;
+    }
+
+    size_t sources() const noexcept { return sources_.size(); }
+
+    // Next packet in global timestamp order; false once every input is exhausted.
+    bool next(packet& out) noexcept {
+        if (MARKET_UNLIKELY(!built_)) build();
+        if (winner_ >= sources_.size() || !sources_[winner_].live) return false;
+        source& s = sources_[winner_];
+        out.pkt = s.head;
+        out.tag = s.tag;
+        out.source = winner_;
+        out.index = ++s.count;
+        advance(s);
+        replay(winner_);
+        return true;
+    }
+
+    // Calls f(Bytes payload, const msg_context& ctx) for every packet in order.
+    // ctx carries capture_ns, feed (= tag) and packet_seq (= index in source).
+    template<typename F>
+    size_t for_each(F&& f) {
+        packet p;
+        msg_context ctx;
+        size_t n = 0;
+        while (next(p)) {
+            ctx.capture_ns = p.pkt.ts_ns;
+            ctx.recv_ns = p.pkt.ts_ns;
+            ctx.feed = p.tag;
+            ctx.packet_seq = p.index;
+            ctx.offset = 0;
+            f(p.pkt.data, ctx);
+            ++n;
+        }
+        return n;
+    }
+
+private:
+    struct source {
+        pcap_reader reader;
+        pcap_packet head;
+        uint32_t tag{0};
+        uint64_t count{0};
+        bool live{false};
+    };
+
+    static void advance(source& s) noexcept { s.live = s.reader.next(s.head); }
+
+    // Strict order on (timestamp, source index); exhausted and padding leaves lose.
+    bool before(size_t a, size_t b) const noexcept {
+        const bool la = a < sources_.size() && sources_[a].live;
+        const bool lb = b < sources_.size() && sources_[b].live;
+        if (la != lb) return la;
+        if (!la) return a < b;
+        const uint64_t ta = sources_[a].head.ts_ns;
+        const uint64_t tb = sources_[b].head.ts_ns;
+        return ta != tb ? ta < tb : a < b;
+    }
+
+    void build() {
+        for (source& s : sources_) advance(s);
+        leaves_ = 1;
+        while (leaves_ < sources_.size()) leaves_ <<= 1;
+        losers_.assign(leaves_, 0);
+        // Play the initial tournament bottom-up; winners_[n] is the winner of subtree n.
+        std::vector<size_t> winners(2 * leaves_);
+        for (size_t i = 0; i < leaves_; ++i) winners[leaves_ + i] = i;
+        for (size_t n = leaves_ - 1; n >= 1; --n) {
+            const size_t a = winners[2 * n];
+            const size_t b = winners[2 * n + 1];
+            winners[n] = before(a, b) ? a : b;
+            losers_[n] = before(a, b) ? b : a;
+        }
+        winner_ = leaves_ > 1 ? winners[1] : 0;
+        built_ = true;
+    }
+
+    // Re-run the matches on the path from leaf `w` to the root.
+    void replay(size_t w) noexcept {
+        for (size_t n = (w + leaves_) >> 1; n >= 1; n >>= 1) {
+            if (before(losers_[n], w)) {
+                const size_t t = losers_[n];
+                losers_[n] = w;
+                w = t;
+            }
+        }
+        winner_ = w;
+    }
+
+    std::vector<source> sources_;
+    std::vector<size_t> losers_;
+    size_t leaves_{1};
+    size_t winner_{0};
+    bool built_{false};
+};
+
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+// Buffered writer for many pcap outputs at once: the back end of splitting a
+// capture into one file per symbol or per symbol bucket (tools/mdp_split).
+//
+// Each output is a nanosecond pcap with one record per routed message, so the
+// split files read back with pcap_reader / capture_merge (payload offset 0)
+// and pcap_decode. Records are appended to the output's buffer, which grows on
+// demand up to split_config::buffer_bytes and is written out in one write()
+// when the next record would not fit; outputs that see little traffic never
+// allocate the full buffer. At most max_open descriptors are held: when
+// another is needed the least recently flushed output is closed and later
+// reopened for append. Files are created (and truncated) on first flush, so
+// outputs that never receive a record leave nothing on disk.
+//
+// A writer is single-threaded. To split in parallel give each thread its own
+// writer over a disjoint set of outputs.
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "runtime/bytes.hpp"
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/status.hpp"
+
+namespace market::runtime {
+
+struct split_config {
+    size_t buffer_bytes = 1 << 20;  // per output, the most written in one call
+    size_t max_open = 64;           // descriptors held at once (at least 1)
+    uint32_t snaplen = 65535;
+    uint32_t linktype = 147;        // LINKTYPE_USER0: records are bare feed messages
+};
+
+struct split_stats {
+    uint64_t records = 0;
+    uint64_t bytes = 0;      // written to disk, headers included
+    uint64_t writes = 0;     // write() calls
+    uint64_t opens = 0;      // files created or reopened
+    uint64_t evictions = 0;  // descriptors closed to stay within max_open
+};
+
+class split_writer {
+public:
+    static constexpr size_t kFileHeader = 24;
+    static constexpr size_t kRecordHeader = 16;
+
+    explicit split_writer(split_config cfg = {}) : cfg_(cfg) {
+        if (cfg_.max_open == 0) cfg_.max_open = 1;
+        if (cfg_.buffer_bytes < kFileHeader + kRecordHeader) cfg_.buffer_bytes = kFileHeader + kRecordHeader;
+    }
+    split_writer(const split_writer&) = delete;
+    split_writer& operator=(const split_writer&) = delete;
+    ~split_writer() { (void)close(); }
+
+    // Register an output file; returns its index (0, 1, 2, ... in add order).
+    uint32_t add(std::string path) {
+        output o;
+        o.path = std::move(path);
+        outputs_.push_back(std::move(o));
+        return static_cast<uint32_t>(outputs_.size() - 1);
+    }
+
+    size_t outputs() const noexcept { return outputs_.size(); }
+    const std::string& path(uint32_t out) const noexcept { return outputs_[out].path; }
+    size_t open_files() const noexcept { return open_.size(); }
+    const split_stats& stats() const noexcept { return stats_; }
+    // errno of the first failed open or write, 0 if none.
+    int error() const noexcept { return errno_; }
+
+    // Append one record. `orig_len` 0 means the payload is the whole message.
+    status write(uint32_t out, uint64_t ts_ns, Bytes payload, uint32_t orig_len = 0) {
+        if (MARKET_UNLIKELY(out >= outputs_.size())) return status::bad_value;
+        output& o = outputs_[out];
+        const size_t need = kRecordHeader + payload.size();
+        if (o.buf.size() + need > cfg_.buffer_bytes) {
+            const status st = flush(out);
+            if (st != status::ok) return st;
+        }
+        if (MARKET_UNLIKELY(!o.created && o.buf.empty())) append_file_header(o);
+        uint8_t h[kRecordHeader];
+        const uint32_t incl = static_cast<uint32_t>(payload.size());
+        store_le<uint32_t>(h, static_cast<uint32_t>(ts_ns / 1'000'000'000ULL));
+        store_le<uint32_t>(h + 4, static_cast<uint32_t>(ts_ns % 1'000'000'000ULL));
+        store_le<uint32_t>(h + 8, incl);
+        store_le<uint32_t>(h + 12, orig_len ? orig_len : incl);
+        if (MARKET_UNLIKELY(o.buf.size() + need > cfg_.buffer_bytes)) {
+            // Larger than a whole buffer: header and payload go straight out
+            o.buf.insert(o.buf.end(), h, h + kRecordHeader);
+            status st = flush(out);
+            if (st == status::ok) st = write_out(o, payload.data(), payload.size());
+            if (st == status::ok) ++stats_.records;
+            return st;
+        }
+        if (o.buf.capacity() < o.buf.size() + need) grow(o, need);
+        o.buf.insert(o.buf.end(), h, h + kRecordHeader);
+        o.buf.insert(o.buf.end(), payload.begin(), payload.end());
+        ++stats_.records;
+        return status::ok;
+    }
+
+    // Write out one output's buffered records.
+    status flush(uint32_t out) {
+        if (MARKET_UNLIKELY(out >= outputs_.size())) return status::bad_value;
+        output& o = outputs_[out];
+        if (o.buf.empty()) return status::ok;
+        const status st = write_out(o, o.buf.data(), o.buf.size());
+        o.buf.clear();
+        return st;
+    }
+
+    // Flush every output, close every descriptor and release the buffers.
+    // Reports the first error seen since construction.
+    status close() {
+        for (uint32_t i = 0; i < outputs_.size(); ++i) (void)flush(i);
+        for (uint32_t i : open_) {
+            ::close(outputs_[i].fd);
+            outputs_[i].fd = -1;
+        }
+        open_.clear();
+        for (output& o : outputs_) std::vector<uint8_t>().swap(o.buf);
+        return errno_ ? status::bad_value : status::ok;
+    }
+
+private:
+    struct output {
+        std::string path;
+        std::vector<uint8_t> buf;
+        int fd = -1;
+        uint64_t used = 0;     // flush tick, for least-recently-used eviction
+        bool created = false;  // file exists (truncated on creation)
+    };
+
+    void append_file_header(output& o) {
+        uint8_t g[kFileHeader];
+        store_le<uint32_t>(g, 0xa1b23c4d);  // nanosecond timestamps
+        store_le<uint16_t>(g + 4, 2);
+        store_le<uint16_t>(g + 6, 4);
+        store_le<uint32_t>(g + 8, 0);
+        store_le<uint32_t>(g + 12, 0);
+        store_le<uint32_t>(g + 16, cfg_.snaplen);
+        store_le<uint32_t>(g + 20, cfg_.linktype);
+        grow(o, kFileHeader);
+        o.buf.insert(o.buf.end(), g, g + kFileHeader);
+    }
+
+    // Double the buffer (64 KiB first) up to the configured size.
+    void grow(output& o, size_t need) {
+        size_t cap = o.buf.capacity() ? o.buf.capacity() * 2 : size_t{64} << 10;
+        while (cap < o.buf.size() + need) cap *= 2;
+        o.buf.reserve(cap < cfg_.buffer_bytes ? cap : cfg_.buffer_bytes);
+    }
+
+    status ensure_open(output& o, uint32_t index) {
+        if (o.fd >= 0) return status::ok;
+        if (open_.size() >= cfg_.max_open) evict();
+        const int flags = O_WRONLY | O_CREAT | (o.created ? O_APPEND : O_TRUNC);
+        o.fd = ::open(o.path.c_str(), flags, 0644);
+        if (o.fd < 0) {
+            if (!errno_) errno_ = errno;
+            return status::bad_value;
+        }
+        o.created = true;
+        open_.push_back(index);
+        ++stats_.opens;
+        return status::ok;
+    }
+
+    void evict() {
+        size_t victim = 0;
+        for (size_t i = 1; i < open_.size(); ++i) {
+            if (outputs_[open_[i]].used < outputs_[open_[victim]].used) victim = i;
+        }
+        output& o = outputs_[open_[victim]];
+        ::close(o.fd);
+        o.fd = -1;
+        open_[victim] = open_.back();
+        open_.pop_back();
+        ++stats_.evictions;
+    }
+
+    status write_out(output& o, const uint8_t* p, size_t n) {
+        const status st = ensure_open(o, static_cast<uint32_t>(&o - outputs_.data()));
+        if (st != status::ok) return st;
+        o.used = ++tick_;
+        while (n > 0) {
+            const ssize_t w = ::write(o.fd, p, n);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                if (!errno_) errno_ = errno;
+                return status::bad_value;
+            }
+            p += w;
+            n -= static_cast<size_t>(w);
+            stats_.bytes += static_cast<uint64_t>(w);
+            ++stats_.writes;
+        }
+        return status::ok;
+    }
+
+    split_config cfg_;
+    std::vector<output> outputs_;
+    std::vector<uint32_t> open_;  // outputs holding a descriptor
+    split_stats stats_;
+    uint64_t tick_ = 0;
+    int errno_ = 0;
+};
+
+}  // namespace market::runtime
+
+#endif
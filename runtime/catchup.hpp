@@ -0,0 +1,158 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "runtime/bytes.hpp"
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/status.hpp"
+
+namespace market::runtime {
+
+// Catch-up mode: a consumer that starts late or falls behind drains its backlog
+// through batch paths (framing, decode and handling in runs, with prefetching
+// and per-batch rather than per-message instrumentation), then returns to the
+// per-message latency path once it is caught up.
+
+enum class feed_mode : uint8_t { live, catch_up };
+
+struct catchup_thresholds {
+    size_t enter_depth = 1024;             // queued packets/messages that start catch-up
+    size_t exit_depth = 16;                // ... and that end it
+    uint64_t enter_lag_ns = 1'000'000;     // message age (wall clock - feed time) that starts catch-up
+    uint64_t exit_lag_ns = 50'000;         // ... and that ends it
+};
+
+// Decides the mode from queue depth and/or timestamp lag, with hysteresis so the
+// consumer does not flap between paths around a single threshold. Either signal
+// can be left at 0 if the caller does not have it.
+class backlog_detector {
+public:
+    backlog_detector() = default;
+    explicit backlog_detector(const catchup_thresholds& t) noexcept : t_(t) {}
+
+    feed_mode update(size_t depth, uint64_t lag_ns) noexcept {
+        if (mode_ == feed_mode::live) {
+            if (depth >= t_.enter_depth || lag_ns >= t_.enter_lag_ns) {
+                mode_ = feed_mode::catch_up;
+                ++transitions_;
+            }
+        } else if (depth <= t_.exit_depth && lag_ns <= t_.exit_lag_ns) {
+            mode_ = feed_mode::live;
+            ++transitions_;
+        }
+        return mode_;
+    }
+
+    feed_mode mode() const noexcept { return mode_; }
+    bool catching_up() const noexcept { return mode_ == feed_mode::catch_up; }
+    uint64_t transitions() const noexcept { return transitions_; }
+
+private:
+    catchup_thresholds t_{};
+    feed_mode mode_{feed_mode::live};
+    uint64_t transitions_{0};
+};
+
+namespace detail {
+    inline bool& catchup_flag() noexcept {
+        static thread_local bool flag = false;
+        return flag;
+    }
+}
+
+// True while the current thread is inside a batch (catch-up) dispatch. Handlers
+// use it to relax per-message work such as timestamping or publishing every
+// intermediate state, and do it once in on_batch_end() instead.
+inline bool catching_up() noexcept { return detail::catchup_flag(); }
+
+class catchup_scope {
+public:
+    catchup_scope() noexcept : prev_(detail::catchup_flag()) { detail::catchup_flag() = true; }
+    ~catchup_scope() { detail::catchup_flag() = prev_; }
+    catchup_scope(const catchup_scope&) = delete;
+    catchup_scope& operator=(const catchup_scope&) = delete;
+
+private:
+    bool prev_;
+};
+
+// Handlers may implement on_batch_end() to flush work deferred during a batch.
+template<typename H>
+concept has_batch_end = requires(H& h) { h.on_batch_end(); };
+
+template<typename H>
+MARKET_ALWAYS_INLINE void end_batch(H& h) {
+    if constexpr (has_batch_end<H>) {
+        h.on_batch_end();
+    }
+}
+
+// Distance ahead of the decode cursor to prefetch.
+inline constexpr size_t kCatchupPrefetch = 256;
+
+// Dispatch a run of back-to-back messages (sizes determined by the dispatcher).
+// `dispatch(Bytes, size_t& consumed)` is typically a generated dispatcher bound
+// to a handler. Stops at the first non-ok status or when `in` is exhausted;
+// `consumed` covers every fully dispatched message.
+template<typename Dispatch>
+status dispatch_run(Bytes in, Dispatch&& dispatch, size_t& consumed, size_t& messages) {
+    const uint8_t* p = in.data();
+    const size_t n = in.size();
+    size_t off = 0;
+    messages = 0;
+    while (off < n) {
+        if (off + kCatchupPrefetch < n) {
+            MARKET_PREFETCH(p + off + kCatchupPrefetch);
+        }
+        size_t c = 0;
+        const status st = dispatch(Bytes{p + off, n - off}, c);
+        if (MARKET_UNLIKELY(st != status::ok || c == 0)) {
+            consumed = off;
+            return st == status::ok ? status::bad_value : st;
+        }
+        off += c;
+        ++messages;
+    }
+    consumed = off;
+    return status::ok;
+}
+
+// Dispatch `count` messages each prefixed by a big-endian u16 length
+// (MoldUDP64-style block). Lengths are read ahead so the framing loop does not
+// wait on the dispatcher.
+template<typename Dispatch>
+status dispatch_framed(Bytes in, size_t count, Dispatch&& dispatch, size_t& consumed, size_t& messages) {
+    const uint8_t* p = in.data();
+    const size_t n = in.size();
+    size_t off = 0;
+    messages = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (MARKET_UNLIKELY(off + 2 > n)) {
+            consumed = off;
+            return status::short_buffer;
+        }
+        const size_t len = load_be<uint16_t>(p + off);
+        if (MARKET_UNLIKELY(off + 2 + len > n)) {
+            consumed = off;
+            return status::short_buffer;
+        }
+        if (off + 2 + len + kCatchupPrefetch < n) {
+            MARKET_PREFETCH(p + off + 2 + len + kCatchupPrefetch);
+        }
+        size_t c = 0;
+        const status st = dispatch(Bytes{p + off + 2, len}, c);
+        if (MARKET_UNLIKELY(st != status::ok)) {
+            consumed = off;
+            return st;
+        }
+        off += 2 + len;
+        ++messages;
+    }
+    consumed = off;
+    return status::ok;
+}
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/framing.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MARKET_COLUMNAR_SSE2 1
+#endif
+
+namespace market::runtime {
+
+// Columnar (struct-of-arrays) batch encoding. Generated encode_columns()
+// writes N back-to-back fixed-size messages from one array per field: each
+// column is converted to wire byte order a tile at a time (contiguous loads,
+// vector byte swaps), then the tiles are stored into the messages at their
+// fixed offsets. On x86-64 the swaps use SSE2 directly, since compilers do not
+// vectorise bswap below SSSE3; elsewhere the scalar loop is left to the
+// auto-vectoriser. Framing options are in runtime/framing.hpp.
+
+namespace columnar {
+
+// Messages converted per pass: tiles of every column stay in L1 while the
+// messages are assembled.
+inline constexpr size_t kTile = 32;
+
+namespace detail {
+
+#if MARKET_COLUMNAR_SSE2
+// Reverse the bytes of each W-byte lane: swap the bytes of every 16-bit word,
+// then reorder the words within each lane.
+template<size_t W>
+MARKET_ALWAYS_INLINE __m128i bswap_lanes(__m128i v) noexcept {
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+    if constexpr (W == 4) {
+        v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+    } else if constexpr (W == 8) {
+        v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+    }
+    return v;
+}
+#endif
+
+}  // namespace detail
+
+// Convert n values of column `src` to the wire representation U (unsigned, the
+// field's width) in byte order E. A null column repeats `fallback` (host order).
+template<std::endian E, class U, class T>
+MARKET_ALWAYS_INLINE void to_wire(const T* src, U* dst, size_t n, U fallback) noexcept {
+    static_assert(std::is_unsigned_v<U> && sizeof(U) == sizeof(T), "column type does not match the wire width");
+    if (src == nullptr) {
+        if constexpr (sizeof(U) > 1 && E != std::endian::native) {
+            fallback = runtime::detail::byteswap(fallback);
+        }
+        for (size_t i = 0; i < n; ++i) dst[i] = fallback;
+        return;
+    }
+    size_t i = 0;
+#if MARKET_COLUMNAR_SSE2
+    if constexpr (sizeof(U) > 1 && E != std::endian::native) {
+        constexpr size_t kLanes = 16 / sizeof(U);
+        for (; i + kLanes <= n; i += kLanes) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), detail::bswap_lanes<sizeof(U)>(v));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        U v = static_cast<U>(src[i]);
+        if constexpr (sizeof(U) > 1 && E != std::endian::native) {
+            v = runtime::detail::byteswap(v);
+        }
+        dst[i] = v;
+    }
+}
+
+}  // namespace columnar
+
+}  // namespace market::runtime
@@ -54,6 +54,27 @@
 #define EXCHCG_ALWAYS_INLINE MARKET_ALWAYS_INLINE
 #endif
 
+// Spin-wait hint for busy-polling loops (seqlock readers, ring consumers)
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define MARKET_CPU_RELAX() _mm_pause()
+    #else
+        #define MARKET_CPU_RELAX() __builtin_ia32_pause()
+    #endif
+#elif defined(__aarch64__)
+    #define MARKET_CPU_RELAX() asm volatile("yield" ::: "memory")
+#else
+    #define MARKET_CPU_RELAX() ((void)0)
+#endif
+
+// Read prefetch hint for streaming over buffered input (catch-up/batch paths)
+#if defined(__GNUC__) || defined(__clang__)
+    #define MARKET_PREFETCH(p) __builtin_prefetch((p), 0, 3)
+#else
+    #define MARKET_PREFETCH(p) ((void)(p))
+#endif
+
 // Exception handling control (defined by CMake option)
 #ifndef MARKET_NO_EXCEPTIONS
 // MARKET_NO_EXCEPTIONS not defined - exceptions are enabled
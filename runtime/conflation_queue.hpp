@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "runtime/config.hpp"
+#include "runtime/seqlock.hpp"
+
+namespace market::runtime {
+
+// Single-producer/single-consumer conflating queue keyed by dense symbol id.
+//
+// Each symbol owns one slot holding its latest state (e.g. top_of_book or last
+// trade) behind a seqlock, plus a dirty flag. push() overwrites the slot and, if
+// the symbol was not already pending, appends its id to a ring of dirty ids.
+// A consumer that falls behind therefore sees at most one pending entry per
+// symbol, always the newest, and memory is bounded by the symbol count: the id
+// ring can never overflow because an id is in it at most once.
+//
+// Producer cost is O(1) and independent of the consumer: one seqlock store, one
+// exchange on the dirty flag, and at most one ring append. The producer never
+// blocks and never drops the latest state.
+template<typename T>
+class conflation_queue {
+public:
+    explicit conflation_queue(size_t symbols)
+        : slots_(std::make_unique<slot[]>(symbols)), size_(symbols) {
+        size_t cap = 1;
+        while (cap < symbols) cap <<= 1;
+        ids_ = std::make_unique<uint32_t[]>(cap);
+        mask_ = cap - 1;
+    }
+
+    size_t size() const noexcept { return size_; }
+
+    // Producer side. Publishes the newest state for `symbol_id`.
+    void push(uint32_t symbol_id, const T& value) noexcept {
+        slot& s = slots_[symbol_id];
+        s.value.store(value);
+        // acq_rel on both sides orders the value store against the consumer's
+        // clear: either we see the clear and re-enqueue, or the consumer's clear
+        // synchronises with us and it reads this value.
+        if (s.dirty.exchange(1, std::memory_order_acq_rel) == 0) {
+            const uint64_t t = tail_.load(std::memory_order_relaxed);
+            ids_[t & mask_] = symbol_id;
+            tail_.store(t + 1, std::memory_order_release);
+        } else {
+            conflated_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Consumer side. Pops the oldest pending symbol with its newest state.
+    bool pop(uint32_t& symbol_id, T& out) noexcept {
+        uint64_t h = head_.load(std::memory_order_relaxed);
+        while (h != tail_.load(std::memory_order_acquire)) {
+            const uint32_t id = ids_[h & mask_];
+            head_.store(++h, std::memory_order_release);
+            slot& s = slots_[id];
+            s.dirty.exchange(0, std::memory_order_acq_rel);
+            uint64_t version;
+            out = s.value.load(version);
+            // A push that lands between our clear and its own exchange re-enqueues
+            // a state we may already have read here; skip it rather than deliver twice.
+            if (version != s.delivered) {
+                s.delivered = version;
+                symbol_id = id;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Consumer side. Calls f(symbol_id, const T&) for up to `max` pending symbols.
+    template<typename F>
+    size_t drain(F&& f, size_t max = static_cast<size_t>(-1)) {
+        size_t n = 0;
+        uint32_t id;
+        T value;
+        while (n < max && pop(id, value)) {
+            f(id, value);
+            ++n;
+        }
+        return n;
+    }
+
+    // Symbols currently pending (approximate while the producer is running).
+    size_t pending() const noexcept {
+        return static_cast<size_t>(tail_.load(std::memory_order_acquire) -
+                                   head_.load(std::memory_order_acquire));
+    }
+
+    // Updates that replaced a not-yet-consumed entry instead of queueing.
+    uint64_t conflated() const noexcept { return conflated_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) slot {
+        seqlock<T> value;
+        std::atomic<uint32_t> dirty{0};
+        uint64_t delivered{0};  // consumer-only: version last handed out
+    };
+
+    std::unique_ptr<slot[]> slots_;
+    std::unique_ptr<uint32_t[]> ids_;
+    size_t size_;
+    uint64_t mask_{0};
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    std::atomic<uint64_t> conflated_{0};
+    alignas(64) std::atomic<uint64_t> head_{0};
+};
+
+}
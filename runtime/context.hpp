@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+namespace market::runtime {
+
+// Per-message receive metadata passed alongside a decoded message to handlers
+// that accept it (`on(const Msg&, const msg_context&)`). Timestamps are in
+// nanoseconds; which clock they come from (wall, TSC, NIC) is up to the caller.
+struct msg_context {
+    uint64_t recv_ns{0};     // when the packet was read by this process
+    uint64_t capture_ns{0};  // capture/hardware timestamp (pcap, NIC), 0 if unknown
+    uint64_t packet_seq{0};  // transport sequence number of the enclosing packet
+    uint32_t feed{0};        // source feed / line id (e.g. A vs B side)
+    uint32_t offset{0};      // byte offset of the message within its packet
+};
+
+// Stand-in used by dispatchers when the caller supplies no context. It is empty
+// and every use of it is resolved at compile time, so it costs nothing.
+struct no_context {};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <concepts>
+
+#include "runtime/config.hpp"
+#include "runtime/context.hpp"
+
+namespace market::runtime {
+
+// True when handler H has an on() overload accepting message M.
+template<typename H, typename M>
+concept handles = requires(H& h, const M& msg) { h.on(msg); };
+
+// True when handler H wants receive metadata with message M.
+template<typename H, typename M>
+concept handles_with_context = requires(H& h, const M& msg, const msg_context& ctx) { h.on(msg, ctx); };
+
+// Deliver a decoded message to a handler if it handles that type; otherwise a
+// no-op. Generated dispatchers route every message through this, so handlers
+// only need on() overloads for the messages they care about. A handler that only
+// has on(msg, ctx) receives an empty context.
+template<typename H, typename M>
+MARKET_ALWAYS_INLINE void deliver(H& h, const M& msg) {
+    if constexpr (handles<H, M>) {
+        h.on(msg);
+    } else if constexpr (handles_with_context<H, M>) {
+        h.on(msg, msg_context{});
+    }
+}
+
+// As above, with receive metadata: on(msg, ctx) is preferred when the handler
+// has it, otherwise on(msg) is called and the context is dropped.
+template<typename H, typename M>
+MARKET_ALWAYS_INLINE void deliver(H& h, const M& msg, const msg_context& ctx) {
+    if constexpr (handles_with_context<H, M>) {
+        h.on(msg, ctx);
+    } else if constexpr (handles<H, M>) {
+        h.on(msg);
+    }
+}
+
+template<typename H, typename M>
+MARKET_ALWAYS_INLINE void deliver(H& h, const M& msg, no_context) {
+    deliver(h, msg);
+}
+
+}
@@ -0,0 +1,496 @@
+#pragma once
+
+// Constexpr C++ schema DSL: a header-only alternative to codegen/generate.py.
+//
+// A layout is a type listing member pointers of a plain struct in wire order,
+// each tagged with its role. Everything a generated codec knows (sizes,
+// endianness, constants, presence bits, group counts) is a template argument, so
+// encode/decode are fully specialised at compile time with the same wire
+// semantics as the generated code:
+//
+//   struct AddOrder {
+//       char Type; uint32_t Timestamp; uint64_t OrderId; char Side;
+//       uint32_t Shares; std::array<char, 8> Symbol; uint32_t Price;
+//   };
+//
+//   namespace dsl = market::runtime::dsl;
+//   using AddOrderLayout = dsl::message<AddOrder,
+//       dsl::constant<&AddOrder::Type, 'A'>,
+//       dsl::field<&AddOrder::Timestamp>,                 // big-endian default
+//       dsl::field<&AddOrder::OrderId>,
+//       dsl::field<&AddOrder::Side>,
+//       dsl::field<&AddOrder::Shares>,
+//       dsl::field<&AddOrder::Symbol>,
+//       dsl::field<&AddOrder::Price>>;
+//
+//   AddOrderLayout::encode(msg, buf, sizeof(buf), written);
+//   AddOrderLayout::decode(buf, n, out, consumed);
+//
+// Roles (E is std::endian, big unless given; it only matters for 2/4/8-byte
+// integers and enums):
+//   field<&M::x, E>            plain value
+//   constant<&M::x, V, E>      encoder writes V, decoder rejects others (bad_value)
+//   message_type<&M::x, V, E>  discriminator; checked after the fields (unknown_type)
+//   length<&M::x, E>           encoder writes the total size, decoder checks it (bad_value)
+//   presence<&M::x, E>         presence map for optional fields
+//   optional<&M::x, Bit, E>    on the wire only when presence bit Bit is set
+//   group<&M::vec, &M::count, Fields...>
+//                              repeating group of vec's element type; the count
+//                              member is encoded from vec.size() at its own
+//                              position, the entries after all fields. Group
+//                              fields may be field/constant/optional, the
+//                              latter keyed on the message's presence map.
+//
+// Members may be unsigned integers, enums over them, char or std::array<char, N>.
+// Layout mistakes (member of another struct, optional bit without a presence
+// map, groups before fields, ...) are compile errors.
+//
+// To plug a DSL message into code written against the generated Encoder/Decoder,
+// define encode_message/decode_message for it in the struct's namespace and
+// forward to the layout.
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "runtime/bytes.hpp"
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/status.hpp"
+
+namespace market::runtime::dsl {
+
+enum class role : uint8_t {
+    plain,
+    constant,
+    message_type,
+    length,
+    presence,
+    optional,
+    group,
+};
+
+namespace detail {
+
+    template<auto Member>
+    struct member_traits;
+
+    template<typename C, typename T, T C::*Member>
+    struct member_traits<Member> {
+        using owner = C;
+        using type = T;
+    };
+
+    template<typename T>
+    struct wire_traits {
+        static_assert(std::is_integral_v<T> || std::is_enum_v<T>,
+                      "dsl: member must be an unsigned integer, enum, char or std::array<char, N>");
+    };
+
+    template<typename T>
+        requires (std::is_unsigned_v<T> && !std::is_same_v<T, bool>) || std::is_same_v<T, char>
+    struct wire_traits<T> {
+        static constexpr size_t size = sizeof(T);
+        static constexpr bool integral = true;
+        using uint = std::conditional_t<sizeof(T) == 1, uint8_t,
+                     std::conditional_t<sizeof(T) == 2, uint16_t,
+                     std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+    };
+
+    template<typename T>
+        requires std::is_enum_v<T>
+    struct wire_traits<T> : wire_traits<std::make_unsigned_t<std::underlying_type_t<T>>> {};
+
+    template<size_t N>
+    struct wire_traits<std::array<char, N>> {
+        static constexpr size_t size = N;
+        static constexpr bool integral = false;
+    };
+
+    template<typename T, std::endian E>
+    MARKET_ALWAYS_INLINE void put(uint8_t* p, const T& v) noexcept {
+        using W = wire_traits<T>;
+        if constexpr (!W::integral) {
+            std::memcpy(p, v.data(), W::size);
+        } else if constexpr (W::size == 1) {
+            p[0] = static_cast<uint8_t>(v);
+        } else if constexpr (E == std::endian::little) {
+            store_le<typename W::uint>(p, static_cast<typename W::uint>(v));
+        } else {
+            store_be<typename W::uint>(p, static_cast<typename W::uint>(v));
+        }
+    }
+
+    template<typename T, std::endian E>
+    MARKET_ALWAYS_INLINE void get(const uint8_t* p, T& v) noexcept {
+        using W = wire_traits<T>;
+        if constexpr (!W::integral) {
+            std::memcpy(v.data(), p, W::size);
+        } else if constexpr (W::size == 1) {
+            v = static_cast<T>(p[0]);
+        } else if constexpr (E == std::endian::little) {
+            v = static_cast<T>(load_le<typename W::uint>(p));
+        } else {
+            v = static_cast<T>(load_be<typename W::uint>(p));
+        }
+    }
+
+    // Member pointers of different types never name the same member.
+    template<auto A, auto B>
+    constexpr bool same_member() noexcept {
+        if constexpr (std::is_same_v<decltype(A), decltype(B)>) {
+            return A == B;
+        } else {
+            return false;
+        }
+    }
+
+    template<typename T>
+    struct is_vector : std::false_type {};
+    template<typename T, typename A>
+    struct is_vector<std::vector<T, A>> : std::true_type {};
+
+}  // namespace detail
+
+// ---- Field descriptors ----------------------------------------------------
+
+template<role R, auto Member, std::endian E, auto Value, unsigned Bit>
+struct field_spec {
+    static constexpr dsl::role role = R;
+    static constexpr auto member = Member;
+    static constexpr std::endian order = E;
+    static constexpr auto value = Value;
+    static constexpr unsigned bit = Bit;
+    using owner = typename detail::member_traits<Member>::owner;
+    using type = typename detail::member_traits<Member>::type;
+    static constexpr size_t size = detail::wire_traits<type>::size;
+};
+
+template<auto Member, std::endian E = std::endian::big>
+struct field : field_spec<role::plain, Member, E, 0, 0> {};
+
+template<auto Member, auto Value, std::endian E = std::endian::big>
+struct constant : field_spec<role::constant, Member, E, Value, 0> {};
+
+template<auto Member, auto Value, std::endian E = std::endian::big>
+struct message_type : field_spec<role::message_type, Member, E, Value, 0> {};
+
+template<auto Member, std::endian E = std::endian::big>
+struct length : field_spec<role::length, Member, E, 0, 0> {
+    static_assert(detail::wire_traits<typename length::type>::integral, "dsl: length must be an integer");
+};
+
+template<auto Member, std::endian E = std::endian::big>
+struct presence : field_spec<role::presence, Member, E, 0, 0> {
+    static_assert(std::is_unsigned_v<typename presence::type>, "dsl: presence map must be an unsigned integer");
+};
+
+template<auto Member, unsigned Bit, std::endian E = std::endian::big>
+struct optional : field_spec<role::optional, Member, E, 0, Bit> {
+    static_assert(Bit < 64, "dsl: optional bit out of range");
+};
+
+template<auto Vector, auto Count, typename... Fields>
+struct group {
+    static constexpr dsl::role role = dsl::role::group;
+    static constexpr auto member = Vector;
+    static constexpr auto count = Count;
+    using owner = typename detail::member_traits<Vector>::owner;
+    using vector_type = typename detail::member_traits<Vector>::type;
+    static_assert(detail::is_vector<vector_type>::value, "dsl: group member must be a std::vector");
+    using element = typename vector_type::value_type;
+    using count_type = typename detail::member_traits<Count>::type;
+    static_assert(std::is_same_v<typename detail::member_traits<Count>::owner, owner>,
+                  "dsl: group count must be a member of the same message");
+    static_assert(std::is_unsigned_v<count_type>, "dsl: group count must be an unsigned integer");
+    static_assert((std::is_same_v<typename Fields::owner, element> && ...),
+                  "dsl: group fields must be members of the group's element type");
+    static_assert(((Fields::role == dsl::role::plain || Fields::role == dsl::role::constant ||
+                    Fields::role == dsl::role::optional) && ...),
+                  "dsl: group fields may only be field, constant or optional");
+
+    static constexpr size_t min_size = ((Fields::role == dsl::role::optional ? 0 : Fields::size) + ... + 0);
+    static constexpr bool has_optional = ((Fields::role == dsl::role::optional) || ...);
+};
+
+// ---- Message layout -------------------------------------------------------
+
+template<typename M, typename... Specs>
+class message {
+    template<typename S>
+    static constexpr bool is_group = S::role == role::group;
+
+    static constexpr size_t kGroups = (size_t{is_group<Specs>} + ... + 0);
+    static constexpr size_t kPresence = (size_t{Specs::role == role::presence} + ... + 0);
+    static constexpr size_t kLength = (size_t{Specs::role == role::length} + ... + 0);
+
+    static constexpr bool groups_trail() {
+        bool seen = false;
+        bool ok = true;
+        ((seen = seen || is_group<Specs>, ok = ok && (is_group<Specs> || !seen)), ...);
+        return ok;
+    }
+
+    template<typename S>
+    static constexpr bool uses_presence() {
+        if constexpr (is_group<S>) {
+            return S::has_optional;
+        } else {
+            return S::role == role::optional;
+        }
+    }
+
+    template<typename S>
+    static constexpr size_t min_size_of() {
+        if constexpr (is_group<S>) {
+            return 0;
+        } else {
+            return S::role == role::optional ? 0 : S::size;
+        }
+    }
+
+    static_assert((std::is_same_v<typename Specs::owner, M> && ...),
+                  "dsl: every field must be a member of the message type");
+    static_assert(groups_trail(), "dsl: groups follow all fields on the wire");
+    static_assert(kPresence <= 1, "dsl: at most one presence map");
+    static_assert(kLength <= 1, "dsl: at most one length field");
+    static_assert(kPresence == 1 || !(uses_presence<Specs>() || ...),
+                  "dsl: optional fields need a presence map");
+
+public:
+    using type = M;
+
+    // ---- Traits -------------------------------------------------------------
+    static constexpr size_t field_count = sizeof...(Specs) - kGroups;
+    static constexpr size_t group_count = kGroups;
+    static constexpr bool has_presence_map = kPresence == 1;
+    static constexpr bool has_groups = kGroups > 0;
+    static constexpr bool has_optional = (uses_presence<Specs>() || ...);
+    static constexpr bool is_fixed_size = !has_groups && !has_optional;
+    // Bytes with every optional field absent and every group empty.
+    static constexpr size_t min_size = (min_size_of<Specs>() + ... + 0);
+
+    // Exact encoded size of `m`.
+    static size_t encoded_size(const M& m) noexcept {
+        if constexpr (is_fixed_size) {
+            return min_size;
+        } else {
+            const uint64_t pm = presence_bits(m);
+            return (size_of<Specs>(m, pm) + ... + 0);
+        }
+    }
+
+    // ---- Codec --------------------------------------------------------------
+    static status encode(const M& m, uint8_t* out, size_t out_sz, size_t& written) noexcept {
+        const size_t required = encoded_size(m);
+        if (out_sz < required) { written = 0; return status::short_buffer; }
+        const uint64_t pm = presence_bits(m);
+        size_t offset = 0;
+        (encode_one<Specs>(m, out, offset, pm, required), ...);
+        written = required;
+        return status::ok;
+    }
+
+    static status encode(const M& m, MutBytes out, size_t& written) noexcept {
+        return encode(m, out.data(), out.size(), written);
+    }
+
+    static status decode(const uint8_t* in, size_t in_sz, M& out, size_t& consumed) {
+        size_t offset = 0;
+        status st = status::ok;
+        const bool ok =
+            (decode_field<Specs>(in, in_sz, out, offset, st) && ...) &&
+            (check_type<Specs>(out, st) && ...) &&
+            (decode_group<Specs>(in, in_sz, out, offset, st) && ...) &&
+            (check_length<Specs>(out, offset, st) && ...);
+        if (MARKET_UNLIKELY(!ok)) { consumed = 0; return st; }
+        consumed = offset;
+        return status::ok;
+    }
+
+    static status decode(Bytes in, M& out, size_t& consumed) {
+        return decode(in.data(), in.size(), out, consumed);
+    }
+
+private:
+    static uint64_t presence_bits(const M& m) noexcept {
+        return (presence_of<Specs>(m) | ... | uint64_t{0});
+    }
+
+    template<typename S>
+    static uint64_t presence_of(const M& m) noexcept {
+        if constexpr (S::role == role::presence) {
+            return static_cast<uint64_t>(m.*S::member);
+        } else {
+            return 0;
+        }
+    }
+
+    template<typename F>
+    static constexpr bool present(uint64_t pm) noexcept {
+        if constexpr (F::role == role::optional) {
+            return (pm & (uint64_t{1} << F::bit)) != 0;
+        } else {
+            return true;
+        }
+    }
+
+    // Number of entries of the group whose count member is Count (0 if none).
+    template<auto Count>
+    static constexpr bool is_count() {
+        return (count_matches<Specs, Count>() || ...);
+    }
+
+    template<typename S, auto Count>
+    static constexpr bool count_matches() {
+        if constexpr (is_group<S>) {
+            return detail::same_member<S::count, Count>();
+        } else {
+            return false;
+        }
+    }
+
+    template<auto Count>
+    static size_t entries(const M& m) noexcept {
+        return (entries_of<Specs, Count>(m) + ... + 0);
+    }
+
+    template<typename S, auto Count>
+    static size_t entries_of(const M& m) noexcept {
+        if constexpr (count_matches<S, Count>()) {
+            return (m.*S::member).size();
+        } else {
+            return 0;
+        }
+    }
+
+    template<typename G, typename... F>
+    static size_t group_size(const M& m, uint64_t pm, group<G::member, G::count, F...>*) noexcept {
+        const size_t per = ((present<F>(pm) ? F::size : 0) + ... + 0);
+        return (m.*G::member).size() * per;
+    }
+
+    template<typename S>
+    static size_t size_of(const M& m, uint64_t pm) noexcept {
+        if constexpr (is_group<S>) {
+            return group_size<S>(m, pm, static_cast<S*>(nullptr));
+        } else {
+            return present<S>(pm) ? S::size : 0;
+        }
+    }
+
+    // ---- encode ----
+
+    template<typename F, typename T>
+    MARKET_ALWAYS_INLINE static void put_field(const T& obj, uint8_t* out, size_t& offset, uint64_t pm) noexcept {
+        if (!present<F>(pm)) return;
+        if constexpr (F::role == role::constant) {
+            detail::put<typename F::type, F::order>(out + offset, static_cast<typename F::type>(F::value));
+        } else {
+            detail::put<typename F::type, F::order>(out + offset, obj.*F::member);
+        }
+        offset += F::size;
+    }
+
+    template<typename G, typename... F>
+    MARKET_ALWAYS_INLINE static void put_group(const M& m, uint8_t* out, size_t& offset, uint64_t pm,
+                                               group<G::member, G::count, F...>*) noexcept {
+        for (const auto& e : m.*G::member) (put_field<F>(e, out, offset, pm), ...);
+    }
+
+    template<typename S>
+    MARKET_ALWAYS_INLINE static void encode_one(const M& m, uint8_t* out, size_t& offset, uint64_t pm,
+                                                size_t required) noexcept {
+        if constexpr (is_group<S>) {
+            put_group<S>(m, out, offset, pm, static_cast<S*>(nullptr));
+        } else if constexpr (is_count<S::member>()) {
+            using T = typename S::type;
+            detail::put<T, S::order>(out + offset, static_cast<T>(entries<S::member>(m)));
+            offset += S::size;
+        } else if constexpr (S::role == role::length) {
+            using T = typename S::type;
+            detail::put<T, S::order>(out + offset, static_cast<T>(required));
+            offset += S::size;
+        } else {
+            put_field<S>(m, out, offset, pm);
+        }
+    }
+
+    // ---- decode ----
+
+    // Reads one field into obj; optional fields absent from the wire are zeroed.
+    template<typename F, typename T>
+    MARKET_ALWAYS_INLINE static bool get_field(const uint8_t* in, size_t in_sz, T& obj, size_t& offset,
+                                               uint64_t pm, status& st) noexcept {
+        if (!present<F>(pm)) { obj.*F::member = {}; return true; }
+        if (MARKET_UNLIKELY(offset + F::size > in_sz)) { st = status::short_buffer; return false; }
+        detail::get<typename F::type, F::order>(in + offset, obj.*F::member);
+        offset += F::size;
+        if constexpr (F::role == role::constant) {
+            if (obj.*F::member != static_cast<typename F::type>(F::value)) { st = status::bad_value; return false; }
+        }
+        return true;
+    }
+
+    template<typename S>
+    MARKET_ALWAYS_INLINE static bool decode_field(const uint8_t* in, size_t in_sz, M& out, size_t& offset,
+                                                  status& st) noexcept {
+        if constexpr (is_group<S>) {
+            return true;
+        } else {
+            // Fields precede groups, so the presence map (if any) is already read
+            // by the time an optional field is reached.
+            return get_field<S>(in, in_sz, out, offset, presence_bits(out), st);
+        }
+    }
+
+    template<typename S>
+    MARKET_ALWAYS_INLINE static bool check_type(const M& out, status& st) noexcept {
+        if constexpr (S::role == role::message_type) {
+            if (out.*S::member != static_cast<typename S::type>(S::value)) { st = status::unknown_type; return false; }
+        }
+        return true;
+    }
+
+    template<typename G, typename... F>
+    MARKET_ALWAYS_INLINE static bool get_group(const uint8_t* in, size_t in_sz, M& out, size_t& offset,
+                                               status& st, group<G::member, G::count, F...>*) {
+        const uint64_t pm = presence_bits(out);
+        const size_t n = static_cast<size_t>(out.*G::count);
+        auto& vec = out.*G::member;
+        vec.clear();
+        vec.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            auto& e = vec.emplace_back();
+            if (!(get_field<F>(in, in_sz, e, offset, pm, st) && ...)) return false;
+        }
+        return true;
+    }
+
+    template<typename S>
+    MARKET_ALWAYS_INLINE static bool decode_group(const uint8_t* in, size_t in_sz, M& out, size_t& offset,
+                                                  status& st) {
+        if constexpr (is_group<S>) {
+            return get_group<S>(in, in_sz, out, offset, st, static_cast<S*>(nullptr));
+        } else {
+            return true;
+        }
+    }
+
+    template<typename S>
+    MARKET_ALWAYS_INLINE static bool check_length(const M& out, size_t offset, status& st) noexcept {
+        if constexpr (S::role == role::length) {
+            if (MARKET_UNLIKELY(out.*S::member != static_cast<typename S::type>(offset))) {
+                st = status::bad_value;
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+}  // namespace market::runtime::dsl
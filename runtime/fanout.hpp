@@ -0,0 +1,52 @@
+#pragma once
+
+#include <tuple>
+
+#include "runtime/config.hpp"
+#include "runtime/dispatch.hpp"
+
+namespace market::runtime {
+
+// Compile-time fan-out of one decoded message to several handlers.
+//
+// The dispatcher decodes each message once and calls on() on the fan-out, which
+// forwards it to every sub-handler that has a matching on() overload, in the
+// order the handlers were given. Sub-handlers without an overload for a message
+// type are skipped at compile time: no virtual calls, no type erasure.
+//
+//   BookBuilder book; Stats stats; Recorder rec;
+//   auto h = market::runtime::fanout(book, stats, rec);
+//   nasdaq::itch::v5::dispatch_itch(in, h, consumed);
+//
+// Handlers are held by reference and must outlive the fan-out object.
+template<typename... Hs>
+class fanout_handler {
+public:
+    explicit fanout_handler(Hs&... handlers) noexcept : handlers_(handlers...) {}
+
+    template<typename M>
+    MARKET_ALWAYS_INLINE void on(const M& msg) {
+        std::apply([&msg](auto&... h) { (deliver(h, msg), ...); }, handlers_);
+    }
+
+    // With receive metadata: each sub-handler gets on(msg, ctx) or on(msg).
+    template<typename M>
+    MARKET_ALWAYS_INLINE void on(const M& msg, const msg_context& ctx) {
+        std::apply([&msg, &ctx](auto&... h) { (deliver(h, msg, ctx), ...); }, handlers_);
+    }
+
+    // Access the I-th sub-handler.
+    template<size_t I>
+    auto& get() noexcept { return std::get<I>(handlers_); }
+
+private:
+    std::tuple<Hs&...> handlers_;
+};
+
+template<typename... Hs>
+fanout_handler<Hs...> fanout(Hs&... handlers) noexcept {
+    static_assert(sizeof...(Hs) > 0, "fanout requires at least one handler");
+    return fanout_handler<Hs...>(handlers...);
+}
+
+}
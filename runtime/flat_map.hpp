@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "runtime/config.hpp"
+
+namespace market::runtime {
+
+// Open-addressed hash map from 64-bit keys to trivially movable values.
+//
+// One flat array of {key, value} slots, linear probing, Fibonacci hashing and
+// backward-shift deletion (no tombstones, so probe lengths do not degrade under
+// the add/delete churn of an order book). ~0 marks empty slots, so that key is
+// stored out of line. Grows by doubling at 75% load; call reserve() up front to
+// keep rehashes off the hot path.
+template<typename V>
+class flat_u64_map {
+public:
+    static constexpr uint64_t kEmpty = ~uint64_t{0};
+
+    explicit flat_u64_map(size_t capacity = 1024) { allocate(round_up(capacity)); }
+
+    size_t size() const noexcept { return size_; }
+    size_t capacity() const noexcept { return mask_ + 1; }
+
+    void reserve(size_t n) {
+        const size_t want = round_up(n + n / 3 + 1);
+        if (want > capacity()) rehash(want);
+    }
+
+    V* find(uint64_t key) noexcept {
+        if (MARKET_UNLIKELY(key == kEmpty)) return has_empty_key_ ? &empty_key_value_ : nullptr;
+        for (size_t i = slot(key);; i = (i + 1) & mask_) {
+            if (slots_[i].key == key) return &slots_[i].value;
+            if (slots_[i].key == kEmpty) return nullptr;
+        }
+    }
+    const V* find(uint64_t key) const noexcept { return const_cast<flat_u64_map*>(this)->find(key); }
+
+    // Insert or overwrite. Returns a pointer to the stored value (valid until
+    // the next insert or erase).
+    V* insert(uint64_t key, const V& value) {
+        if (MARKET_UNLIKELY(key == kEmpty)) {
+            if (!has_empty_key_) ++size_;
+            has_empty_key_ = true;
+            empty_key_value_ = value;
+            return &empty_key_value_;
+        }
+        if (MARKET_UNLIKELY((size_ + 1) * 4 > capacity() * 3)) rehash(capacity() * 2);
+        size_t i = slot(key);
+        while (slots_[i].key != kEmpty && slots_[i].key != key) i = (i + 1) & mask_;
+        if (slots_[i].key == kEmpty) ++size_;
+        slots_[i].key = key;
+        slots_[i].value = value;
+        return &slots_[i].value;
+    }
+
+    // Value for `key`, default-constructing it if absent.
+    V& operator[](uint64_t key) {
+        if (V* v = find(key)) return *v;
+        return *insert(key, V{});
+    }
+
+    bool erase(uint64_t key) noexcept {
+        if (MARKET_UNLIKELY(key == kEmpty)) {
+            if (!has_empty_key_) return false;
+            has_empty_key_ = false;
+            empty_key_value_ = V{};
+            --size_;
+            return true;
+        }
+        size_t i = slot(key);
+        while (slots_[i].key != key) {
+            if (slots_[i].key == kEmpty) return false;
+            i = (i + 1) & mask_;
+        }
+        // Backward-shift: pull later members of the probe run into the hole.
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask_; slots_[j].key != kEmpty; j = (j + 1) & mask_) {
+            const size_t home = slot(slots_[j].key);
+            // Move j into the hole unless its home lies cyclically in (hole, j].
+            const bool stays = hole <= j ? (home > hole && home <= j) : (home > hole || home <= j);
+            if (!stays) {
+                slots_[hole] = std::move(slots_[j]);
+                hole = j;
+            }
+        }
+        slots_[hole].key = kEmpty;
+        --size_;
+        return true;
+    }
+
+    template<typename F>
+    void for_each(F&& f) const {
+        for (size_t i = 0; i <= mask_; ++i) {
+            if (slots_[i].key != kEmpty) f(slots_[i].key, slots_[i].value);
+        }
+        if (has_empty_key_) f(kEmpty, empty_key_value_);
+    }
+
+private:
+    struct entry {
+        uint64_t key{kEmpty};
+        V value{};
+    };
+
+    static size_t round_up(size_t n) {
+        size_t c = 16;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    size_t slot(uint64_t key) const noexcept {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+
+    void allocate(size_t cap) {
+        slots_ = std::make_unique<entry[]>(cap);
+        mask_ = cap - 1;
+        shift_ = 64 - static_cast<unsigned>(__builtin_ctzll(cap));
+        size_ = 0;
+    }
+
+    void rehash(size_t cap) {
+        std::unique_ptr<entry[]> old = std::move(slots_);
+        const size_t old_cap = mask_ + 1;
+        allocate(cap);
+        size_ = has_empty_key_ ? 1 : 0;
+        for (size_t i = 0; i < old_cap; ++i) {
+            if (old[i].key != kEmpty) insert(old[i].key, old[i].value);
+        }
+    }
+
+    std::unique_ptr<entry[]> slots_;
+    size_t mask_{0};
+    unsigned shift_{64};
+    size_t size_{0};
+    bool has_empty_key_{false};
+    V empty_key_value_{};
+};
+
+}
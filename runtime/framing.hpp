@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+
+namespace market::runtime {
+
+// Per-message framing written in front of each encoded message. Kept apart
+// from runtime/columnar.hpp so the generated fwd.hpp can name it without
+// parsing the batch encode helpers.
+enum class framing : uint8_t {
+    none,    // messages back to back
+    u16_be,  // big-endian u16 message length (MoldUDP64 message block; what
+             // dispatch_*_framed and <prefix>_decode_framed read)
+};
+
+constexpr size_t framing_size(framing f) noexcept {
+    return f == framing::u16_be ? 2 : 0;
+}
+
+MARKET_ALWAYS_INLINE void write_framing(uint8_t* p, framing f, size_t message_size) noexcept {
+    if (f == framing::u16_be) {
+        store_be<uint16_t>(p, static_cast<uint16_t>(message_size));
+    }
+}
+
+}  // namespace market::runtime
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace market::runtime {
+
+// Fixed-size log-linear histogram of unsigned 64-bit values (HDR-style).
+//
+// Values below 2^SubBits are counted exactly; above that each power-of-two range
+// is split into 2^SubBits equal buckets, bounding the relative error of any
+// reported quantile by 2^-SubBits. Memory is constant and there is no
+// allocation, so a histogram can live per symbol or per thread; shards are
+// combined with merge().
+template<unsigned SubBits = 4>
+class log_histogram {
+    static_assert(SubBits >= 1 && SubBits <= 8, "SubBits out of range");
+
+public:
+    static constexpr size_t kSub = size_t{1} << SubBits;
+    static constexpr size_t kBuckets = (64 - SubBits + 1) * kSub;
+
+    void record(uint64_t v, uint64_t n = 1) noexcept {
+        counts_[index(v)] += n;
+        total_ += n;
+        sum_ += v * n;
+        if (v < min_) min_ = v;
+        if (v > max_) max_ = v;
+    }
+
+    void merge(const log_histogram& o) noexcept {
+        for (size_t i = 0; i < kBuckets; ++i) counts_[i] += o.counts_[i];
+        total_ += o.total_;
+        sum_ += o.sum_;
+        if (o.min_ < min_) min_ = o.min_;
+        if (o.max_ > max_) max_ = o.max_;
+    }
+
+    void reset() noexcept { *this = log_histogram{}; }
+
+    uint64_t count() const noexcept { return total_; }
+    uint64_t min() const noexcept { return total_ ? min_ : 0; }
+    uint64_t max() const noexcept { return max_; }
+    double mean() const noexcept { return total_ ? static_cast<double>(sum_) / static_cast<double>(total_) : 0.0; }
+
+    // Value at quantile q in [0, 1]: the upper bound of the bucket holding it,
+    // clamped to the observed min/max.
+    uint64_t quantile(double q) const noexcept {
+        if (total_ == 0) return 0;
+        if (q <= 0.0) return min_;
+        if (q >= 1.0) return max_;
+        const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total_ - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                const uint64_t hi = upper_bound(i);
+                return hi < min_ ? min_ : (hi > max_ ? max_ : hi);
+            }
+        }
+        return max_;
+    }
+
+    // Bucket index for a value and the largest value it can hold.
+    static size_t index(uint64_t v) noexcept {
+        if (v < kSub) return static_cast<size_t>(v);
+        const unsigned e = static_cast<unsigned>(std::bit_width(v)) - 1;  // e >= SubBits
+        const unsigned shift = e - SubBits;
+        const size_t sub = static_cast<size_t>((v >> shift) & (kSub - 1));
+        return (static_cast<size_t>(shift) + 1) * kSub + sub;
+    }
+
+    static uint64_t upper_bound(size_t i) noexcept {
+        if (i < kSub) return i;
+        const unsigned shift = static_cast<unsigned>(i / kSub) - 1;
+        const uint64_t base = (uint64_t{1} << SubBits | (i % kSub)) << shift;
+        return base + ((uint64_t{1} << shift) - 1);
+    }
+
+    uint64_t bucket_count(size_t i) const noexcept { return counts_[i]; }
+
+private:
+    std::array<uint64_t, kBuckets> counts_{};
+    uint64_t total_{0};
+    uint64_t sum_{0};
+    uint64_t min_{std::numeric_limits<uint64_t>::max()};
+    uint64_t max_{0};
+};
+
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "runtime/config.hpp"
+
+namespace market::runtime {
+
+// Monotonic sequence owned by one pipeline stage (or the producer), padded to
+// its own cache line. -1 means "nothing processed yet".
+struct alignas(64) ring_cursor {
+    std::atomic<int64_t> value{-1};
+
+    int64_t get() const noexcept { return value.load(std::memory_order_acquire); }
+    void set(int64_t v) noexcept { value.store(v, std::memory_order_release); }
+};
+
+// Tracks the highest sequence a stage may read: the producer's published cursor
+// and every upstream stage the consumer depends on, whichever is lowest.
+class ring_barrier {
+public:
+    ring_barrier(const ring_cursor& published, std::initializer_list<const ring_cursor*> deps)
+        : published_(&published), deps_(deps) {}
+
+    // Highest sequence currently readable (may be below `seq`).
+    int64_t available() const noexcept {
+        int64_t hi = published_->get();
+        for (const ring_cursor* d : deps_) {
+            const int64_t v = d->get();
+            if (v < hi) hi = v;
+        }
+        return hi;
+    }
+
+    // Spin until at least `seq` is readable; returns the highest readable sequence.
+    int64_t wait_for(int64_t seq) const noexcept {
+        int64_t hi;
+        while ((hi = available()) < seq) {
+            MARKET_CPU_RELAX();
+        }
+        return hi;
+    }
+
+private:
+    const ring_cursor* published_;
+    std::vector<const ring_cursor*> deps_;
+};
+
+// Pre-allocated single-producer, multi-consumer ring (Disruptor pattern).
+//
+// The producer claims a batch of slots, fills them in place and publishes the
+// batch with one release store. Each consumer stage owns a ring_cursor and reads
+// through a ring_barrier, which can include other stages' cursors: e.g. the
+// recorder runs strictly behind the book builder without a queue between them.
+// Entries are never copied per consumer: every stage sees the same slot and a
+// stage may annotate it for stages that depend on it. The producer only blocks
+// when it would lap the slowest gating (terminal) stage.
+//
+//   multicast_ring<Event> ring(1 << 16);
+//   ring_cursor book_done, rec_done;
+//   auto book_in = ring.barrier();               // reads after producer
+//   auto rec_in  = ring.barrier({&book_done});   // reads after the book
+//   ring.add_gating(rec_done);                   // producer may not lap the recorder
+template<typename T>
+class multicast_ring {
+public:
+    explicit multicast_ring(size_t capacity) {
+        size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        entries_ = std::make_unique<T[]>(cap);
+        mask_ = cap - 1;
+        capacity_ = static_cast<int64_t>(cap);
+    }
+
+    size_t capacity() const noexcept { return static_cast<size_t>(capacity_); }
+
+    T& operator[](int64_t seq) noexcept { return entries_[static_cast<size_t>(seq) & mask_]; }
+    const T& operator[](int64_t seq) const noexcept { return entries_[static_cast<size_t>(seq) & mask_]; }
+
+    // Setup: register a stage the producer must never lap. Call before producing.
+    void add_gating(const ring_cursor& c) { gating_.push_back(&c); }
+
+    ring_barrier barrier(std::initializer_list<const ring_cursor*> deps = {}) const {
+        return ring_barrier(published_, deps);
+    }
+
+    const ring_cursor& published() const noexcept { return published_; }
+
+    // Producer: claim `n` consecutive slots (n <= capacity), spinning while the
+    // slowest gating stage is a full ring behind. Returns the highest claimed
+    // sequence; the batch is [hi - n + 1, hi].
+    int64_t claim(size_t n = 1) noexcept {
+        const int64_t hi = claimed_ + static_cast<int64_t>(n);
+        const int64_t wrap = hi - capacity_;
+        while (wrap > cached_gate_) {
+            cached_gate_ = min_gating(hi);
+            if (wrap > cached_gate_) MARKET_CPU_RELAX();
+        }
+        claimed_ = hi;
+        return hi;
+    }
+
+    // Producer: non-blocking claim. Returns false if there is not enough room.
+    bool try_claim(size_t n, int64_t& hi) noexcept {
+        const int64_t next = claimed_ + static_cast<int64_t>(n);
+        if (next - capacity_ > cached_gate_) {
+            cached_gate_ = min_gating(next);
+            if (next - capacity_ > cached_gate_) return false;
+        }
+        claimed_ = hi = next;
+        return true;
+    }
+
+    // Producer: make everything up to and including `hi` visible to consumers.
+    void publish(int64_t hi) noexcept { published_.set(hi); }
+
+    // Consumer: process every entry readable through `in` past `mine`, then
+    // release the whole batch with one store to `mine`. f(T&, int64_t seq, bool
+    // end_of_batch). Returns the number of entries processed.
+    template<typename F>
+    size_t consume(const ring_barrier& in, ring_cursor& mine, F&& f) {
+        const int64_t next = mine.value.load(std::memory_order_relaxed) + 1;
+        const int64_t hi = in.available();
+        if (hi < next) return 0;
+        for (int64_t s = next; s <= hi; ++s) {
+            f((*this)[s], s, s == hi);
+        }
+        mine.set(hi);
+        return static_cast<size_t>(hi - next + 1);
+    }
+
+private:
+    int64_t min_gating(int64_t fallback) const noexcept {
+        int64_t lo = fallback;
+        for (const ring_cursor* g : gating_) {
+            const int64_t v = g->get();
+            if (v < lo) lo = v;
+        }
+        return lo;
+    }
+
+    std::unique_ptr<T[]> entries_;
+    size_t mask_{0};
+    int64_t capacity_{0};
+    std::vector<const ring_cursor*> gating_;
+    alignas(64) int64_t claimed_{-1};   // producer-private
+    int64_t cached_gate_{-1};           // producer-private
+    ring_cursor published_;
+};
+
+}
@@ -0,0 +1,260 @@
+#pragma once
+
+// Order-flow analytics handler.
+//
+// Tracks every resting order from add to removal and accumulates, per symbol:
+//   - order lifetime (add -> cancel/full fill) as a log histogram,
+//   - add / cancel / execution / replace counts (cancel-to-add ratio),
+//   - queue position at cancel: displayed shares ahead of the order at its
+//     price level when it was pulled.
+//
+// Queue position is a conservative O(1) estimate: under price-time priority an
+// order can only move forward, so the shares ahead at cancel are bounded by both
+// the level volume ahead of it on arrival and the level's current volume minus
+// its own shares; the tracker reports the smaller of the two.
+//
+// The handler is protocol-agnostic: on() accepts any message shaped like an add
+// (OrderId, Side, Shares, Price, Symbol, Timestamp) or a delete (OrderId,
+// Timestamp), which covers the generated ITCH AddOrder/DeleteOrder. Executions
+// and replaces are exposed as explicit on_execute()/on_replace() calls until
+// the schema models them. Trackers sharded by symbol or by feed combine with
+// merge().
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "runtime/config.hpp"
+#include "runtime/context.hpp"
+#include "runtime/flat_map.hpp"
+#include "runtime/histogram.hpp"
+
+namespace market::runtime {
+
+template<typename M>
+concept add_order_message = requires(const M& m) {
+    m.OrderId;
+    m.Side;
+    m.Shares;
+    m.Price;
+    m.Symbol;
+    m.Timestamp;
+};
+
+template<typename M>
+concept delete_order_message = !add_order_message<M> && requires(const M& m) {
+    m.OrderId;
+    m.Timestamp;
+} && !requires(const M& m) { m.Shares; };
+
+// Per-symbol distributions. Three sub-bucket bits (12.5% relative error) keep a
+// symbol at ~8 KiB (two 496-bucket histograms) so a full-universe tracker stays
+// in the tens of megabytes.
+struct symbol_flow {
+    using histogram = log_histogram<3>;
+
+    histogram lifetime;        // timestamp units of the feed (ITCH: ns)
+    histogram queue_ahead;     // shares ahead at cancel
+    uint64_t adds{0};
+    uint64_t cancels{0};
+    uint64_t executions{0};
+    uint64_t replaces{0};
+    uint64_t filled{0};        // orders removed by a full execution
+
+    double cancel_to_add() const noexcept {
+        return adds ? static_cast<double>(cancels) / static_cast<double>(adds) : 0.0;
+    }
+
+    void merge(const symbol_flow& o) noexcept {
+        lifetime.merge(o.lifetime);
+        queue_ahead.merge(o.queue_ahead);
+        adds += o.adds;
+        cancels += o.cancels;
+        executions += o.executions;
+        replaces += o.replaces;
+        filled += o.filled;
+    }
+};
+
+class order_flow_tracker {
+public:
+    using symbol_key = std::array<char, 8>;
+
+    explicit order_flow_tracker(size_t expected_orders = 1u << 16)
+        : orders_(expected_orders), levels_(expected_orders / 4), symbols_(1024) {}
+
+    // ---- Handler interface -------------------------------------------------
+    template<add_order_message M>
+    void on(const M& m) {
+        symbol_key sym{};
+        std::memcpy(sym.data(), &m.Symbol, sizeof(sym) < sizeof(m.Symbol) ? sizeof(sym) : sizeof(m.Symbol));
+        on_add(static_cast<uint64_t>(m.OrderId), sym, static_cast<char>(m.Side),
+               static_cast<uint32_t>(m.Price), static_cast<uint32_t>(m.Shares),
+               static_cast<uint64_t>(m.Timestamp));
+    }
+
+    template<delete_order_message M>
+    void on(const M& m) {
+        on_delete(static_cast<uint64_t>(m.OrderId), static_cast<uint64_t>(m.Timestamp));
+    }
+
+    template<typename M>
+        requires add_order_message<M> || delete_order_message<M>
+    void on(const M& m, const msg_context&) { on(m); }
+
+    // ---- Event interface ---------------------------------------------------
+    void on_add(uint64_t order_id, const symbol_key& symbol, char side, uint32_t price,
+                uint32_t shares, uint64_t ts) {
+        const uint32_t sym = intern(symbol);
+        uint64_t& level = levels_[level_key(sym, side, price)];
+        order o{};
+        o.add_ts = ts;
+        o.ahead = level;
+        o.price = price;
+        o.shares = shares;
+        o.symbol = sym;
+        o.side = side;
+        level += shares;
+        orders_.insert(order_id, o);
+        ++flows_[sym].adds;
+    }
+
+    // Order pulled by the participant: records lifetime and queue position.
+    void on_delete(uint64_t order_id, uint64_t ts) {
+        order* o = orders_.find(order_id);
+        if (MARKET_UNLIKELY(!o)) { ++unknown_; return; }
+        symbol_flow& f = flows_[o->symbol];
+        ++f.cancels;
+        f.lifetime.record(ts >= o->add_ts ? ts - o->add_ts : 0);
+        const uint64_t lk = level_key(o->symbol, o->side, o->price);
+        uint64_t* level = levels_.find(lk);
+        const uint64_t vol = level ? *level : o->shares;
+        const uint64_t others = vol > o->shares ? vol - o->shares : 0;
+        f.queue_ahead.record(o->ahead < others ? o->ahead : others);
+        remove(*o, lk, level);
+        orders_.erase(order_id);
+    }
+
+    // Partial or full execution against a resting order. Executions consume the
+    // front of the queue, so they also shrink every later order's "ahead" bound
+    // implicitly through the level volume.
+    void on_execute(uint64_t order_id, uint32_t shares, uint64_t ts) {
+        order* o = orders_.find(order_id);
+        if (MARKET_UNLIKELY(!o)) { ++unknown_; return; }
+        symbol_flow& f = flows_[o->symbol];
+        ++f.executions;
+        const uint32_t n = shares < o->shares ? shares : o->shares;
+        const uint64_t lk = level_key(o->symbol, o->side, o->price);
+        uint64_t* level = levels_.find(lk);
+        if (level) *level = *level > n ? *level - n : 0;
+        o->ahead = 0;  // only the queue head executes
+        o->shares -= n;
+        if (o->shares == 0) {
+            ++f.filled;
+            f.lifetime.record(ts >= o->add_ts ? ts - o->add_ts : 0);
+            if (level && *level == 0) levels_.erase(lk);
+            orders_.erase(order_id);
+        }
+    }
+
+    // Cancel-replace: the old order leaves the book (lifetime ends, counted as a
+    // replace rather than a cancel) and the new one joins the back of its level.
+    void on_replace(uint64_t old_id, uint64_t new_id, uint32_t price, uint32_t shares, uint64_t ts) {
+        order* o = orders_.find(old_id);
+        if (MARKET_UNLIKELY(!o)) { ++unknown_; return; }
+        const order prev = *o;
+        symbol_flow& f = flows_[prev.symbol];
+        ++f.replaces;
+        f.lifetime.record(ts >= prev.add_ts ? ts - prev.add_ts : 0);
+        const uint64_t lk = level_key(prev.symbol, prev.side, prev.price);
+        remove(prev, lk, levels_.find(lk));
+        orders_.erase(old_id);
+
+        uint64_t& level = levels_[level_key(prev.symbol, prev.side, price)];
+        order n{};
+        n.add_ts = ts;
+        n.ahead = level;
+        n.price = price;
+        n.shares = shares;
+        n.symbol = prev.symbol;
+        n.side = prev.side;
+        level += shares;
+        orders_.insert(new_id, n);
+    }
+
+    // ---- Results -----------------------------------------------------------
+    size_t symbol_count() const noexcept { return names_.size(); }
+    const symbol_key& symbol(size_t i) const noexcept { return names_[i]; }
+    const symbol_flow& flow(size_t i) const noexcept { return flows_[i]; }
+
+    // Flow for `symbol` (space padded as on the wire), or nullptr if never seen.
+    const symbol_flow* find(const symbol_key& symbol) const noexcept {
+        const uint32_t* id = symbols_.find(pack(symbol));
+        return id ? &flows_[*id] : nullptr;
+    }
+
+    // All symbols folded together.
+    symbol_flow totals() const {
+        symbol_flow t;
+        for (const auto& f : flows_) t.merge(f);
+        return t;
+    }
+
+    size_t open_orders() const noexcept { return orders_.size(); }
+    uint64_t unknown_orders() const noexcept { return unknown_; }
+
+    // Fold another shard's distributions into this one by symbol. Open orders
+    // are not transferred; merge finished shards (or snapshot distributions).
+    void merge(const order_flow_tracker& o) {
+        for (size_t i = 0; i < o.names_.size(); ++i) flows_[intern(o.names_[i])].merge(o.flows_[i]);
+        unknown_ += o.unknown_;
+    }
+
+private:
+    struct order {
+        uint64_t add_ts;
+        uint64_t ahead;    // level volume ahead on arrival (upper bound)
+        uint32_t price;
+        uint32_t shares;
+        uint32_t symbol;
+        char side;
+    };
+
+    static uint64_t pack(const symbol_key& s) noexcept {
+        uint64_t k;
+        std::memcpy(&k, s.data(), sizeof(k));
+        return k;
+    }
+
+    // symbol (24 bits) | side (1 bit) | price (32 bits)
+    static uint64_t level_key(uint32_t sym, char side, uint32_t price) noexcept {
+        return (static_cast<uint64_t>(sym) << 33) | (static_cast<uint64_t>(side == 'S') << 32) | price;
+    }
+
+    uint32_t intern(const symbol_key& s) {
+        const uint64_t k = pack(s);
+        if (const uint32_t* id = symbols_.find(k)) return *id;
+        const auto id = static_cast<uint32_t>(names_.size());
+        symbols_.insert(k, id);
+        names_.push_back(s);
+        flows_.emplace_back();
+        return id;
+    }
+
+    void remove(const order& o, uint64_t lk, uint64_t* level) noexcept {
+        if (!level) return;
+        *level = *level > o.shares ? *level - o.shares : 0;
+        if (*level == 0) levels_.erase(lk);
+    }
+
+    flat_u64_map<order> orders_;
+    flat_u64_map<uint64_t> levels_;     // displayed shares per (symbol, side, price)
+    flat_u64_map<uint32_t> symbols_;    // packed symbol -> dense id
+    std::vector<symbol_key> names_;
+    std::vector<symbol_flow> flows_;
+    uint64_t unknown_{0};
+};
+
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MARKET_PCAP_MMAP 1
+#else
+#define MARKET_PCAP_MMAP 0
+#endif
+
+#include "runtime/bytes.hpp"
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/status.hpp"
+
+namespace market::runtime {
+
+// One captured packet: a view into the mapped file, valid while the reader lives.
+struct pcap_packet {
+    uint64_t ts_ns{0};    // capture timestamp, nanoseconds since the epoch
+    uint32_t orig_len{0}; // length on the wire (may exceed data.size() if truncated)
+    Bytes data{};
+};
+
+// Sequential reader over a classic libpcap file, memory-mapped read-only.
+// Handles micro- and nanosecond timestamp variants in either byte order.
+// `payload_offset` bytes are stripped from every packet (e.g. 42 for
+// Ethernet/IPv4/UDP headers) so data starts at the feed payload.
+class pcap_reader {
+public:
+    pcap_reader() = default;
+    pcap_reader(const pcap_reader&) = delete;
+    pcap_reader& operator=(const pcap_reader&) = delete;
+    pcap_reader(pcap_reader&& o) noexcept { *this = std::move(o); }
+    pcap_reader& operator=(pcap_reader&& o) noexcept {
+        if (this != &o) {
+            close();
+            base_ = o.base_;
+            size_ = o.size_;
+            mapped_ = o.mapped_;
+            buffer_ = std::move(o.buffer_);
+            if (!mapped_ && !buffer_.empty()) base_ = buffer_.data();
+            off_ = o.off_;
+            swap_ = o.swap_;
+            nanos_ = o.nanos_;
+            payload_offset_ = o.payload_offset_;
+            o.base_ = nullptr;
+            o.size_ = 0;
+            o.mapped_ = false;
+        }
+        return *this;
+    }
+    ~pcap_reader() { close(); }
+
+    status open(const std::string& path, size_t payload_offset = 0) {
+        close();
+#if MARKET_PCAP_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return status::bad_value;
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return status::bad_value;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                size_ = 0;
+                return status::bad_value;
+            }
+            ::madvise(p, size_, MADV_SEQUENTIAL);
+            base_ = static_cast<const uint8_t*>(p);
+            mapped_ = true;
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return status::bad_value;
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        base_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+        payload_offset_ = payload_offset;
+        return parse_global_header();
+    }
+
+    // Reads the next packet. Returns false at end of file or on a truncated record.
+    bool next(pcap_packet& pkt) noexcept {
+        if (MARKET_UNLIKELY(off_ + 16 > size_)) return false;
+        const uint8_t* h = base_ + off_;
+        const uint32_t ts_sec = u32(h);
+        const uint32_t ts_frac = u32(h + 4);
+        const uint32_t incl = u32(h + 8);
+        const uint32_t orig = u32(h + 12);
+        if (MARKET_UNLIKELY(off_ + 16 + incl > size_)) return false;
+        pkt.ts_ns = static_cast<uint64_t>(ts_sec) * 1'000'000'000ULL +
+                    static_cast<uint64_t>(ts_frac) * (nanos_ ? 1ULL : 1000ULL);
+        pkt.orig_len = orig;
+        const size_t skip = payload_offset_ < incl ? payload_offset_ : incl;
+        pkt.data = Bytes{h + 16 + skip, incl - skip};
+        off_ += 16 + incl;
+        return true;
+    }
+
+    // Timestamp of the next packet without consuming it; false at end of file.
+    bool peek_ts(uint64_t& ts_ns) const noexcept {
+        if (off_ + 16 > size_) return false;
+        const uint8_t* h = base_ + off_;
+        ts_ns = static_cast<uint64_t>(u32(h)) * 1'000'000'000ULL +
+                static_cast<uint64_t>(u32(h + 4)) * (nanos_ ? 1ULL : 1000ULL);
+        return true;
+    }
+
+    bool nanosecond_resolution() const noexcept { return nanos_; }
+
+    void close() noexcept {
+#if MARKET_PCAP_MMAP
+        if (mapped_ && base_) ::munmap(const_cast<uint8_t*>(base_), size_);
+#endif
+        base_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        buffer_.clear();
+        off_ = 0;
+    }
+
+private:
+    status parse_global_header() noexcept {
+        if (size_ < 24) return status::short_buffer;
+        uint32_t magic;
+        std::memcpy(&magic, base_, 4);
+        switch (magic) {
+            case 0xa1b2c3d4: swap_ = false; nanos_ = false; break;
+            case 0xa1b23c4d: swap_ = false; nanos_ = true; break;
+            case 0xd4c3b2a1: swap_ = true; nanos_ = false; break;
+            case 0x4d3cb2a1: swap_ = true; nanos_ = true; break;
+            default: return status::bad_value;
+        }
+        off_ = 24;
+        return status::ok;
+    }
+
+    uint32_t u32(const uint8_t* p) const noexcept {
+        uint32_t v;
+        std::memcpy(&v, p, 4);
+        return swap_ ? detail::byteswap(v) : v;
+    }
+
+    const uint8_t* base_{nullptr};
+    size_t size_{0};
+    bool mapped_{false};
+    std::vector<uint8_t> buffer_;
+    size_t off_{0};
+    bool swap_{false};
+    bool nanos_{false};
+    size_t payload_offset_{0};
+};
+
+}
@@ -0,0 +1,557 @@
+#pragma once
+
+// Table-driven runtime schema interpreter.
+//
+// Loads the binary descriptor that codegen/generate.py writes next to the
+// generated sources (schema.bin) and decodes messages of that schema without
+// generating or compiling any code. Each message is compiled once into a flat
+// op table; decode() then runs a tight switch over that table into a generic,
+// fixed-capacity record. char, vstring and bytes fields are zero-copy views
+// into the input.
+//
+// Intended for tooling and ad-hoc analysis of new or altered venue messages;
+// the generated Decoder remains the fast path for production feeds.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "runtime/bytes.hpp"
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/status.hpp"
+
+namespace market::runtime::interp {
+
+enum class field_kind : uint8_t {
+    uint = 0,
+    chars = 1,
+    enumeration = 2,
+    vstring = 3,  // size is the length prefix width (1 or 2), value the max length
+    bytes = 4,
+};
+
+namespace field_flag {
+    inline constexpr uint8_t big_endian = 0x01;
+    inline constexpr uint8_t has_value = 0x02;
+    inline constexpr uint8_t optional = 0x04;
+    inline constexpr uint8_t presence_map = 0x08;
+    inline constexpr uint8_t length = 0x10;
+    inline constexpr uint8_t discriminator = 0x20;
+}
+
+inline constexpr uint16_t no_index = 0xFFFF;
+
+struct field_desc {
+    std::string name;
+    field_kind kind{field_kind::uint};
+    uint16_t size{0};
+    uint8_t flags{0};
+    uint8_t optional_bit{0};
+    uint64_t value{0};
+};
+
+struct group_desc {
+    std::string name;
+    uint16_t count_field{no_index};
+    std::vector<field_desc> fields;
+};
+
+struct message_desc {
+    std::string name;
+    std::vector<field_desc> fields;
+    std::vector<group_desc> groups;
+    uint16_t presence_field{no_index};
+    uint16_t length_field{no_index};
+    uint16_t discriminator{no_index};
+};
+
+// Parsed schema descriptor.
+class schema {
+public:
+    static constexpr uint16_t kFormatVersion = 2;
+    // Record slots a message may need: its fields plus one entry of each group
+    static constexpr size_t kMaxSlots = 512;
+
+    status load(Bytes descriptor) {
+        reader r{descriptor.data(), descriptor.size(), 0, true};
+        const uint8_t* magic = r.take(4);
+        if (!r.ok) return status::short_buffer;
+        if (std::memcmp(magic, "MDSD", 4) != 0) return status::bad_value;
+        const uint16_t format = r.u16();
+        version_ = r.u16();
+        if (!r.ok) return status::short_buffer;
+        if (format != kFormatVersion) return status::bad_value;
+        protocol_ = r.str();
+        const uint16_t message_count = r.u16();
+        messages_.clear();
+        messages_.reserve(message_count);
+        for (uint16_t m = 0; m < message_count && r.ok; ++m) {
+            message_desc md;
+            md.name = r.str();
+            const uint16_t field_count = r.u16();
+            md.presence_field = r.u16();
+            md.length_field = r.u16();
+            md.discriminator = r.u16();
+            for (uint16_t f = 0; f < field_count && r.ok; ++f) {
+                md.fields.push_back(read_field(r));
+                if (r.ok && !valid_field(md.fields.back())) return status::bad_value;
+            }
+            if (!r.ok) break;
+            // Every field needs a record slot, and the indexes must name a field
+            if (field_count > kMaxSlots || !valid_index(md.presence_field, field_count) ||
+                !valid_index(md.length_field, field_count) || !valid_index(md.discriminator, field_count))
+                return status::bad_value;
+            size_t slots = field_count;
+            const uint16_t group_count = r.u16();
+            for (uint16_t g = 0; g < group_count && r.ok; ++g) {
+                group_desc gd;
+                gd.name = r.str();
+                gd.count_field = r.u16();
+                const uint16_t gfield_count = r.u16();
+                for (uint16_t f = 0; f < gfield_count && r.ok; ++f) {
+                    gd.fields.push_back(read_field(r));
+                    if (r.ok && !valid_field(gd.fields.back())) return status::bad_value;
+                }
+                if (!r.ok) break;
+                // One entry of every group must fit beside the fields
+                slots += gfield_count;
+                if (gd.count_field >= md.fields.size() || slots > kMaxSlots) return status::bad_value;
+                md.groups.push_back(std::move(gd));
+            }
+            messages_.push_back(std::move(md));
+        }
+        if (!r.ok) return status::short_buffer;
+        return status::ok;
+    }
+
+    status load_file(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return status::bad_value;
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), {});
+        return load(Bytes{bytes.data(), bytes.size()});
+    }
+
+    const std::string& protocol() const noexcept { return protocol_; }
+    uint16_t version() const noexcept { return version_; }
+    const std::vector<message_desc>& messages() const noexcept { return messages_; }
+
+    // Index of the named message, or -1.
+    int find_message(std::string_view name) const noexcept {
+        for (size_t i = 0; i < messages_.size(); ++i) {
+            if (messages_[i].name == name) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    // Index of the named top-level field of message `msg`, or -1.
+    int find_field(size_t msg, std::string_view name) const noexcept {
+        const auto& fields = messages_[msg].fields;
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i].name == name) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+private:
+    struct reader {
+        const uint8_t* p;
+        size_t n;
+        size_t off;
+        bool ok;
+
+        const uint8_t* take(size_t k) {
+            if (!ok || off + k > n) {
+                ok = false;
+                return nullptr;
+            }
+            const uint8_t* at = p + off;
+            off += k;
+            return at;
+        }
+        uint8_t u8() { const uint8_t* b = take(1); return b ? b[0] : 0; }
+        uint16_t u16() { const uint8_t* b = take(2); return b ? load_le<uint16_t>(b) : 0; }
+        uint64_t u64() { const uint8_t* b = take(8); return b ? load_le<uint64_t>(b) : 0; }
+        std::string str() {
+            const uint8_t len = u8();
+            const uint8_t* b = take(len);
+            return b ? std::string(reinterpret_cast<const char*>(b), len) : std::string();
+        }
+    };
+
+    // What decode() relies on: optional bits index a u64 presence map and
+    // length prefixes are one or two bytes.
+    static bool valid_field(const field_desc& fd) noexcept {
+        if (fd.optional_bit >= 64) return false;
+        if (fd.kind == field_kind::vstring || fd.kind == field_kind::bytes) return fd.size == 1 || fd.size == 2;
+        return true;
+    }
+
+    static bool valid_index(uint16_t index, uint16_t field_count) noexcept {
+        return index == no_index || index < field_count;
+    }
+
+    static field_desc read_field(reader& r) {
+        field_desc fd;
+        fd.name = r.str();
+        fd.kind = static_cast<field_kind>(r.u8());
+        fd.size = r.u16();
+        fd.flags = r.u8();
+        fd.optional_bit = r.u8();
+        fd.value = r.u64();
+        return fd;
+    }
+
+    std::string protocol_;
+    uint16_t version_{0};
+    std::vector<message_desc> messages_;
+};
+
+// Generic decoded message. Top-level fields occupy slots [0, field_count);
+// group entries follow, entry-major. Integer and enum fields hold their value,
+// char, vstring and bytes fields hold (offset | length << 32) into `base` and
+// are read via str().
+struct record {
+    static constexpr size_t kMaxValues = schema::kMaxSlots;
+    static constexpr size_t kMaxGroups = 8;
+
+    uint16_t message{0};
+    uint16_t used{0};
+    const uint8_t* base{nullptr};
+    std::array<uint64_t, kMaxValues> values{};
+    std::array<uint64_t, kMaxValues / 64> absent{};  // optional fields not on the wire
+    std::array<uint16_t, kMaxGroups> group_first{};
+    std::array<uint16_t, kMaxGroups> group_entries{};
+    std::array<uint16_t, kMaxGroups> group_width{};
+
+    uint64_t u(size_t slot) const noexcept { return values[slot]; }
+
+    std::string_view str(size_t slot) const noexcept {
+        const uint64_t v = values[slot];
+        return std::string_view(reinterpret_cast<const char*>(base) + (v & 0xFFFFFFFFu),
+                                static_cast<size_t>(v >> 32));
+    }
+
+    bool has(size_t slot) const noexcept { return ((absent[slot / 64] >> (slot % 64)) & 1u) == 0; }
+
+    size_t group_size(size_t g) const noexcept { return group_entries[g]; }
+
+    size_t group_slot(size_t g, size_t entry, size_t field) const noexcept {
+        return group_first[g] + entry * group_width[g] + field;
+    }
+};
+
+// Compiled, table-driven decoder for one schema. The schema must outlive it.
+class interpreter {
+public:
+    explicit interpreter(const schema& s) : schema_(s) {
+        by_type_.fill(-1);
+        programs_.reserve(s.messages().size());
+        bool table_ok = true;
+        uint32_t table_offset = UINT32_MAX;
+        for (size_t m = 0; m < s.messages().size(); ++m) {
+            programs_.push_back(compile(s.messages()[m]));
+            const program& pr = programs_.back();
+            if (pr.disc_slot == no_index) continue;
+            const op& d = pr.ops[pr.disc_slot];
+            if (d.size != 1 || (table_offset != UINT32_MAX && table_offset != pr.disc_offset)) {
+                table_ok = false;
+            }
+            table_offset = pr.disc_offset;
+            if (table_ok && d.value < 256) {
+                by_type_[d.value] = static_cast<int16_t>(m);
+            }
+        }
+        if (table_ok && table_offset != UINT32_MAX) {
+            type_offset_ = table_offset;
+        }
+    }
+
+    const schema& get_schema() const noexcept { return schema_; }
+
+    // Identify the message at `in` by its discriminator. Returns -1 if unknown.
+    int identify(const uint8_t* in, size_t in_sz) const noexcept {
+        if (type_offset_ != UINT32_MAX) {
+            if (MARKET_UNLIKELY(type_offset_ >= in_sz)) return -1;
+            return by_type_[in[type_offset_]];
+        }
+        for (size_t m = 0; m < programs_.size(); ++m) {
+            const program& pr = programs_[m];
+            if (pr.disc_slot == no_index) continue;
+            const op& d = pr.ops[pr.disc_slot];
+            if (pr.disc_offset + d.size > in_sz) continue;
+            if (read_uint(d, in + pr.disc_offset) == d.value) return static_cast<int>(m);
+        }
+        return -1;
+    }
+
+    // Identify and decode one message.
+    status decode(const uint8_t* in, size_t in_sz, record& out, size_t& consumed) const noexcept {
+        if (MARKET_UNLIKELY(in_sz == 0)) { consumed = 0; return status::short_buffer; }
+        const int m = identify(in, in_sz);
+        if (MARKET_UNLIKELY(m < 0)) { consumed = 0; return status::unknown_type; }
+        return decode_as(static_cast<size_t>(m), in, in_sz, out, consumed);
+    }
+
+    status decode(Bytes in, record& out, size_t& consumed) const noexcept {
+        return decode(in.data(), in.size(), out, consumed);
+    }
+
+    // Decode `in` as message index `msg` (for messages without a discriminator).
+    status decode_as(size_t msg, const uint8_t* in, size_t in_sz, record& out, size_t& consumed) const noexcept {
+        const program& pr = programs_[msg];
+        out.message = static_cast<uint16_t>(msg);
+        out.base = in;
+        size_t offset = 0;
+
+        if (pr.fixed) {
+            // Fast path: one bounds check, then straight-line field extraction.
+            if (MARKET_UNLIKELY(in_sz < pr.fixed_size)) { consumed = 0; return status::short_buffer; }
+            out.absent = {};
+            for (const op& o : pr.ops) {
+                if (MARKET_UNLIKELY(!extract(o, in, offset, out.values[o.slot]))) {
+                    consumed = 0;
+                    return o.value_status;
+                }
+                offset += o.size;
+            }
+        } else {
+            out.absent = {};
+            uint64_t presence = 0;
+            for (const op& o : pr.ops) {
+                if (o.flags & field_flag::optional) {
+                    if ((presence & (1ULL << o.optional_bit)) == 0) {
+                        out.values[o.slot] = 0;
+                        out.absent[o.slot / 64] |= 1ULL << (o.slot % 64);
+                        continue;
+                    }
+                }
+                if (MARKET_UNLIKELY(offset + o.size > in_sz)) { consumed = 0; return status::short_buffer; }
+                if (MARKET_UNLIKELY(!extract(o, in, offset, out.values[o.slot]))) {
+                    consumed = 0;
+                    return o.value_status;
+                }
+                if (o.flags & field_flag::presence_map) presence = out.values[o.slot];
+                offset += o.size;
+                if (o.code >= op_var8 && MARKET_UNLIKELY(!skip_data(out.values[o.slot], in_sz, offset))) {
+                    consumed = 0;
+                    return status::short_buffer;
+                }
+            }
+
+            size_t slot = pr.ops.size();
+            for (size_t g = 0; g < pr.groups.size(); ++g) {
+                const group_program& gp = pr.groups[g];
+                const size_t entries = static_cast<size_t>(out.values[gp.count_slot]);
+                const size_t width = gp.ops.size();
+                // Divide rather than multiply: a forged u64 count must not wrap past the check
+                if (MARKET_UNLIKELY(g >= record::kMaxGroups ||
+                                    (width != 0 && entries > (record::kMaxValues - slot) / width))) {
+                    consumed = 0;
+                    return status::bad_value;
+                }
+                out.group_first[g] = static_cast<uint16_t>(slot);
+                out.group_entries[g] = static_cast<uint16_t>(entries);
+                out.group_width[g] = static_cast<uint16_t>(width);
+                for (size_t e = 0; width != 0 && e < entries; ++e) {
+                    for (const op& o : gp.ops) {
+                        const size_t s = slot + o.slot;
+                        if ((o.flags & field_flag::optional) && (presence & (1ULL << o.optional_bit)) == 0) {
+                            out.values[s] = 0;
+                            out.absent[s / 64] |= 1ULL << (s % 64);
+                            continue;
+                        }
+                        if (MARKET_UNLIKELY(offset + o.size > in_sz)) { consumed = 0; return status::short_buffer; }
+                        if (MARKET_UNLIKELY(!extract(o, in, offset, out.values[s]))) {
+                            consumed = 0;
+                            return o.value_status;
+                        }
+                        offset += o.size;
+                        if (o.code >= op_var8 && MARKET_UNLIKELY(!skip_data(out.values[s], in_sz, offset))) {
+                            consumed = 0;
+                            return status::short_buffer;
+                        }
+                    }
+                    slot += width;
+                }
+            }
+            out.used = static_cast<uint16_t>(slot);
+        }
+        if (pr.fixed) out.used = static_cast<uint16_t>(pr.ops.size());
+
+        if (pr.length_slot != no_index) {
+            const op& l = pr.ops[pr.length_slot];
+            const uint64_t mask = l.size >= 8 ? ~0ULL : ((1ULL << (l.size * 8)) - 1);
+            if (MARKET_UNLIKELY(out.values[pr.length_slot] != (static_cast<uint64_t>(offset) & mask))) {
+                consumed = 0;
+                return status::bad_value;
+            }
+        }
+        consumed = offset;
+        return status::ok;
+    }
+
+private:
+    enum opcode : uint8_t {
+        op_u8,
+        op_u16le,
+        op_u16be,
+        op_u32le,
+        op_u32be,
+        op_u64le,
+        op_u64be,
+        op_chars,
+        // Length-prefixed data (vstring/bytes); must stay last
+        op_var8,
+        op_var16le,
+        op_var16be,
+    };
+
+    struct op {
+        opcode code{op_u8};
+        uint8_t flags{0};
+        uint8_t optional_bit{0};
+        status value_status{status::bad_value};  // returned when a constant check fails
+        uint16_t size{0};
+        uint16_t slot{0};
+        uint64_t value{0};
+    };
+
+    struct group_program {
+        uint16_t count_slot{0};
+        std::vector<op> ops;
+    };
+
+    struct program {
+        std::vector<op> ops;
+        std::vector<group_program> groups;
+        bool fixed{true};
+        size_t fixed_size{0};
+        uint16_t length_slot{no_index};
+        uint16_t disc_slot{no_index};
+        uint32_t disc_offset{0};
+    };
+
+    static op compile_field(const field_desc& f, uint16_t slot) {
+        op o;
+        o.flags = f.flags;
+        o.optional_bit = f.optional_bit;
+        o.size = f.size;
+        o.slot = slot;
+        o.value = f.value;
+        // A discriminating enum (BOE MessageType) mismatch means "wrong message",
+        // any other constant mismatch is a malformed field.
+        if ((f.flags & field_flag::discriminator) && f.kind == field_kind::enumeration) {
+            o.value_status = status::unknown_type;
+        }
+        const bool be = (f.flags & field_flag::big_endian) != 0;
+        if (f.kind == field_kind::vstring || f.kind == field_kind::bytes) {
+            o.code = f.size == 1 ? op_var8 : (be ? op_var16be : op_var16le);
+            o.flags &= static_cast<uint8_t>(~field_flag::has_value);
+        } else if (f.kind == field_kind::chars && f.size > 1) {
+            o.code = op_chars;
+            // Multi-byte char arrays carry no constant check.
+            o.flags &= static_cast<uint8_t>(~field_flag::has_value);
+        } else {
+            switch (f.size) {
+                case 1: o.code = op_u8; break;
+                case 2: o.code = be ? op_u16be : op_u16le; break;
+                case 4: o.code = be ? op_u32be : op_u32le; break;
+                case 8: o.code = be ? op_u64be : op_u64le; break;
+                default: o.code = op_chars; break;
+            }
+        }
+        return o;
+    }
+
+    static program compile(const message_desc& md) {
+        program pr;
+        uint32_t offset = 0;
+        bool static_offset = true;
+        for (size_t i = 0; i < md.fields.size(); ++i) {
+            const field_desc& f = md.fields[i];
+            op o = compile_field(f, static_cast<uint16_t>(i));
+            if (f.flags & field_flag::optional) {
+                pr.fixed = false;
+                static_offset = false;
+            }
+            if (i == md.discriminator && static_offset) {
+                pr.disc_slot = static_cast<uint16_t>(i);
+                pr.disc_offset = offset;
+            }
+            if (o.code >= op_var8) {
+                pr.fixed = false;
+                static_offset = false;
+            }
+            if (f.flags & field_flag::length) pr.length_slot = static_cast<uint16_t>(i);
+            offset += f.size;
+            pr.ops.push_back(o);
+        }
+        for (const group_desc& gd : md.groups) {
+            group_program gp;
+            gp.count_slot = gd.count_field;
+            for (size_t i = 0; i < gd.fields.size(); ++i) {
+                gp.ops.push_back(compile_field(gd.fields[i], static_cast<uint16_t>(i)));
+            }
+            pr.groups.push_back(std::move(gp));
+            pr.fixed = false;
+        }
+        pr.fixed_size = offset;
+        return pr;
+    }
+
+    static uint64_t read_uint(const op& o, const uint8_t* p) noexcept {
+        switch (o.code) {
+            case op_u8:    return p[0];
+            case op_u16le: return load_le<uint16_t>(p);
+            case op_u16be: return load_be<uint16_t>(p);
+            case op_u32le: return load_le<uint32_t>(p);
+            case op_u32be: return load_be<uint32_t>(p);
+            case op_u64le: return load_le<uint64_t>(p);
+            case op_u64be: return load_be<uint64_t>(p);
+            default:       return 0;
+        }
+    }
+
+    MARKET_ALWAYS_INLINE static bool extract(const op& o, const uint8_t* in, size_t offset, uint64_t& v) noexcept {
+        const uint8_t* p = in + offset;
+        switch (o.code) {
+            case op_u8:    v = p[0]; break;
+            case op_u16le: v = load_le<uint16_t>(p); break;
+            case op_u16be: v = load_be<uint16_t>(p); break;
+            case op_u32le: v = load_le<uint32_t>(p); break;
+            case op_u32be: v = load_be<uint32_t>(p); break;
+            case op_u64le: v = load_le<uint64_t>(p); break;
+            case op_u64be: v = load_be<uint64_t>(p); break;
+            case op_chars: v = static_cast<uint64_t>(offset) | (static_cast<uint64_t>(o.size) << 32); return true;
+            // The descriptor value of a vstring/bytes field is its maximum length.
+            case op_var8:    v = pack_var(offset + 1, p[0]); return (v >> 32) <= o.value;
+            case op_var16le: v = pack_var(offset + 2, load_le<uint16_t>(p)); return (v >> 32) <= o.value;
+            case op_var16be: v = pack_var(offset + 2, load_be<uint16_t>(p)); return (v >> 32) <= o.value;
+        }
+        return (o.flags & field_flag::has_value) == 0 || v == o.value;
+    }
+
+    static uint64_t pack_var(size_t data_offset, size_t len) noexcept {
+        return static_cast<uint64_t>(data_offset) | (static_cast<uint64_t>(len) << 32);
+    }
+
+    // Step over the data of a length-prefixed field whose prefix was just read.
+    MARKET_ALWAYS_INLINE static bool skip_data(uint64_t v, size_t in_sz, size_t& offset) noexcept {
+        offset += static_cast<size_t>(v >> 32);
+        return offset <= in_sz;
+    }
+
+    const schema& schema_;
+    std::vector<program> programs_;
+    std::array<int16_t, 256> by_type_{};
+    uint32_t type_offset_{UINT32_MAX};
+};
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "runtime/config.hpp"
+
+namespace market::runtime {
+
+// Single-writer sequence lock.
+//
+// The writer never blocks: it bumps the sequence to odd, stores the payload and
+// bumps it back to even. Readers copy the payload and retry if the sequence was
+// odd or changed underneath them, so they never write to the shared cache line.
+// The payload lives in atomic words stored with release and loaded with acquire
+// ordering: that keeps concurrent copies well-defined without standalone fences
+// (which TSAN cannot model) and compiles to plain moves on x86.
+template<typename T>
+class seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock payload must be trivially copyable");
+
+public:
+    static constexpr size_t kWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    // Writer side. Must only ever be called from one thread.
+    void store(const T& value) noexcept {
+        uint64_t words[kWords]{};
+        std::memcpy(words, &value, sizeof(T));
+
+        const uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        for (size_t i = 0; i < kWords; ++i) {
+            data_[i].store(words[i], std::memory_order_release);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Reader side. Returns false if a write was in progress or raced the copy.
+    bool try_load(T& out) const noexcept {
+        uint64_t version;
+        return try_load(out, version);
+    }
+
+    // As above, also returning the version of the snapshot that was copied.
+    bool try_load(T& out, uint64_t& version) const noexcept {
+        const uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        uint64_t words[kWords];
+        for (size_t i = 0; i < kWords; ++i) {
+            words[i] = data_[i].load(std::memory_order_acquire);
+        }
+        if (seq_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&out, words, sizeof(T));
+        version = before;
+        return true;
+    }
+
+    // Reader side. Spins until a consistent snapshot is obtained.
+    T load() const noexcept {
+        T out;
+        while (!try_load(out)) {
+            MARKET_CPU_RELAX();
+        }
+        return out;
+    }
+
+    T load(uint64_t& version) const noexcept {
+        T out;
+        while (!try_load(out, version)) {
+            MARKET_CPU_RELAX();
+        }
+        return out;
+    }
+
+    // Even values count completed writes; pollers can skip unchanged snapshots.
+    uint64_t version() const noexcept { return seq_.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint64_t> seq_{0};
+    std::atomic<uint64_t> data_[kWords]{};
+};
+
+}
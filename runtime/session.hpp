@@ -0,0 +1,640 @@
+#pragma once
+
+// Order-entry client session over a connected stream socket.
+//
+// session<Traits> sits on a protocol's generated Encoder and dispatcher (the
+// generated session.hpp supplies Traits, e.g. cboe::boe::v3::SessionTraits)
+// and does the work every order-entry client otherwise rebuilds:
+//
+//   login       login() sends the login message; the login response makes the
+//               session active (or rejected).
+//   sequencing  queue()/send() stamp messages that carry a sequence number
+//               with the next outbound number.
+//   replay      sequenced messages stay in the send ring after they are sent.
+//               When a login response reports fewer messages received than
+//               were sent (a reconnect), the rest are resent from the ring,
+//               as the socket takes them, by flush() / poll().
+//   heartbeats  poll() sends a heartbeat after heartbeat_ns without output.
+//   inbound     poll() reads the socket and dispatches each frame through the
+//               protocol dispatcher to the caller's handler, after the session
+//               has looked at it (login response, heartbeats, sequence gaps).
+//
+// The send path neither allocates nor copies: a message is encoded straight
+// into a pre-allocated, pre-faulted ring and those bytes are what the kernel is
+// given. Flushes of at least zerocopy_min bytes use MSG_ZEROCOPY where the
+// kernel supports it (Linux); the bytes are then kept until the completion
+// notification arrives.
+//
+// Time is supplied by the caller (poll(h, now_ns)), so the hot path makes no
+// clock calls. The session does not own the socket: attach() a connected one,
+// close it yourself, attach() the next after a reconnect.
+//
+// Stream framing: every message is preceded by a big-endian u16 length, the
+// framing dispatch_*_framed reads. It also delimits BOE messages that carry
+// no unit header.
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "runtime/bytes.hpp"
+#include "runtime/config.hpp"
+#include "runtime/dispatch.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/status.hpp"
+#include "runtime/warmup.hpp"
+
+#if defined(__linux__) && defined(MSG_ZEROCOPY) && defined(SO_ZEROCOPY)
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#define MARKET_HAS_ZEROCOPY 1
+#else
+#define MARKET_HAS_ZEROCOPY 0
+#endif
+
+namespace market::runtime {
+
+inline constexpr size_t kFramePrefix = 2;
+inline constexpr size_t kMaxFramePayload = 0xFFFF;
+
+namespace detail {
+
+#if defined(MSG_NOSIGNAL)
+inline constexpr int kSendFlags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#else
+inline constexpr int kSendFlags = MSG_DONTWAIT;
+#endif
+
+inline bool would_block(int err) noexcept { return err == EAGAIN || err == EWOULDBLOCK || err == EINTR; }
+
+inline size_t round_up_pow2(size_t n) noexcept {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+}  // namespace detail
+
+// Reassembles u16 BE length-prefixed frames from a stream socket.
+class frame_reader {
+public:
+    explicit frame_reader(size_t capacity = 256 * 1024)
+        : buf_(std::max(capacity, 2 * (kFramePrefix + kMaxFramePayload))) {}
+
+    // Next complete frame (a view into the reader, valid until the next
+    // fill()), or short_buffer when more bytes are needed.
+    status next(Bytes& frame) noexcept {
+        if (tail_ - head_ < kFramePrefix) return status::short_buffer;
+        const size_t len = load_be<uint16_t>(buf_.data() + head_);
+        if (tail_ - head_ < kFramePrefix + len) return status::short_buffer;
+        frame = Bytes{buf_.data() + head_ + kFramePrefix, len};
+        head_ += kFramePrefix + len;
+        return status::ok;
+    }
+
+    // One recv() into the free space: bytes read, 0 when nothing was ready
+    // (non-blocking), -1 when the peer closed or the socket failed.
+    ssize_t fill(int fd, bool nonblocking) noexcept {
+        if (head_ == tail_) {
+            head_ = tail_ = 0;
+        } else if (buf_.size() - tail_ < kFramePrefix + kMaxFramePayload) {
+            std::memmove(buf_.data(), buf_.data() + head_, tail_ - head_);
+            tail_ -= head_;
+            head_ = 0;
+        }
+        const ssize_t n = ::recv(fd, buf_.data() + tail_, buf_.size() - tail_, nonblocking ? MSG_DONTWAIT : 0);
+        if (n > 0) {
+            tail_ += static_cast<size_t>(n);
+            return n;
+        }
+        if (n < 0 && detail::would_block(errno)) return 0;
+        return -1;
+    }
+
+    // Drop buffered bytes (a new connection).
+    void reset() noexcept { head_ = tail_ = 0; }
+
+private:
+    std::vector<uint8_t> buf_;
+    size_t head_ = 0;
+    size_t tail_ = 0;
+};
+
+// Outbound byte ring in one anonymous mapping, populated and touched up front
+// so the first sends do not fault. Positions are byte offsets that only grow;
+// a frame never straddles the end of the ring (the remainder of the lap is
+// skipped instead), so every frame is one contiguous span for the encoder.
+class send_ring {
+public:
+    explicit send_ring(size_t capacity) noexcept : cap_(detail::round_up_pow2(std::max<size_t>(capacity, 4096))) {
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_POPULATE)
+        flags |= MAP_POPULATE;
+#endif
+        void* p = ::mmap(nullptr, cap_, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (p == MAP_FAILED) return;
+        base_ = static_cast<uint8_t*>(p);
+        prefault(MutBytes{base_, cap_});
+    }
+
+    ~send_ring() {
+        if (base_) ::munmap(base_, cap_);
+    }
+
+    send_ring(const send_ring&) = delete;
+    send_ring& operator=(const send_ring&) = delete;
+
+    bool valid() const noexcept { return base_ != nullptr; }
+    size_t capacity() const noexcept { return cap_; }
+
+    // Room for a frame of up to `need` bytes, or nullptr when it would
+    // overwrite anything from position `keep` on.
+    uint8_t* reserve(size_t need, uint64_t keep) noexcept {
+        uint64_t pos = head_;
+        const size_t off = static_cast<size_t>(pos & (cap_ - 1));
+        if (cap_ - off < need) pos += cap_ - off;
+        if (pos + need - keep > cap_) return nullptr;
+        reserved_ = pos;
+        return base_ + (pos & (cap_ - 1));
+    }
+
+    // Publish `n` bytes written at the last reservation; returns their position.
+    uint64_t commit(size_t n) noexcept {
+        if (reserved_ != head_) {
+            // Unsent bytes span at most one lap boundary, so one skip is enough
+            skip_from_ = head_;
+            skip_to_ = reserved_;
+        }
+        head_ = reserved_ + n;
+        return reserved_;
+    }
+
+    // Longest contiguous run of committed bytes not yet handed to the kernel.
+    Bytes unsent() noexcept {
+        if (sent_ == skip_from_) sent_ = skip_to_;
+        const uint64_t end = (skip_from_ > sent_ && skip_from_ < head_) ? skip_from_ : head_;
+        const size_t off = static_cast<size_t>(sent_ & (cap_ - 1));
+        return Bytes{base_ + off, std::min<size_t>(static_cast<size_t>(end - sent_), cap_ - off)};
+    }
+
+    void advance(size_t n) noexcept { sent_ += n; }
+
+    // Forget unsent bytes (the connection they were meant for is gone).
+    void discard_unsent() noexcept {
+        sent_ = head_;
+        skip_from_ = skip_to_ = ~uint64_t{0};
+    }
+
+    const uint8_t* at(uint64_t pos) const noexcept { return base_ + (pos & (cap_ - 1)); }
+    uint64_t head() const noexcept { return head_; }
+    uint64_t sent() const noexcept { return sent_; }
+    size_t pending() const noexcept { return static_cast<size_t>(head_ - sent_); }
+
+private:
+    uint8_t* base_ = nullptr;
+    size_t cap_;
+    uint64_t head_ = 0;
+    uint64_t sent_ = 0;
+    uint64_t reserved_ = 0;
+    uint64_t skip_from_ = ~uint64_t{0};
+    uint64_t skip_to_ = ~uint64_t{0};
+};
+
+struct session_config {
+    size_t ring_bytes = 1 << 20;          // send ring (rounded up to a power of two)
+    size_t replay_slots = 1 << 14;        // sequenced messages kept for replay (power of two)
+    size_t max_message = 1024;            // largest encoded outbound message
+    uint64_t heartbeat_ns = 1'000'000'000;
+    uint64_t peer_timeout_ns = 3'000'000'000;
+    size_t zerocopy_min = 0;              // MSG_ZEROCOPY for flushes of at least this many bytes; 0 = off
+};
+
+enum class session_state {
+    disconnected,  // no socket attached, or the peer went away
+    logging_in,    // login sent, waiting for the response
+    active,        // login accepted: messages may be sent
+    rejected       // login refused
+};
+
+struct session_stats {
+    uint64_t messages_sent = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t heartbeats_sent = 0;
+    uint64_t heartbeats_received = 0;
+    uint64_t messages_received = 0;
+    uint64_t inbound_errors = 0;      // frames the dispatcher rejected
+    uint64_t inbound_gaps = 0;        // missing inbound sequence numbers
+    uint64_t replayed = 0;            // messages resent after a login
+    uint64_t unreplayable = 0;        // requested by a login but already evicted from the ring
+    uint64_t zerocopy_sends = 0;
+    uint64_t zerocopy_copied = 0;     // completions where the kernel copied after all
+};
+
+// Traits (see the generated session.hpp):
+//   login_type, login_response_type, heartbeat_type
+//   template<class M> static constexpr bool sequenced
+//   set_sequence(M&, uint64_t) / sequence(const M&) for sequenced messages
+//   accepted(const login_response_type&), last_received(const login_response_type&)
+//   heartbeat() -> heartbeat_type
+//   encode(const M&, uint8_t*, size_t, size_t&), dispatch(Bytes, H&, size_t&)
+template<class Traits>
+class session {
+public:
+    explicit session(const session_config& cfg = {})
+        : cfg_(cfg),
+          ring_(cfg.ring_bytes),
+          replay_mask_(detail::round_up_pow2(std::max<size_t>(cfg.replay_slots, 1)) - 1),
+          replay_pos_(replay_mask_ + 1),
+          replay_len_(replay_mask_ + 1) {
+        cfg_.max_message = std::min(cfg_.max_message, kMaxFramePayload);
+        prefault(MutBytes{reinterpret_cast<uint8_t*>(replay_pos_.data()), replay_pos_.size() * sizeof(uint64_t)});
+    }
+
+    session(const session&) = delete;
+    session& operator=(const session&) = delete;
+
+    // False if the send ring could not be mapped or cannot hold two frames.
+    bool valid() const noexcept { return ring_.valid() && ring_.capacity() >= 2 * frame_room(); }
+
+    // Use a connected socket (made non-blocking). Unsent bytes from the
+    // previous connection are dropped; sequenced ones are still replayable.
+    status attach(int fd) noexcept {
+        if (fd < 0 || !valid()) return status::bad_value;
+        const int fl = ::fcntl(fd, F_GETFL, 0);
+        if (fl < 0 || ::fcntl(fd, F_SETFL, fl | O_NONBLOCK) != 0) return status::bad_value;
+        fd_ = fd;
+        state_ = session_state::disconnected;
+        ring_.discard_unsent();
+        rx_.reset();
+        replay_seq_ = replay_end_ = 0;  // the next login response asks again
+        replay_off_ = 0;
+        expected_in_ = 0;
+        zc_reset();
+#if MARKET_HAS_ZEROCOPY
+        int one = 1;
+        zc_enabled_ = cfg_.zerocopy_min > 0 && ::setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == 0;
+#endif
+        return status::ok;
+    }
+
+    // Send the login message; poll() then delivers the response.
+    status login(const typename Traits::login_type& m) noexcept {
+        if (fd_ < 0) return status::bad_value;
+        const status st = encode_frame(m);
+        if (st != status::ok) return st;
+        state_ = session_state::logging_in;
+        return flush();
+    }
+
+    // Encode into the send ring without sending. Sequenced messages get the
+    // next outbound number (written back into `m`). Needs an active session;
+    // short_buffer means the ring is full of bytes that are still needed, or
+    // a replay is still going out (nothing may overtake it).
+    template<class M>
+    status queue(M& m) noexcept {
+        if (MARKET_UNLIKELY(state_ != session_state::active)) return status::bad_value;
+        if (MARKET_UNLIKELY(replaying())) return status::short_buffer;
+        if constexpr (Traits::template sequenced<M>) {
+            Traits::set_sequence(m, next_seq_);
+            uint64_t pos = 0;
+            size_t len = 0;
+            const status st = encode_frame(m, &pos, &len);
+            if (st != status::ok) return st;
+            if (next_seq_ - oldest_seq_ > replay_mask_) ++oldest_seq_;  // replay index full
+            replay_pos_[next_seq_ & replay_mask_] = pos;
+            replay_len_[next_seq_ & replay_mask_] = static_cast<uint32_t>(len);
+            ++next_seq_;
+            return status::ok;
+        } else {
+            return encode_frame(m);
+        }
+    }
+
+    // queue() then flush(). Bytes the socket does not take now stay queued
+    // and go out on the next flush() / poll().
+    template<class M>
+    status send(M& m) noexcept {
+        const status st = queue(m);
+        return st == status::ok ? flush() : st;
+    }
+
+    // Hand queued bytes, then any replay in progress, to the kernel until it
+    // stops taking them. bad_value means the connection failed (state() is
+    // then disconnected).
+    status flush() noexcept {
+        if (fd_ < 0) return status::bad_value;
+        // A partly resent message is finished before anything else goes out
+        if (replay_off_ != 0) {
+            const status st = resend(true);
+            if (st != status::ok || replay_off_ != 0) return st;
+        }
+        const status st = flush_queued();
+        if (st != status::ok || ring_.pending() != 0 || !replaying()) return st;
+        return resend(false);
+    }
+
+    // Read and dispatch whatever has arrived, send a heartbeat if due and
+    // flush. Every inbound message reaches `h` (on(const M&) for the types it
+    // handles). bad_value once the connection is gone.
+    template<class H>
+    status poll(H& h, uint64_t now_ns) noexcept {
+        if (fd_ < 0) return status::bad_value;
+        if (sent_since_poll_ || last_send_ns_ == 0) last_send_ns_ = now_ns;
+        if (last_recv_ns_ == 0) last_recv_ns_ = now_ns;
+        sent_since_poll_ = false;
+        zc_reap();
+
+        const ssize_t got = rx_.fill(fd_, true);
+        inbound<H> in{*this, h};
+        Bytes frame;
+        while (rx_.next(frame) == status::ok) {
+            size_t consumed = 0;
+            if (Traits::dispatch(frame, in, consumed) == status::ok) {
+                ++stats_.messages_received;
+            } else {
+                ++stats_.inbound_errors;
+            }
+            last_recv_ns_ = now_ns;
+        }
+        if (got < 0) {
+            state_ = session_state::disconnected;
+            return status::bad_value;
+        }
+
+        if (state_ == session_state::active && now_ns - last_send_ns_ >= cfg_.heartbeat_ns) {
+            const auto hb = Traits::heartbeat();
+            if (encode_frame(hb) == status::ok) {
+                ++stats_.heartbeats_sent;
+                last_send_ns_ = now_ns;
+            }
+        }
+        return flush();
+    }
+
+    // Resend retained sequenced messages from `from_seq` on, after anything
+    // still queued. Sends what the socket takes now; flush() / poll() send the
+    // rest, and queue() holds back until replaying() is false. bad_value if
+    // `from_seq` has been evicted from the ring or the connection fails;
+    // short_buffer if another replay is still going out.
+    status replay(uint64_t from_seq) noexcept {
+        if (from_seq < oldest_seq_ || from_seq > next_seq_ || fd_ < 0) return status::bad_value;
+        if (replaying()) return status::short_buffer;
+        replay_seq_ = from_seq;
+        replay_end_ = next_seq_;
+        replay_off_ = 0;
+        return flush();
+    }
+
+    // Retained messages requested by replay() (or a login response) that
+    // have not all been handed to the kernel yet.
+    bool replaying() const noexcept { return replay_seq_ != replay_end_; }
+
+    // Nothing received for peer_timeout_ns (as of the last poll()).
+    bool peer_silent(uint64_t now_ns) const noexcept {
+        return last_recv_ns_ != 0 && now_ns > last_recv_ns_ + cfg_.peer_timeout_ns;
+    }
+
+    session_state state() const noexcept { return state_; }
+    uint64_t next_seq() const noexcept { return next_seq_; }
+    uint64_t oldest_replayable() const noexcept { return oldest_seq_; }
+    size_t pending_bytes() const noexcept { return ring_.pending(); }
+    bool zerocopy() const noexcept { return zc_enabled_; }
+    const session_stats& stats() const noexcept { return stats_; }
+
+private:
+    // Wraps the caller's handler: the session sees every message first.
+    template<class H>
+    struct inbound {
+        session& s;
+        H& h;
+
+        template<class M>
+        void on(const M& m) {
+            s.observe(m);
+            deliver(h, m);
+        }
+    };
+
+    template<class M>
+    void observe(const M& m) noexcept {
+        if constexpr (std::is_same_v<M, typename Traits::login_response_type>) {
+            if (!Traits::accepted(m)) {
+                state_ = session_state::rejected;
+                return;
+            }
+            state_ = session_state::active;
+            // The peer has everything up to last_received; resend the rest
+            uint64_t from = Traits::last_received(m) + 1;
+            if (from < oldest_seq_) {
+                stats_.unreplayable += oldest_seq_ - from;
+                from = oldest_seq_;
+            }
+            if (from < next_seq_ && replay(from) != status::ok) state_ = session_state::disconnected;
+        } else if constexpr (std::is_same_v<M, typename Traits::server_heartbeat_type>) {
+            ++stats_.heartbeats_received;
+        }
+        if constexpr (Traits::template sequenced<M>) {
+            const uint64_t seq = Traits::sequence(m);
+            if (expected_in_ != 0 && seq > expected_in_) stats_.inbound_gaps += seq - expected_in_;
+            if (seq >= expected_in_) expected_in_ = seq + 1;
+        }
+    }
+
+    size_t frame_room() const noexcept { return kFramePrefix + cfg_.max_message; }
+
+    // Lowest ring position still needed for I/O: unsent, still to be
+    // replayed, or zero-copy in flight.
+    uint64_t keep_io() const noexcept {
+        uint64_t k = ring_.sent();
+        if (replaying()) k = std::min(k, replay_pos_[replay_seq_ & replay_mask_]);
+#if MARKET_HAS_ZEROCOPY
+        if (zc_done_ != zc_next_) k = std::min(k, zc_start_[zc_done_ & (kZeroCopySlots - 1)]);
+#endif
+        return k;
+    }
+
+    // Room for one frame. Messages retained for replay give way, oldest
+    // first; bytes still needed for I/O do not (short_buffer).
+    uint8_t* reserve_frame() noexcept {
+        for (bool reaped = false;;) {
+            const uint64_t io = keep_io();
+            const bool retained = oldest_seq_ != next_seq_ && replay_pos_[oldest_seq_ & replay_mask_] < io;
+            uint8_t* p = ring_.reserve(frame_room(), retained ? replay_pos_[oldest_seq_ & replay_mask_] : io);
+            if (MARKET_LIKELY(p != nullptr)) return p;
+            if (retained) {
+                ++oldest_seq_;
+            } else if (!reaped && zc_enabled_) {
+                zc_reap();
+                reaped = true;
+            } else {
+                return nullptr;
+            }
+        }
+    }
+
+    // The ring's unsent bytes; ok with some left when the socket is full.
+    status flush_queued() noexcept {
+        for (;;) {
+            const Bytes run = ring_.unsent();
+            if (run.empty()) return status::ok;
+            bool zc = false;
+#if MARKET_HAS_ZEROCOPY
+            zc = zc_enabled_ && run.size() >= cfg_.zerocopy_min && zc_next_ - zc_done_ < kZeroCopySlots;
+#endif
+            ssize_t n = send_raw(run, zc);
+            if (n < 0 && zc && errno == ENOBUFS) {
+                zc = false;  // out of option memory for pinned pages: copy this one
+                n = send_raw(run, false);
+            }
+            if (n < 0) {
+                if (detail::would_block(errno)) return status::ok;
+                state_ = session_state::disconnected;
+                return status::bad_value;
+            }
+#if MARKET_HAS_ZEROCOPY
+            if (zc) {
+                zc_start_[zc_next_ & (kZeroCopySlots - 1)] = ring_.sent();
+                zc_flag_[zc_next_ & (kZeroCopySlots - 1)] = false;
+                ++zc_next_;
+                ++stats_.zerocopy_sends;
+            }
+#endif
+            ring_.advance(static_cast<size_t>(n));
+            stats_.bytes_sent += static_cast<uint64_t>(n);
+            sent_since_poll_ = true;
+        }
+    }
+
+    // Advance the replay cursor, a whole message at a time so frames never
+    // interleave with queued ones; `current_only` stops after the message in
+    // progress. ok when done or the socket is full.
+    status resend(bool current_only) noexcept {
+        while (replaying()) {
+            const size_t i = replay_seq_ & replay_mask_;
+            const ssize_t n = ::send(fd_, ring_.at(replay_pos_[i]) + replay_off_, replay_len_[i] - replay_off_,
+                                     detail::kSendFlags);
+            if (n < 0) {
+                if (detail::would_block(errno)) return status::ok;
+                state_ = session_state::disconnected;
+                return status::bad_value;
+            }
+            stats_.bytes_sent += static_cast<uint64_t>(n);
+            sent_since_poll_ = true;
+            replay_off_ += static_cast<size_t>(n);
+            if (replay_off_ < replay_len_[i]) continue;
+            replay_off_ = 0;
+            ++replay_seq_;
+            ++stats_.replayed;
+            if (current_only) return status::ok;
+        }
+        return status::ok;
+    }
+
+    template<class M>
+    status encode_frame(const M& m, uint64_t* pos = nullptr, size_t* len = nullptr) noexcept {
+        uint8_t* p = reserve_frame();
+        if (MARKET_UNLIKELY(p == nullptr)) return status::short_buffer;
+        size_t written = 0;
+        const status st = Traits::encode(m, p + kFramePrefix, cfg_.max_message, written);
+        if (st != status::ok) return st;
+        store_be<uint16_t>(p, static_cast<uint16_t>(written));
+        const uint64_t at = ring_.commit(kFramePrefix + written);
+        if (pos) *pos = at;
+        if (len) *len = kFramePrefix + written;
+        ++stats_.messages_sent;
+        return status::ok;
+    }
+
+    ssize_t send_raw(Bytes run, bool zc) noexcept {
+        int flags = detail::kSendFlags;
+#if MARKET_HAS_ZEROCOPY
+        if (zc) flags |= MSG_ZEROCOPY;
+#else
+        (void)zc;
+#endif
+        return ::send(fd_, run.data(), run.size(), flags);
+    }
+
+    void zc_reset() noexcept {
+        zc_enabled_ = false;
+#if MARKET_HAS_ZEROCOPY
+        zc_next_ = zc_done_ = 0;  // the kernel numbers zero-copy sends per socket from 0
+#endif
+    }
+
+    // Collect MSG_ZEROCOPY completions from the socket error queue.
+    void zc_reap() noexcept {
+#if MARKET_HAS_ZEROCOPY
+        while (zc_done_ != zc_next_) {
+            alignas(cmsghdr) char control[128];
+            msghdr msg{};
+            msg.msg_control = control;
+            msg.msg_controllen = sizeof(control);
+            if (::recvmsg(fd_, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) break;
+            for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm != nullptr; cm = CMSG_NXTHDR(&msg, cm)) {
+                if (!((cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) ||
+                      (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)))
+                    continue;
+                sock_extended_err err;
+                std::memcpy(&err, CMSG_DATA(cm), sizeof(err));
+                if (err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY) continue;
+                // Completions cover a range of send ids and may arrive out of order
+                for (uint32_t id = err.ee_info; id - err.ee_info <= err.ee_data - err.ee_info; ++id) {
+                    if (id - zc_done_ < zc_next_ - zc_done_) zc_flag_[id & (kZeroCopySlots - 1)] = true;
+                }
+                if (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) ++stats_.zerocopy_copied;
+            }
+            while (zc_done_ != zc_next_ && zc_flag_[zc_done_ & (kZeroCopySlots - 1)]) ++zc_done_;
+        }
+#endif
+    }
+
+    session_config cfg_;
+    send_ring ring_;
+    frame_reader rx_;
+    int fd_ = -1;
+    session_state state_ = session_state::disconnected;
+    session_stats stats_;
+
+    // Replay index: ring position and length of each retained sequenced message
+    size_t replay_mask_;
+    std::vector<uint64_t> replay_pos_;
+    std::vector<uint32_t> replay_len_;
+    uint64_t next_seq_ = 1;
+    uint64_t oldest_seq_ = 1;
+    uint64_t expected_in_ = 0;  // 0 until the first sequenced inbound message
+
+    // Replay cursor: next message to resend, the end of the range and the
+    // bytes of the next one already sent
+    uint64_t replay_seq_ = 0;
+    uint64_t replay_end_ = 0;
+    size_t replay_off_ = 0;
+
+    uint64_t last_send_ns_ = 0;
+    uint64_t last_recv_ns_ = 0;
+    bool sent_since_poll_ = false;
+
+    bool zc_enabled_ = false;
+#if MARKET_HAS_ZEROCOPY
+    static constexpr uint32_t kZeroCopySlots = 256;
+    uint32_t zc_next_ = 0;  // id the kernel gives the next zero-copy send
+    uint32_t zc_done_ = 0;  // every id below this has completed
+    uint64_t zc_start_[kZeroCopySlots] = {};
+    bool zc_flag_[kZeroCopySlots] = {};
+#endif
+};
+
+}  // namespace market::runtime
+
+#endif
@@ -0,0 +1,325 @@
+#pragma once
+
+// Single-writer, many-reader broadcast ring in POSIX shared memory.
+//
+// A feed-handler process creates the segment and publishes decoded fixed-layout
+// messages (or raw framed bytes); any number of local consumer processes attach
+// by name and read with their own cursors. The data path is plain loads and
+// stores on the mapping: no syscalls, no locks, and readers never write to the
+// segment, so a slow or crashed consumer cannot stall the publisher. A reader
+// that falls more than `capacity` messages behind is told so (overrun) and
+// resynchronises to the oldest message still in the ring.
+//
+// Each slot is a small seqlock: the publisher marks the slot odd while writing
+// and even (encoding the message sequence) once committed; readers copy and
+// re-check, so a slot overwritten mid-copy is detected rather than returned.
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "runtime/config.hpp"
+#include "runtime/status.hpp"
+
+namespace market::runtime {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared-memory ring requires address-free 64-bit atomics");
+
+enum class shm_read_status {
+    ok,       // a message was copied out
+    empty,    // nothing new yet
+    overrun,  // reader was lapped (cursor moved to the oldest available message)
+              // or a corrupt slot was skipped; counted in lost()
+    too_small // output buffer smaller than the message; cursor not advanced
+};
+
+namespace shm_detail {
+    inline constexpr uint64_t kMagic = 0x4D44505348524E47ULL;  // "MDPSHRNG"
+    inline constexpr uint32_t kLayoutVersion = 1;
+
+    struct alignas(64) header {
+        uint64_t magic;
+        uint32_t layout_version;
+        uint32_t slot_payload;    // max payload bytes per slot
+        uint64_t capacity;        // slots, power of two
+        uint64_t slot_stride;     // bytes between slots
+        alignas(64) std::atomic<uint64_t> write_seq;  // messages published so far
+    };
+
+    // Slot layout: [seq][size|type<<32][payload words...]
+    struct slot {
+        std::atomic<uint64_t> seq;
+        std::atomic<uint64_t> meta;
+        std::atomic<uint64_t> words[1];
+    };
+
+    inline size_t round_up(size_t v, size_t a) { return (v + a - 1) / a * a; }
+
+    inline size_t mapping_size(uint64_t capacity, uint64_t stride) {
+        return sizeof(header) + static_cast<size_t>(capacity * stride);
+    }
+
+    // Geometry read from a segment header fits in `bytes`: a power-of-two slot
+    // count, slots large enough for their seq and meta words plus the payload,
+    // and no overflow in capacity * stride. Checked before any slot is addressed.
+    inline bool valid_geometry(uint64_t capacity, uint64_t stride, uint32_t payload, size_t bytes) {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0) return false;
+        if (stride < sizeof(slot) || stride % alignof(slot) != 0) return false;
+        if (uint64_t{payload} + 16 > stride) return false;
+        if (capacity > (SIZE_MAX - sizeof(header)) / stride) return false;
+        return mapping_size(capacity, stride) <= bytes;
+    }
+}
+
+class shm_ring_publisher {
+public:
+    shm_ring_publisher() = default;
+    shm_ring_publisher(const shm_ring_publisher&) = delete;
+    shm_ring_publisher& operator=(const shm_ring_publisher&) = delete;
+    ~shm_ring_publisher() { close(); }
+
+    // Create (or replace) segment `name` (e.g. "/itch_feed") with `capacity` slots
+    // (rounded up to a power of two) of up to `slot_payload` bytes each. Pages are
+    // pre-faulted so the first publishes do not take page faults. A segment left
+    // by an earlier publisher is unlinked, not truncated: its subscribers keep a
+    // valid (now idle) mapping and open() again to follow the new one.
+    status create(const char* name, uint32_t slot_payload, uint64_t capacity) {
+        close();
+        uint64_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        const uint64_t stride = shm_detail::round_up(16 + shm_detail::round_up(slot_payload, 8), 64);
+        const size_t bytes = shm_detail::mapping_size(cap, stride);
+
+        ::shm_unlink(name);
+        int fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) return status::bad_value;
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd);
+            return status::bad_value;
+        }
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return status::bad_value;
+
+        std::memset(p, 0, bytes);  // pre-fault every page
+        auto* h = new (p) shm_detail::header{};
+        h->layout_version = shm_detail::kLayoutVersion;
+        h->slot_payload = static_cast<uint32_t>(stride - 16);
+        h->capacity = cap;
+        h->slot_stride = stride;
+        h->write_seq.store(0, std::memory_order_relaxed);
+        std::atomic_ref<uint64_t>(h->magic).store(shm_detail::kMagic, std::memory_order_release);
+
+        base_ = static_cast<uint8_t*>(p);
+        bytes_ = bytes;
+        hdr_ = h;
+        mask_ = cap - 1;
+        stride_ = stride;
+        seq_ = 0;
+        return status::ok;
+    }
+
+    // Publish `size` bytes tagged with `type`. Returns false if it does not fit a slot.
+    bool publish(const void* data, uint32_t size, uint32_t type = 0) noexcept {
+        if (MARKET_UNLIKELY(size > hdr_->slot_payload)) return false;
+        const uint64_t n = seq_;
+        auto* s = slot_at(n);
+        s->seq.store(2 * n + 1, std::memory_order_relaxed);
+
+        const auto* src = static_cast<const uint8_t*>(data);
+        const size_t full = size / 8;
+        for (size_t i = 0; i < full; ++i) {
+            uint64_t w;
+            std::memcpy(&w, src + i * 8, 8);
+            s->words[i].store(w, std::memory_order_release);
+        }
+        if (size % 8) {
+            uint64_t w = 0;
+            std::memcpy(&w, src + full * 8, size % 8);
+            s->words[full].store(w, std::memory_order_release);
+        }
+        s->meta.store(static_cast<uint64_t>(size) | (static_cast<uint64_t>(type) << 32),
+                      std::memory_order_release);
+        s->seq.store(2 * n + 2, std::memory_order_release);
+        seq_ = n + 1;
+        hdr_->write_seq.store(seq_, std::memory_order_release);
+        return true;
+    }
+
+    // Publish a fixed-layout (trivially copyable) message, e.g. a decoded struct.
+    template<typename T>
+    bool publish(const T& msg, uint32_t type = 0) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "shm ring payloads must be trivially copyable");
+        return publish(&msg, static_cast<uint32_t>(sizeof(T)), type);
+    }
+
+    uint64_t sequence() const noexcept { return seq_; }
+    uint64_t capacity() const noexcept { return hdr_ ? hdr_->capacity : 0; }
+    uint32_t slot_payload() const noexcept { return hdr_ ? hdr_->slot_payload : 0; }
+    bool is_open() const noexcept { return hdr_ != nullptr; }
+
+    // Unmap. The segment name stays until unlink() so late subscribers can drain.
+    void close() noexcept {
+        if (base_) ::munmap(base_, bytes_);
+        base_ = nullptr;
+        hdr_ = nullptr;
+    }
+
+    static void unlink(const char* name) noexcept { ::shm_unlink(name); }
+
+private:
+    shm_detail::slot* slot_at(uint64_t n) const noexcept {
+        return reinterpret_cast<shm_detail::slot*>(base_ + sizeof(shm_detail::header) + (n & mask_) * stride_);
+    }
+
+    uint8_t* base_{nullptr};
+    size_t bytes_{0};
+    shm_detail::header* hdr_{nullptr};
+    uint64_t mask_{0};
+    uint64_t stride_{0};
+    uint64_t seq_{0};
+};
+
+class shm_ring_subscriber {
+public:
+    shm_ring_subscriber() = default;
+    shm_ring_subscriber(const shm_ring_subscriber&) = delete;
+    shm_ring_subscriber& operator=(const shm_ring_subscriber&) = delete;
+    ~shm_ring_subscriber() { close(); }
+
+    // Attach read-only to segment `name`. A new subscriber starts at the live edge
+    // unless `from_oldest` is set, in which case it replays what is still buffered.
+    status open(const char* name, bool from_oldest = false) {
+        close();
+        int fd = ::shm_open(name, O_RDONLY, 0);
+        if (fd < 0) return status::bad_value;
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(shm_detail::header)) {
+            ::close(fd);
+            return status::short_buffer;
+        }
+        const size_t bytes = static_cast<size_t>(st.st_size);
+        void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return status::bad_value;
+
+        auto* h = static_cast<const shm_detail::header*>(p);
+        const uint64_t magic = std::atomic_ref<const uint64_t>(h->magic).load(std::memory_order_acquire);
+        if (magic != shm_detail::kMagic || h->layout_version != shm_detail::kLayoutVersion ||
+            !shm_detail::valid_geometry(h->capacity, h->slot_stride, h->slot_payload, bytes)) {
+            ::munmap(p, bytes);
+            return status::bad_value;
+        }
+        base_ = static_cast<const uint8_t*>(p);
+        bytes_ = bytes;
+        hdr_ = h;
+        mask_ = h->capacity - 1;
+        stride_ = h->slot_stride;
+        payload_ = h->slot_payload;
+        const uint64_t head = h->write_seq.load(std::memory_order_acquire);
+        cursor_ = (from_oldest && head > h->capacity) ? head - h->capacity : (from_oldest ? 0 : head);
+        lost_ = 0;
+        return status::ok;
+    }
+
+    // Copy the next message into `out` (capacity `out_cap`).
+    shm_read_status poll(void* out, uint32_t out_cap, uint32_t& size, uint32_t& type) noexcept {
+        const auto* s = slot_at(cursor_);
+        const uint64_t expect = 2 * cursor_ + 2;
+        const uint64_t before = s->seq.load(std::memory_order_acquire);
+        if (before != expect) {
+            if (before > expect) return resync();
+            return shm_read_status::empty;  // not yet written, or being written
+        }
+        const uint64_t meta = s->meta.load(std::memory_order_acquire);
+        size = static_cast<uint32_t>(meta);
+        type = static_cast<uint32_t>(meta >> 32);
+        if (MARKET_UNLIKELY(size > payload_)) {
+            // Larger than the slot: the segment is corrupt, skip the message
+            if (s->seq.load(std::memory_order_relaxed) != expect) return resync();
+            ++cursor_;
+            ++lost_;
+            return shm_read_status::overrun;
+        }
+        if (MARKET_UNLIKELY(size > out_cap)) return shm_read_status::too_small;
+
+        auto* dst = static_cast<uint8_t*>(out);
+        const size_t full = size / 8;
+        for (size_t i = 0; i < full; ++i) {
+            const uint64_t w = s->words[i].load(std::memory_order_acquire);
+            std::memcpy(dst + i * 8, &w, 8);
+        }
+        if (size % 8) {
+            const uint64_t w = s->words[full].load(std::memory_order_acquire);
+            std::memcpy(dst + full * 8, &w, size % 8);
+        }
+        if (MARKET_UNLIKELY(s->seq.load(std::memory_order_relaxed) != expect)) {
+            return resync();  // overwritten while copying
+        }
+        ++cursor_;
+        return shm_read_status::ok;
+    }
+
+    // Typed poll for fixed-layout messages published with publish<T>().
+    template<typename T>
+    shm_read_status poll(T& out, uint32_t& type) noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "shm ring payloads must be trivially copyable");
+        uint32_t size = 0;
+        return poll(&out, static_cast<uint32_t>(sizeof(T)), size, type);
+    }
+
+    // Next sequence this subscriber will read.
+    uint64_t position() const noexcept { return cursor_; }
+    // Messages published but not yet read by this subscriber.
+    uint64_t lag() const noexcept { return hdr_->write_seq.load(std::memory_order_acquire) - cursor_; }
+    // Messages skipped because this subscriber was lapped.
+    uint64_t lost() const noexcept { return lost_; }
+    bool is_open() const noexcept { return hdr_ != nullptr; }
+
+    void close() noexcept {
+        if (base_) ::munmap(const_cast<uint8_t*>(base_), bytes_);
+        base_ = nullptr;
+        hdr_ = nullptr;
+    }
+
+private:
+    const shm_detail::slot* slot_at(uint64_t n) const noexcept {
+        return reinterpret_cast<const shm_detail::slot*>(base_ + sizeof(shm_detail::header) + (n & mask_) * stride_);
+    }
+
+    shm_read_status resync() noexcept {
+        // Skip to the oldest message that cannot be overwritten by the very next
+        // publish; keep one slot of slack for the one being written.
+        const uint64_t head = hdr_->write_seq.load(std::memory_order_acquire);
+        const uint64_t oldest = head > mask_ ? head - mask_ : 0;
+        if (oldest > cursor_) {
+            lost_ += oldest - cursor_;
+            cursor_ = oldest;
+        }
+        return shm_read_status::overrun;
+    }
+
+    const uint8_t* base_{nullptr};
+    size_t bytes_{0};
+    const shm_detail::header* hdr_{nullptr};
+    uint64_t mask_{0};
+    uint64_t stride_{0};
+    uint32_t payload_{0};  // from the header at open(); bounds every slot's size
+    uint64_t cursor_{0};
+    uint64_t lost_{0};
+};
+
+}
+
+#endif
@@ -0,0 +1,406 @@
+#pragma once
+
+// Feed-handler statistics in a named POSIX shared-memory segment.
+//
+// The feed process creates the segment at startup and registers its counters,
+// gauges, per-status counts and latency histograms by name; external tools
+// (tools/mdp_top) attach read-only and render them. Registration happens
+// before the hot path. After that an update is a relaxed load and store on the
+// entry's own cache lines: no syscalls, no locks, no read-modify-write
+// instructions, and nothing a reader does can slow the writer. Each entry must
+// have a single writing thread.
+//
+// Layout (kLayoutVersion): a header line, max_entries 64-byte descriptors
+// (name, kind, data offset), then each entry's data starting on its own cache
+// line. Descriptors are published by a release store of the entry count, so a
+// reader can attach before, during or after registration. Readers see values
+// without a snapshot protocol: each u64 is read whole, but a histogram's
+// buckets, count and sum may be a few records apart while it is being updated.
+//
+// When the segment cannot be created or is full, registration returns a handle
+// bound to a process-local sink, so instrumented code never needs to check.
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "runtime/config.hpp"
+#include "runtime/histogram.hpp"
+#include "runtime/status.hpp"
+
+namespace market::runtime {
+
+static_assert(std::atomic_ref<uint64_t>::is_always_lock_free,
+              "shared-memory statistics require address-free 64-bit atomics");
+
+enum class stats_kind : uint32_t {
+    counter = 1,        // monotonically increasing u64 (messages, bytes, gaps)
+    gauge = 2,          // current i64 value (queue depth, book size)
+    status_counts = 3,  // one u64 per runtime::status value
+    histogram = 4       // log_histogram<kStatsHistogramSubBits> buckets plus count/sum/min/max
+};
+
+inline constexpr size_t kStatsNameSize = 48;  // including the terminating NUL
+inline constexpr size_t kStatusValues = 4;    // ok, short_buffer, bad_value, unknown_type
+inline constexpr unsigned kStatsHistogramSubBits = 4;
+using stats_log_histogram = log_histogram<kStatsHistogramSubBits>;
+
+namespace stats_detail {
+    inline constexpr uint64_t kMagic = 0x4D44505354415453ULL;  // "MDPSTATS"
+    inline constexpr uint32_t kLayoutVersion = 1;
+
+    struct alignas(64) header {
+        uint64_t magic;
+        uint32_t layout_version;
+        uint32_t max_entries;
+        uint64_t segment_bytes;
+        uint64_t data_offset;  // first entry's data
+        int64_t pid;           // writer process
+        alignas(64) std::atomic<uint32_t> entries;  // descriptors published so far
+        alignas(64) uint64_t heartbeat_ns;          // writer's touch(), steady-clock ns
+    };
+
+    struct alignas(64) descriptor {
+        char name[kStatsNameSize];
+        uint32_t kind;
+        uint32_t sub_bits;  // histograms only
+        uint64_t offset;    // entry data, from the start of the segment
+    };
+    static_assert(sizeof(descriptor) == 64);
+
+    // Histogram data: count, sum, min, max, then the buckets
+    inline constexpr size_t kHistFields = 4;
+    inline constexpr size_t kHistWords = kHistFields + stats_log_histogram::kBuckets;
+
+    inline size_t words_for(stats_kind k) noexcept {
+        switch (k) {
+            case stats_kind::counter:
+            case stats_kind::gauge: return 1;
+            case stats_kind::status_counts: return kStatusValues;
+            case stats_kind::histogram: return kHistWords;
+        }
+        return 0;
+    }
+
+    inline size_t line_bytes(size_t words) noexcept { return (words * 8 + 63) / 64 * 64; }
+
+    // Where unbound handles write: never read, shared by every unbound handle.
+    alignas(64) inline uint64_t sink[kHistWords];
+
+    MARKET_ALWAYS_INLINE uint64_t load(const uint64_t* p) noexcept {
+        return std::atomic_ref<const uint64_t>(*p).load(std::memory_order_relaxed);
+    }
+    MARKET_ALWAYS_INLINE void store(uint64_t* p, uint64_t v) noexcept {
+        std::atomic_ref<uint64_t>(*p).store(v, std::memory_order_relaxed);
+    }
+    MARKET_ALWAYS_INLINE void add(uint64_t* p, uint64_t n) noexcept { store(p, load(p) + n); }
+}
+
+class stats_counter {
+public:
+    stats_counter() noexcept = default;
+    explicit stats_counter(uint64_t* p) noexcept : p_(p) {}
+
+    MARKET_ALWAYS_INLINE void add(uint64_t n = 1) noexcept { stats_detail::add(p_, n); }
+    MARKET_ALWAYS_INLINE void set(uint64_t v) noexcept { stats_detail::store(p_, v); }
+    uint64_t value() const noexcept { return stats_detail::load(p_); }
+    bool bound() const noexcept { return p_ != stats_detail::sink; }
+
+private:
+    uint64_t* p_ = stats_detail::sink;
+};
+
+class stats_gauge {
+public:
+    stats_gauge() noexcept = default;
+    explicit stats_gauge(uint64_t* p) noexcept : p_(p) {}
+
+    MARKET_ALWAYS_INLINE void set(int64_t v) noexcept { stats_detail::store(p_, static_cast<uint64_t>(v)); }
+    int64_t value() const noexcept { return static_cast<int64_t>(stats_detail::load(p_)); }
+    bool bound() const noexcept { return p_ != stats_detail::sink; }
+
+private:
+    uint64_t* p_ = stats_detail::sink;
+};
+
+// Counts of decode / dispatch results by status.
+class stats_status_counts {
+public:
+    stats_status_counts() noexcept = default;
+    explicit stats_status_counts(uint64_t* p) noexcept : p_(p) {}
+
+    MARKET_ALWAYS_INLINE void record(status s, uint64_t n = 1) noexcept {
+        const size_t i = static_cast<size_t>(s);
+        if (MARKET_LIKELY(i < kStatusValues)) stats_detail::add(p_ + i, n);
+    }
+    uint64_t value(status s) const noexcept { return stats_detail::load(p_ + static_cast<size_t>(s)); }
+    bool bound() const noexcept { return p_ != stats_detail::sink; }
+
+private:
+    uint64_t* p_ = stats_detail::sink;
+};
+
+// Latency (or any u64) distribution with log_histogram's buckets.
+class stats_histogram {
+public:
+    stats_histogram() noexcept = default;
+    explicit stats_histogram(uint64_t* p) noexcept : p_(p) {}
+
+    MARKET_ALWAYS_INLINE void record(uint64_t v) noexcept {
+        using namespace stats_detail;
+        add(p_ + kHistFields + stats_log_histogram::index(v), 1);
+        add(p_, 1);
+        add(p_ + 1, v);
+        if (v < load(p_ + 2)) store(p_ + 2, v);
+        if (v > load(p_ + 3)) store(p_ + 3, v);
+    }
+    uint64_t count() const noexcept { return stats_detail::load(p_); }
+    bool bound() const noexcept { return p_ != stats_detail::sink; }
+
+private:
+    uint64_t* p_ = stats_detail::sink;
+};
+
+// Writer side: owns the segment and hands out entry handles.
+class stats_registry {
+public:
+    stats_registry() = default;
+    stats_registry(const stats_registry&) = delete;
+    stats_registry& operator=(const stats_registry&) = delete;
+    ~stats_registry() { close(); }
+
+    // Create (or replace) segment `name` (e.g. "/itch_feed_stats") with room
+    // for `max_entries` entries and `data_bytes` of entry data. Pages are
+    // pre-faulted so the first updates do not take page faults. A segment left
+    // by an earlier writer is unlinked, not truncated, so attached readers
+    // keep their mapping until they open() again.
+    status create(const char* name, uint32_t max_entries = 256, size_t data_bytes = 1 << 20) {
+        close();
+        const size_t data_offset = sizeof(stats_detail::header) + size_t{max_entries} * sizeof(stats_detail::descriptor);
+        const size_t bytes = data_offset + stats_detail::line_bytes(data_bytes / 8);
+
+        ::shm_unlink(name);
+        int fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) return status::bad_value;
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            ::close(fd);
+            return status::bad_value;
+        }
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return status::bad_value;
+
+        std::memset(p, 0, bytes);  // pre-fault every page
+        auto* h = new (p) stats_detail::header{};
+        h->layout_version = stats_detail::kLayoutVersion;
+        h->max_entries = max_entries;
+        h->segment_bytes = bytes;
+        h->data_offset = data_offset;
+        h->pid = static_cast<int64_t>(::getpid());
+        h->entries.store(0, std::memory_order_relaxed);
+        std::atomic_ref<uint64_t>(h->magic).store(stats_detail::kMagic, std::memory_order_release);
+
+        base_ = static_cast<uint8_t*>(p);
+        bytes_ = bytes;
+        hdr_ = h;
+        next_data_ = data_offset;
+        return status::ok;
+    }
+
+    // Register an entry. Names longer than kStatsNameSize - 1 are truncated.
+    stats_counter counter(std::string_view name) { return stats_counter(add(name, stats_kind::counter)); }
+    stats_gauge gauge(std::string_view name) { return stats_gauge(add(name, stats_kind::gauge)); }
+    stats_status_counts status_counts(std::string_view name) {
+        return stats_status_counts(add(name, stats_kind::status_counts));
+    }
+    stats_histogram histogram(std::string_view name) { return stats_histogram(add(name, stats_kind::histogram)); }
+
+    // Liveness for readers: the caller's steady-clock time, a plain store.
+    MARKET_ALWAYS_INLINE void touch(uint64_t now_ns) noexcept {
+        if (hdr_) stats_detail::store(&hdr_->heartbeat_ns, now_ns);
+    }
+
+    uint32_t size() const noexcept { return hdr_ ? hdr_->entries.load(std::memory_order_relaxed) : 0; }
+    bool is_open() const noexcept { return hdr_ != nullptr; }
+
+    // Unmap. The segment stays until unlink() so a reader can show final values.
+    void close() noexcept {
+        if (base_) ::munmap(base_, bytes_);
+        base_ = nullptr;
+        hdr_ = nullptr;
+    }
+
+    static void unlink(const char* name) noexcept { ::shm_unlink(name); }
+
+private:
+    uint64_t* add(std::string_view name, stats_kind kind) noexcept {
+        if (!hdr_) return stats_detail::sink;
+        const uint32_t n = hdr_->entries.load(std::memory_order_relaxed);
+        const size_t need = stats_detail::line_bytes(stats_detail::words_for(kind));
+        if (n == hdr_->max_entries || next_data_ + need > bytes_) return stats_detail::sink;
+
+        auto* d = reinterpret_cast<stats_detail::descriptor*>(base_ + sizeof(stats_detail::header)) + n;
+        const size_t len = name.size() < kStatsNameSize ? name.size() : kStatsNameSize - 1;
+        std::memcpy(d->name, name.data(), len);
+        d->kind = static_cast<uint32_t>(kind);
+        d->sub_bits = kind == stats_kind::histogram ? kStatsHistogramSubBits : 0;
+        d->offset = next_data_;
+        auto* data = reinterpret_cast<uint64_t*>(base_ + next_data_);
+        if (kind == stats_kind::histogram) data[2] = std::numeric_limits<uint64_t>::max();  // min
+        next_data_ += need;
+        hdr_->entries.store(n + 1, std::memory_order_release);
+        return data;
+    }
+
+    uint8_t* base_{nullptr};
+    size_t bytes_{0};
+    stats_detail::header* hdr_{nullptr};
+    size_t next_data_{0};
+};
+
+// Histogram contents copied out of the segment.
+struct stats_histogram_snapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    std::array<uint64_t, stats_log_histogram::kBuckets> buckets{};
+
+    // Upper bound of the bucket holding quantile q, clamped to min/max (as
+    // log_histogram::quantile). Uses the bucket total, which may be ahead of
+    // `count` mid-update.
+    uint64_t quantile(double q) const noexcept {
+        uint64_t total = 0;
+        for (uint64_t b : buckets) total += b;
+        if (total == 0) return 0;
+        if (q <= 0.0) return min;
+        if (q >= 1.0) return max;
+        const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                const uint64_t hi = stats_log_histogram::upper_bound(i);
+                return hi < min ? min : (hi > max ? max : hi);
+            }
+        }
+        return max;
+    }
+
+    double mean() const noexcept { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+};
+
+struct stats_entry {
+    std::string_view name;
+    stats_kind kind;
+    const uint64_t* data;
+};
+
+// Reader side: maps the segment read-only; never writes to it.
+class stats_reader {
+public:
+    stats_reader() = default;
+    stats_reader(const stats_reader&) = delete;
+    stats_reader& operator=(const stats_reader&) = delete;
+    ~stats_reader() { close(); }
+
+    // bad_value if the segment is missing, from another layout version or
+    // inconsistent with its size; short_buffer if it is smaller than a header.
+    status open(const char* name) {
+        close();
+        int fd = ::shm_open(name, O_RDONLY, 0);
+        if (fd < 0) return status::bad_value;
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(stats_detail::header)) {
+            ::close(fd);
+            return status::short_buffer;
+        }
+        const size_t bytes = static_cast<size_t>(st.st_size);
+        void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return status::bad_value;
+
+        auto* h = static_cast<const stats_detail::header*>(p);
+        const uint64_t magic = std::atomic_ref<const uint64_t>(h->magic).load(std::memory_order_acquire);
+        if (magic != stats_detail::kMagic || h->layout_version != stats_detail::kLayoutVersion ||
+            h->segment_bytes > bytes || h->data_offset > h->segment_bytes ||
+            h->data_offset != sizeof(stats_detail::header) + size_t{h->max_entries} * sizeof(stats_detail::descriptor)) {
+            ::munmap(p, bytes);
+            return status::bad_value;
+        }
+        base_ = static_cast<const uint8_t*>(p);
+        bytes_ = bytes;
+        hdr_ = h;
+        return status::ok;
+    }
+
+    // Entries registered so far (grows while the writer registers).
+    uint32_t size() const noexcept {
+        if (!hdr_) return 0;
+        const uint32_t n = hdr_->entries.load(std::memory_order_acquire);
+        return n < hdr_->max_entries ? n : hdr_->max_entries;
+    }
+
+    // Entry i < size(); kind 0 (no valid stats_kind) if its descriptor is corrupt.
+    stats_entry entry(uint32_t i) const noexcept {
+        const auto* d = reinterpret_cast<const stats_detail::descriptor*>(base_ + sizeof(stats_detail::header)) + i;
+        const auto kind = static_cast<stats_kind>(d->kind);
+        const size_t words = stats_detail::words_for(kind);
+        if (words == 0 || d->offset < hdr_->data_offset || d->offset + words * 8 > bytes_ ||
+            (kind == stats_kind::histogram && d->sub_bits != kStatsHistogramSubBits))
+            return {std::string_view(d->name, ::strnlen(d->name, kStatsNameSize)), stats_kind{}, nullptr};
+        return {std::string_view(d->name, ::strnlen(d->name, kStatsNameSize)), kind,
+                reinterpret_cast<const uint64_t*>(base_ + d->offset)};
+    }
+
+    // Counter value, gauge value (as u64) or the first word of other kinds.
+    static uint64_t value(const stats_entry& e) noexcept { return e.data ? stats_detail::load(e.data) : 0; }
+    static int64_t gauge(const stats_entry& e) noexcept { return static_cast<int64_t>(value(e)); }
+
+    static uint64_t status_count(const stats_entry& e, status s) noexcept {
+        return e.kind == stats_kind::status_counts ? stats_detail::load(e.data + static_cast<size_t>(s)) : 0;
+    }
+
+    static bool histogram(const stats_entry& e, stats_histogram_snapshot& out) noexcept {
+        if (e.kind != stats_kind::histogram) return false;
+        out.count = stats_detail::load(e.data);
+        out.sum = stats_detail::load(e.data + 1);
+        out.min = out.count ? stats_detail::load(e.data + 2) : 0;
+        out.max = stats_detail::load(e.data + 3);
+        for (size_t i = 0; i < out.buckets.size(); ++i) {
+            out.buckets[i] = stats_detail::load(e.data + stats_detail::kHistFields + i);
+        }
+        return true;
+    }
+
+    int64_t pid() const noexcept { return hdr_ ? hdr_->pid : 0; }
+    uint64_t heartbeat_ns() const noexcept { return hdr_ ? stats_detail::load(&hdr_->heartbeat_ns) : 0; }
+    bool is_open() const noexcept { return hdr_ != nullptr; }
+
+    void close() noexcept {
+        if (base_) ::munmap(const_cast<uint8_t*>(base_), bytes_);
+        base_ = nullptr;
+        hdr_ = nullptr;
+    }
+
+private:
+    const uint8_t* base_{nullptr};
+    size_t bytes_{0};
+    const stats_detail::header* hdr_{nullptr};
+};
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+
+namespace market::runtime {
+
+// Exchange symbols are 8-byte char fields, left-justified and padded with
+// spaces (ITCH, BOE) or NULs (SBE). symbol_key() turns one into a normalised
+// u64: upper-cased, padding zeroed and loaded big-endian, so "aapl    ",
+// "AAPL\0\0\0\0" and "AAPL    " share a key and keys sort like the symbols.
+// A symbol is valid when it has at least one character and every byte before
+// the padding is printable ASCII (0x20..0x7E, so "BRK A" is fine); invalid
+// symbols get key 0, which no valid symbol produces.
+//
+// symbol_key() is branch-free SWAR on one 8-byte load. The batch form,
+// symbol_keys(), is in runtime/symbol_batch.hpp so that generated message
+// headers, which include this one, do not pull in the SIMD intrinsics.
+
+inline constexpr size_t kSymbolSize = 8;
+
+namespace detail {
+
+inline constexpr uint64_t kSymLow7 = 0x7F7F7F7F7F7F7F7Full;
+inline constexpr uint64_t kSymHigh = 0x8080808080808080ull;
+inline constexpr uint64_t kSymOnes = 0x0101010101010101ull;
+
+// High bit of each byte set when that byte is >= n (1 <= n <= 128).
+constexpr uint64_t bytes_ge(uint64_t x, uint8_t n) noexcept {
+    return (((x & kSymLow7) + kSymOnes * static_cast<uint8_t>(0x80 - n)) | x) & kSymHigh;
+}
+
+// Symbol from its big-endian 8-byte load `x`: normalised key and trimmed length.
+MARKET_ALWAYS_INLINE uint64_t symbol_key_be(uint64_t x, size_t* length) noexcept {
+    // Padding bytes (space or NUL) are the ones that vanish under & ~0x20
+    const uint64_t text = bytes_ge(x & 0xDFDFDFDFDFDFDFDFull, 1);
+    if (MARKET_UNLIKELY(text == 0)) {
+        if (length) *length = 0;
+        return 0;
+    }
+    const unsigned pad = static_cast<unsigned>(std::countr_zero(text)) >> 3;  // trailing padding bytes
+    const uint64_t keep = ~uint64_t{0} << (8 * pad);
+    if (length) *length = kSymbolSize - pad;
+    const uint64_t bad = ((bytes_ge(x, 0x20) ^ kSymHigh) | bytes_ge(x, 0x7F)) & keep;
+    const uint64_t lower = bytes_ge(x, 'a') & ~bytes_ge(x, 'z' + 1);
+    const uint64_t key = (x ^ (lower >> 2)) & keep;
+    return bad ? 0 : key;
+}
+
+}  // namespace detail
+
+// Normalised key of the 8-byte symbol at `p`, 0 if invalid.
+MARKET_ALWAYS_INLINE uint64_t symbol_key(const char* p) noexcept {
+    return detail::symbol_key_be(load_be<uint64_t>(reinterpret_cast<const uint8_t*>(p)), nullptr);
+}
+
+inline uint64_t symbol_key(const std::array<char, kSymbolSize>& s) noexcept { return symbol_key(s.data()); }
+
+// Characters before the padding.
+inline size_t symbol_length(const char* p) noexcept {
+    size_t n = 0;
+    (void)detail::symbol_key_be(load_be<uint64_t>(reinterpret_cast<const uint8_t*>(p)), &n);
+    return n;
+}
+
+inline bool symbol_valid(const char* p) noexcept { return symbol_key(p) != 0; }
+
+// Space-padded symbol for a key (for display and for encoding).
+inline std::array<char, kSymbolSize> symbol_from_key(uint64_t key) noexcept {
+    std::array<char, kSymbolSize> s;
+    store_be<uint64_t>(reinterpret_cast<uint8_t*>(s.data()), key);
+    for (char& c : s) {
+        if (c == '\0') c = ' ';
+    }
+    return s;
+}
+
+}  // namespace market::runtime
@@ -0,0 +1,142 @@
+#pragma once
+
+// symbol_keys(): runtime/symbol.hpp's symbol_key() for a batch, either a column
+// of symbols or a field inside fixed-size records, two symbols per SSE2 vector
+// and four per AVX2 vector when built with AVX2. Included by the generated
+// wire.hpp and by tools that key whole runs of records.
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/symbol.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MARKET_SYMBOL_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MARKET_SYMBOL_SSE2 1
+#endif
+
+namespace market::runtime {
+
+namespace detail {
+
+// Eight symbol bytes in memory order (x86 lanes for the vector paths).
+MARKET_ALWAYS_INLINE long long load_raw(const char* p) noexcept {
+    long long v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// Keys for `lanes` symbols from the vector pass: `norm` holds each symbol
+// upper-cased with its trailing padding zeroed (memory order); bit i of `pad`
+// / `bad` flags byte i as trailing padding / a non-printable character.
+MARKET_ALWAYS_INLINE size_t finish_symbols(const uint64_t* norm, uint32_t pad, uint32_t bad, size_t lanes,
+                                           uint64_t* keys, uint8_t* lengths) noexcept {
+    size_t invalid = 0;
+    for (size_t s = 0; s < lanes; ++s) {
+        const unsigned len = static_cast<unsigned>(std::countr_zero(((pad >> (8 * s)) & 0xFF) | 0x100));
+        const bool ok = len != 0 && ((bad >> (8 * s)) & 0xFF) == 0;
+        keys[s] = ok ? byteswap(norm[s]) : 0;
+        if (lengths) lengths[s] = static_cast<uint8_t>(len);
+        invalid += !ok;
+    }
+    return invalid;
+}
+
+}  // namespace detail
+
+// Keys (and optionally trimmed lengths) for n symbols, the first at `first`
+// and each `stride` bytes after the previous one (8 for a column of symbols,
+// sizeof(record) for a field of fixed-size records). Returns the number of
+// invalid symbols, whose keys are 0.
+inline size_t symbol_keys(const char* first, size_t stride, size_t n, uint64_t* keys,
+                          uint8_t* lengths = nullptr) noexcept {
+    size_t invalid = 0;
+    size_t i = 0;
+#if MARKET_SYMBOL_AVX2
+    {
+        const __m256i case_bits = _mm256_set1_epi8(0x20);
+        const __m256i pad_mask = _mm256_set1_epi8(static_cast<char>(0xDF));
+        const __m256i below_a = _mm256_set1_epi8('a' - 1);
+        const __m256i above_z = _mm256_set1_epi8('z' + 1);
+        const __m256i space = _mm256_set1_epi8(0x20);
+        const __m256i del = _mm256_set1_epi8(0x7F);
+        const __m256i top1 = _mm256_set1_epi64x(static_cast<long long>(0xFF00000000000000ull));
+        const __m256i top2 = _mm256_set1_epi64x(static_cast<long long>(0xFFFF000000000000ull));
+        const __m256i top4 = _mm256_set1_epi64x(static_cast<long long>(0xFFFFFFFF00000000ull));
+        for (; i + 4 <= n; i += 4) {
+            const __m256i v = stride == kSymbolSize
+                ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i * stride))
+                : _mm256_set_epi64x(detail::load_raw(first + (i + 3) * stride), detail::load_raw(first + (i + 2) * stride),
+                                    detail::load_raw(first + (i + 1) * stride), detail::load_raw(first + i * stride));
+            // Trailing padding: padding bytes followed only by padding in their
+            // symbol (suffix AND across each 64-bit lane, shifting in ones)
+            __m256i trail = _mm256_cmpeq_epi8(_mm256_and_si256(v, pad_mask), _mm256_setzero_si256());
+            trail = _mm256_and_si256(trail, _mm256_or_si256(_mm256_srli_epi64(trail, 8), top1));
+            trail = _mm256_and_si256(trail, _mm256_or_si256(_mm256_srli_epi64(trail, 16), top2));
+            trail = _mm256_and_si256(trail, _mm256_or_si256(_mm256_srli_epi64(trail, 32), top4));
+            // signed compare: bytes >= 0x80 count as below 0x20
+            const __m256i is_bad = _mm256_or_si256(_mm256_cmpgt_epi8(space, v), _mm256_cmpeq_epi8(v, del));
+            const __m256i is_lower = _mm256_and_si256(_mm256_cmpgt_epi8(v, below_a), _mm256_cmpgt_epi8(above_z, v));
+            const __m256i norm = _mm256_sub_epi8(v, _mm256_and_si256(is_lower, case_bits));
+            alignas(32) uint64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_andnot_si256(trail, norm));
+            invalid += detail::finish_symbols(lanes, static_cast<uint32_t>(_mm256_movemask_epi8(trail)),
+                                              static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_andnot_si256(trail, is_bad))),
+                                              4, keys + i, lengths ? lengths + i : nullptr);
+        }
+    }
+#endif
+#if MARKET_SYMBOL_SSE2
+    {
+        const __m128i case_bits = _mm_set1_epi8(0x20);
+        const __m128i pad_mask = _mm_set1_epi8(static_cast<char>(0xDF));
+        const __m128i below_a = _mm_set1_epi8('a' - 1);
+        const __m128i above_z = _mm_set1_epi8('z' + 1);
+        const __m128i space = _mm_set1_epi8(0x20);
+        const __m128i del = _mm_set1_epi8(0x7F);
+        const __m128i top1 = _mm_set1_epi64x(static_cast<long long>(0xFF00000000000000ull));
+        const __m128i top2 = _mm_set1_epi64x(static_cast<long long>(0xFFFF000000000000ull));
+        const __m128i top4 = _mm_set1_epi64x(static_cast<long long>(0xFFFFFFFF00000000ull));
+        for (; i + 2 <= n; i += 2) {
+            const __m128i v = stride == kSymbolSize
+                ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i * stride))
+                : _mm_set_epi64x(detail::load_raw(first + (i + 1) * stride), detail::load_raw(first + i * stride));
+            __m128i trail = _mm_cmpeq_epi8(_mm_and_si128(v, pad_mask), _mm_setzero_si128());
+            trail = _mm_and_si128(trail, _mm_or_si128(_mm_srli_epi64(trail, 8), top1));
+            trail = _mm_and_si128(trail, _mm_or_si128(_mm_srli_epi64(trail, 16), top2));
+            trail = _mm_and_si128(trail, _mm_or_si128(_mm_srli_epi64(trail, 32), top4));
+            const __m128i is_bad = _mm_or_si128(_mm_cmplt_epi8(v, space), _mm_cmpeq_epi8(v, del));
+            const __m128i is_lower = _mm_and_si128(_mm_cmpgt_epi8(v, below_a), _mm_cmplt_epi8(v, above_z));
+            const __m128i norm = _mm_sub_epi8(v, _mm_and_si128(is_lower, case_bits));
+            alignas(16) uint64_t lanes[2];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_andnot_si128(trail, norm));
+            invalid += detail::finish_symbols(lanes, static_cast<uint32_t>(_mm_movemask_epi8(trail)),
+                                              static_cast<uint32_t>(_mm_movemask_epi8(_mm_andnot_si128(trail, is_bad))),
+                                              2, keys + i, lengths ? lengths + i : nullptr);
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        size_t len = 0;
+        keys[i] = detail::symbol_key_be(load_be<uint64_t>(reinterpret_cast<const uint8_t*>(first + i * stride)), &len);
+        if (lengths) lengths[i] = static_cast<uint8_t>(len);
+        invalid += keys[i] == 0;
+    }
+    return invalid;
+}
+
+inline size_t symbol_keys(const std::array<char, kSymbolSize>* symbols, size_t n, uint64_t* keys,
+                          uint8_t* lengths = nullptr) noexcept {
+    return symbol_keys(symbols ? symbols->data() : nullptr, kSymbolSize, n, keys, lengths);
+}
+
+}  // namespace market::runtime
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "runtime/seqlock.hpp"
+
+namespace market::runtime {
+
+// Best bid/offer snapshot for one symbol.
+struct top_of_book {
+    uint64_t bid_price{0};
+    uint64_t bid_size{0};
+    uint64_t ask_price{0};
+    uint64_t ask_size{0};
+    uint64_t sequence{0};   // feed sequence of the update that produced this snapshot
+    uint64_t timestamp{0};  // feed or receive timestamp, caller-defined units
+};
+
+// Per-symbol top-of-book table published through one seqlock per cache line.
+//
+// A single book-building thread calls publish(); any number of readers call
+// read()/try_read() concurrently. Each symbol owns exactly one 64-byte line, so
+// the writer never contends with updates to other symbols and readers never
+// write shared memory. Symbol ids are dense indices in [0, size()).
+class top_of_book_table {
+public:
+    struct alignas(64) slot {
+        seqlock<top_of_book> lock;
+    };
+    static_assert(sizeof(slot) == 64, "top_of_book slot must occupy exactly one cache line");
+
+    explicit top_of_book_table(size_t symbols)
+        : slots_(std::make_unique<slot[]>(symbols)), size_(symbols) {}
+
+    size_t size() const noexcept { return size_; }
+
+    // Writer side (single thread).
+    void publish(uint32_t symbol_id, const top_of_book& tob) noexcept {
+        slots_[symbol_id].lock.store(tob);
+    }
+
+    // Reader side: spins until a consistent snapshot is available.
+    top_of_book read(uint32_t symbol_id) const noexcept {
+        return slots_[symbol_id].lock.load();
+    }
+
+    // Reader side: single attempt, false if the writer was mid-update.
+    bool try_read(uint32_t symbol_id, top_of_book& out) const noexcept {
+        return slots_[symbol_id].lock.try_load(out);
+    }
+
+    // Changes on every publish; lets pollers skip symbols that did not move.
+    uint64_t version(uint32_t symbol_id) const noexcept {
+        return slots_[symbol_id].lock.version();
+    }
+
+private:
+    std::unique_ptr<slot[]> slots_;
+    size_t size_;
+};
+
+}
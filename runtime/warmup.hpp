@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+#include "runtime/bytes.hpp"
+#include "runtime/config.hpp"
+#include "runtime/status.hpp"
+
+namespace market::runtime {
+
+// Cold-start warm-up support.
+//
+// The first messages after startup (or after a long quiet period) pay for page
+// faults, cold instruction cache and untrained branch predictors. The helpers
+// here pre-fault and pin memory; the generated warmup.hpp pushes a synthetic
+// instance of every message type through the real dispatcher and decoder into a
+// handler so those paths are hot before the first live message arrives.
+
+namespace detail {
+    inline bool& warmup_flag() noexcept {
+        static thread_local bool flag = false;
+        return flag;
+    }
+}
+
+// True while the current thread is inside a warm-up run. Handlers with effects
+// outside themselves (sending orders, publishing to other threads) check this
+// and skip the externally visible part; everything else should run normally so
+// the same code is exercised.
+inline bool warming_up() noexcept { return detail::warmup_flag(); }
+
+// Marks the current thread as warming up for the lifetime of the scope.
+class warmup_scope {
+public:
+    warmup_scope() noexcept : prev_(detail::warmup_flag()) { detail::warmup_flag() = true; }
+    ~warmup_scope() { detail::warmup_flag() = prev_; }
+    warmup_scope(const warmup_scope&) = delete;
+    warmup_scope& operator=(const warmup_scope&) = delete;
+
+private:
+    bool prev_;
+};
+
+// Touch every page of `buf` so the first real write does not fault. Contents are
+// preserved.
+inline void prefault(MutBytes buf, size_t page_size = 4096) noexcept {
+    volatile uint8_t* p = buf.data();
+    for (size_t i = 0; i < buf.size(); i += page_size) {
+        p[i] = p[i];
+    }
+    if (!buf.empty()) {
+        p[buf.size() - 1] = p[buf.size() - 1];
+    }
+}
+
+// Grow the current thread's stack mapping by `Bytes` up front.
+template<size_t Bytes = 256 * 1024>
+MARKET_NOINLINE void prefault_stack() noexcept {
+    volatile uint8_t frame[Bytes];
+    for (size_t i = 0; i < Bytes; i += 4096) {
+        frame[i] = 0;
+    }
+    (void)frame[0];
+}
+
+// Pin current and future pages in RAM (mlockall). Needs CAP_IPC_LOCK or a large
+// enough RLIMIT_MEMLOCK; returns bad_value if the kernel refuses.
+inline status lock_memory() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+    return ::mlockall(MCL_CURRENT | MCL_FUTURE) == 0 ? status::ok : status::bad_value;
+#else
+    return status::bad_value;
+#endif
+}
+
+// Re-runs a warm-up callback when the feed has been idle for `idle_ns` and the
+// last warm-up is at least `idle_ns` old. Time is supplied by the caller in any
+// monotonic unit (feed timestamps, TSC, steady_clock nanoseconds).
+class idle_warmer {
+public:
+    explicit idle_warmer(uint64_t idle_ns) noexcept : idle_ns_(idle_ns) {}
+
+    // Call on every live message.
+    void on_activity(uint64_t now) noexcept { last_activity_ = now; }
+
+    bool due(uint64_t now) const noexcept {
+        return now - last_activity_ >= idle_ns_ && now - last_warm_ >= idle_ns_;
+    }
+
+    // Call from the idle branch of the poll loop. Returns true if `warm` ran.
+    template<typename F>
+    bool poll(uint64_t now, F&& warm) {
+        if (!due(now)) {
+            return false;
+        }
+        warm();
+        last_warm_ = now;
+        ++runs_;
+        return true;
+    }
+
+    uint64_t runs() const noexcept { return runs_; }
+
+private:
+    uint64_t idle_ns_;
+    uint64_t last_activity_{0};
+    uint64_t last_warm_{0};
+    uint64_t runs_{0};
+};
+
+}
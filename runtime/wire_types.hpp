@@ -0,0 +1,131 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "runtime/bytes.hpp"
+#include "runtime/config.hpp"
+#include "runtime/endian.hpp"
+
+namespace market::runtime {
+
+// Endian-aware integers stored as raw wire bytes: alignment 1, trivially
+// copyable, converting implicitly to and from the native value. They are the
+// member types of the generated wire overlays (wire.hpp), so a field read is a
+// plain (unaligned) load plus a byte swap the compiler can schedule with the
+// rest of the message.
+template<std::endian E, size_t N, class T>
+class wire_int {
+    static_assert(N == 2 || N == 4 || N == 6 || N == 8, "wire_int supports 2, 4, 6 and 8 byte fields");
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "wire_int holds integers or enums");
+
+    using raw_t = std::conditional_t<N == 2, uint16_t, std::conditional_t<N == 4, uint32_t, uint64_t>>;
+
+public:
+    using value_type = T;
+
+    // Uninitialised, like the bytes it overlays.
+    wire_int() = default;
+    wire_int(T v) noexcept { set(v); }  // NOLINT: implicit by design
+
+    wire_int& operator=(T v) noexcept {
+        set(v);
+        return *this;
+    }
+
+    MARKET_ALWAYS_INLINE operator T() const noexcept { return get(); }  // NOLINT: implicit by design
+
+    MARKET_ALWAYS_INLINE T get() const noexcept {
+        raw_t raw;
+        if constexpr (N == 6) {
+            // 48-bit fields (e.g. ITCH nanosecond timestamps): 4 + 2 bytes
+            if constexpr (E == std::endian::big) {
+                raw = (uint64_t{load_be<uint32_t>(bytes_)} << 16) | load_be<uint16_t>(bytes_ + 4);
+            } else {
+                raw = uint64_t{load_le<uint32_t>(bytes_)} | (uint64_t{load_le<uint16_t>(bytes_ + 4)} << 32);
+            }
+        } else if constexpr (E == std::endian::big) {
+            raw = load_be<raw_t>(bytes_);
+        } else {
+            raw = load_le<raw_t>(bytes_);
+        }
+        if constexpr (std::is_enum_v<T>) {
+            return static_cast<T>(static_cast<std::underlying_type_t<T>>(raw));
+        } else if constexpr (N == 6 && std::is_signed_v<T>) {
+            return static_cast<T>(static_cast<int64_t>(raw << 16) >> 16);
+        } else {
+            return static_cast<T>(raw);
+        }
+    }
+
+    MARKET_ALWAYS_INLINE void set(T v) noexcept {
+        raw_t raw;
+        if constexpr (std::is_enum_v<T>) {
+            raw = static_cast<raw_t>(static_cast<std::underlying_type_t<T>>(v));
+        } else {
+            raw = static_cast<raw_t>(v);
+        }
+        if constexpr (N == 6) {
+            if constexpr (E == std::endian::big) {
+                store_be<uint32_t>(bytes_, static_cast<uint32_t>(raw >> 16));
+                store_be<uint16_t>(bytes_ + 4, static_cast<uint16_t>(raw));
+            } else {
+                store_le<uint32_t>(bytes_, static_cast<uint32_t>(raw));
+                store_le<uint16_t>(bytes_ + 4, static_cast<uint16_t>(raw >> 32));
+            }
+        } else if constexpr (E == std::endian::big) {
+            store_be<raw_t>(bytes_, raw);
+        } else {
+            store_le<raw_t>(bytes_, raw);
+        }
+    }
+
+    const uint8_t* data() const noexcept { return bytes_; }
+
+private:
+    uint8_t bytes_[N];
+};
+
+using be_u16 = wire_int<std::endian::big, 2, uint16_t>;
+using be_u32 = wire_int<std::endian::big, 4, uint32_t>;
+using be_u48 = wire_int<std::endian::big, 6, uint64_t>;
+using be_u64 = wire_int<std::endian::big, 8, uint64_t>;
+using be_i16 = wire_int<std::endian::big, 2, int16_t>;
+using be_i32 = wire_int<std::endian::big, 4, int32_t>;
+using be_i64 = wire_int<std::endian::big, 8, int64_t>;
+
+using le_u16 = wire_int<std::endian::little, 2, uint16_t>;
+using le_u32 = wire_int<std::endian::little, 4, uint32_t>;
+using le_u48 = wire_int<std::endian::little, 6, uint64_t>;
+using le_u64 = wire_int<std::endian::little, 8, uint64_t>;
+using le_i16 = wire_int<std::endian::little, 2, int16_t>;
+using le_i32 = wire_int<std::endian::little, 4, int32_t>;
+using le_i64 = wire_int<std::endian::little, 8, int64_t>;
+
+// View raw bytes as a wire overlay. Only for types laid out like the wire
+// (alignment 1, trivially copyable, as generated in wire.hpp); the caller has
+// checked that sizeof(W) bytes are available and that the type matches.
+template<class W>
+MARKET_ALWAYS_INLINE const W* overlay(const uint8_t* p) noexcept {
+    static_assert(alignof(W) == 1 && std::is_trivially_copyable_v<W>, "not a wire overlay type");
+    return reinterpret_cast<const W*>(p);
+}
+
+template<class W>
+MARKET_ALWAYS_INLINE W* overlay(uint8_t* p) noexcept {
+    static_assert(alignof(W) == 1 && std::is_trivially_copyable_v<W>, "not a wire overlay type");
+    return reinterpret_cast<W*>(p);
+}
+
+// Back-to-back records of one fixed-size message (e.g. a capture filtered to
+// a single type) as an array; trailing bytes short of a whole record are
+// ignored.
+template<class W>
+inline std::span<const W> overlay_array(Bytes b) noexcept {
+    return {overlay<W>(b.data()), b.size() / sizeof(W)};
+}
+
+}  // namespace market::runtime
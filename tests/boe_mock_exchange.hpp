@@ -0,0 +1,308 @@
+// Loopback BOE acceptor for tests and the order-entry round-trip benchmark.
+//
+// mock_exchange listens on 127.0.0.1 (ephemeral port), accepts sessions one
+// after another and answers them from its own thread:
+//   LoginRequest    -> LoginResponse 'A' "Accepted", LastReceivedSequenceNumber
+//                      = last client sequence number seen (kept across sessions)
+//   NewOrder        -> OrderAcknowledgement (ClOrdId echoed)
+//   NewOrderCross   -> OrderAcknowledgement (ClOrdId = CrossId)
+//   ClientHeartbeat -> counted
+// Acknowledgements carry an increasing OrderId and the exchange's own
+// SequenceNumber. A NewOrder whose sequence number is not the next expected
+// one counts as a sequence error.
+// Requests are decoded with the generated decoder and replies encoded with the
+// generated encoder, so a round trip exercises the same code a client would.
+//
+// Stream framing: every message is preceded by a big-endian u16 length (the
+// framing dispatch_boe_framed reads). NewOrderCross carries no BOE unit header
+// in this schema, so MessageLength cannot delimit the stream; frames starting
+// with the 0xBABA preamble go through dispatch_boe, anything else is decoded as
+// a NewOrderCross.
+//
+// POSIX sockets only (HAS_BOE_MOCK is 0 elsewhere).
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "runtime/bytes.hpp"
+#include "runtime/endian.hpp"
+#include "runtime/session.hpp"
+#include "runtime/status.hpp"
+
+#include "../generated/cboe_boe_v3/decoder.hpp"
+#include "../generated/cboe_boe_v3/encoder.hpp"
+#include "../generated/cboe_boe_v3/handler.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#define HAS_BOE_MOCK 1
+#else
+#define HAS_BOE_MOCK 0
+#endif
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if HAS_BOE_MOCK
+
+namespace boe_mock {
+
+using market::runtime::Bytes;
+using market::runtime::status;
+
+constexpr size_t kFrameHeader = market::runtime::kFramePrefix;
+constexpr size_t kMaxFrame = 1024;  // largest message either side sends
+
+inline uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+inline void pin_thread(int cpu) {
+#if defined(__linux__)
+    if (cpu < 0) return;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+inline void set_nodelay(int fd) {
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+// Connected loopback client socket, or -1.
+inline int connect_loopback(uint16_t port) {
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    set_nodelay(fd);
+    return fd;
+}
+
+// Write all of [p, p + n); false when the peer has gone.
+inline bool send_all(int fd, const uint8_t* p, size_t n) {
+    while (n > 0) {
+        const ssize_t w = ::send(fd, p, n, MSG_NOSIGNAL);
+        if (w <= 0) return false;
+        p += w;
+        n -= static_cast<size_t>(w);
+    }
+    return true;
+}
+
+// Encode `m` behind a length prefix in `buf` and send it in one write.
+template<class M>
+status send_message(int fd, const M& m, uint8_t* buf, size_t buf_sz) {
+    size_t written = 0;
+    const status st = cboe::boe::v3::Encoder::encode(m, buf + kFrameHeader, buf_sz - kFrameHeader, written);
+    if (st != status::ok) return st;
+    market::runtime::store_be<uint16_t>(buf, static_cast<uint16_t>(written));
+    return send_all(fd, buf, kFrameHeader + written) ? status::ok : status::short_buffer;
+}
+
+using market::runtime::frame_reader;
+
+// Spin (busy_poll) or block until the next frame arrives; false on disconnect.
+inline bool read_frame(int fd, frame_reader& rx, Bytes& frame, bool busy_poll) {
+    while (rx.next(frame) != status::ok) {
+        if (rx.fill(fd, busy_poll) < 0) return false;
+    }
+    return true;
+}
+
+struct mock_options {
+    int cpu = -1;               // pin the acceptor thread (Linux only)
+    bool busy_poll = true;      // spin on non-blocking recv instead of sleeping in it
+    size_t disconnect_after = 0;  // end the first session after this many NewOrders (0 = never)
+};
+
+class mock_exchange {
+public:
+    explicit mock_exchange(mock_options opt = {}) : opt_(opt) {}
+    mock_exchange(const mock_exchange&) = delete;
+    mock_exchange& operator=(const mock_exchange&) = delete;
+    ~mock_exchange() { stop(); }
+
+    // Listen on an ephemeral loopback port and start the acceptor thread.
+    // Returns the port, or 0 if the socket could not be set up.
+    uint16_t start() {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (listen_fd_ < 0) return 0;
+        int one = 1;
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t alen = sizeof(addr);
+        if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listen_fd_, 1) != 0 ||
+            ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &alen) != 0) {
+            ::close(listen_fd_);
+            listen_fd_ = -1;
+            return 0;
+        }
+        thread_ = std::thread([this] { run(); });
+        return ntohs(addr.sin_port);
+    }
+
+    // Close the session and join; also called by the destructor. Counters
+    // are final once this returns.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(conn_mu_);
+            stopping_ = true;
+            if (listen_fd_ >= 0) ::shutdown(listen_fd_, SHUT_RDWR);
+            if (conn_fd_ >= 0) ::shutdown(conn_fd_, SHUT_RDWR);
+        }
+        if (thread_.joinable()) thread_.join();
+        if (listen_fd_ >= 0) ::close(listen_fd_);
+        listen_fd_ = -1;
+    }
+
+    size_t sessions() const { return sessions_.load(std::memory_order_acquire); }
+    size_t logins() const { return logins_.load(std::memory_order_acquire); }
+    size_t orders() const { return orders_.load(std::memory_order_acquire); }
+    size_t crosses() const { return crosses_.load(std::memory_order_acquire); }
+    size_t heartbeats() const { return heartbeats_.load(std::memory_order_acquire); }
+    size_t sequence_errors() const { return sequence_errors_.load(std::memory_order_acquire); }
+    size_t errors() const { return errors_.load(std::memory_order_acquire); }
+
+private:
+    struct Handler {
+        mock_exchange& ex;
+        int fd;
+        uint8_t* out;
+        bool ok = true;
+
+        void on(const cboe::boe::v3::LoginRequest&) {
+            cboe::boe::v3::LoginResponse r;
+            r.StartOfMessage = 0xBABA;
+            r.MessageType = cboe::boe::v3::MessageType::LoginResponse;
+            r.LoginResponseStatus = 'A';
+            r.LastReceivedSequenceNumber = ex.last_received_;
+            r.LoginResponseText = std::string_view("Accepted");
+            ok = send_message(fd, r, out, kMaxFrame) == status::ok;
+            ex.logins_.fetch_add(1, std::memory_order_release);
+        }
+
+        void on(const cboe::boe::v3::NewOrder& m) {
+            if (m.SequenceNumber != ex.last_received_ + 1) ex.sequence_errors_.fetch_add(1, std::memory_order_release);
+            if (m.SequenceNumber > ex.last_received_) ex.last_received_ = m.SequenceNumber;
+            acknowledge(m.ClOrdId);
+            ex.orders_.fetch_add(1, std::memory_order_release);
+            if (ex.opt_.disconnect_after != 0 && ex.sessions() == 1 && ++orders == ex.opt_.disconnect_after) ok = false;
+        }
+
+        void on(const cboe::boe::v3::NewOrderCross& m) {
+            acknowledge(m.CrossId);
+            ex.crosses_.fetch_add(1, std::memory_order_release);
+        }
+
+        void on(const cboe::boe::v3::ClientHeartbeat&) { ex.heartbeats_.fetch_add(1, std::memory_order_release); }
+
+        void acknowledge(const std::array<char, 20>& clordid) {
+            cboe::boe::v3::OrderAcknowledgement a;
+            a.StartOfMessage = 0xBABA;
+            a.MessageType = cboe::boe::v3::MessageType::OrderAcknowledgement;
+            a.SequenceNumber = ++ex.server_seq_;
+            a.TransactionTime = now_ns();
+            a.ClOrdId = clordid;
+            a.OrderId = ++ex.next_order_id_;
+            ok = send_message(fd, a, out, kMaxFrame) == status::ok;
+        }
+
+        size_t orders = 0;
+    };
+
+    void run() {
+        pin_thread(opt_.cpu);
+        for (;;) {
+            const int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) return;
+            {
+                std::lock_guard<std::mutex> lock(conn_mu_);
+                conn_fd_ = fd;
+                if (stopping_) ::shutdown(fd, SHUT_RDWR);
+            }
+            sessions_.fetch_add(1, std::memory_order_release);
+            serve(fd);
+            std::lock_guard<std::mutex> lock(conn_mu_);
+            ::close(fd);
+            conn_fd_ = -1;
+            if (stopping_) return;
+        }
+    }
+
+    void serve(int fd) {
+        set_nodelay(fd);
+        frame_reader rx;
+        uint8_t out[kMaxFrame];
+        Handler h{*this, fd, out};
+        cboe::boe::v3::NewOrderCross cross;  // reused so groups keep their capacity
+        Bytes frame;
+        while (h.ok && read_frame(fd, rx, frame, opt_.busy_poll)) {
+            size_t consumed = 0;
+            status st;
+            if (frame.size() >= 2 && market::runtime::load_le<uint16_t>(frame.data()) == 0xBABA) {
+                st = cboe::boe::v3::dispatch_boe(frame, h, consumed);
+            } else {
+                st = cboe::boe::v3::Decoder::decode(frame.data(), frame.size(), cross, consumed);
+                if (st == status::ok) h.on(cross);
+            }
+            if (st != status::ok || consumed != frame.size()) errors_.fetch_add(1, std::memory_order_release);
+        }
+        // End the session for the peer; run() closes the descriptor
+        ::shutdown(fd, SHUT_RDWR);
+    }
+
+    mock_options opt_;
+    int listen_fd_ = -1;
+    std::mutex conn_mu_;  // guards conn_fd_ and stopping_
+    int conn_fd_ = -1;
+    bool stopping_ = false;
+    std::thread thread_;
+    uint64_t next_order_id_ = 0;
+    uint32_t last_received_ = 0;  // client sequence, kept across sessions
+    uint32_t server_seq_ = 0;
+    std::atomic<size_t> sessions_{0};
+    std::atomic<size_t> logins_{0};
+    std::atomic<size_t> orders_{0};
+    std::atomic<size_t> crosses_{0};
+    std::atomic<size_t> heartbeats_{0};
+    std::atomic<size_t> sequence_errors_{0};
+    std::atomic<size_t> errors_{0};
+};
+
+}  // namespace boe_mock
+
+#endif
@@ -40,6 +40,20 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
         (void)consumed;
     }
     
+    // Try to decode as LoginResponse (u8 length-prefixed text)
+    {
+        LoginResponse msg;
+        size_t consumed = 0;
+        
+        auto status = Decoder::decode(data, size, msg, consumed);
+        // A decoded text view must lie inside the input
+        if (status == market::runtime::status::ok && !msg.LoginResponseText.empty() &&
+            (reinterpret_cast<const uint8_t*>(msg.LoginResponseText.data()) < data ||
+             reinterpret_cast<const uint8_t*>(msg.LoginResponseText.data() + msg.LoginResponseText.size()) > data + consumed)) {
+            __builtin_trap();
+        }
+    }
+    
     // Also try with a subspan if we have enough data
     if (size >= 10) {
         // Try LoginRequest from offset 1
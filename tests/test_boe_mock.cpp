@@ -0,0 +1,137 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "boe_mock_exchange.hpp"
+
+// Loopback BOE mock exchange: login, acknowledged crosses, frames split and
+// coalesced on the stream, and a malformed frame counted as an error.
+#if HAS_BOE_MOCK
+
+namespace boe = cboe::boe::v3;
+using market::runtime::Bytes;
+using market::runtime::status;
+
+namespace {
+
+int fail(const char* what) {
+    std::cerr << "test_boe_mock: " << what << std::endl;
+    return 1;
+}
+
+boe::NewOrderCross make_cross(int id, bool with_account) {
+    boe::NewOrderCross m;
+    std::memset(m.CrossId.data(), ' ', m.CrossId.size());
+    std::memcpy(m.CrossId.data(), "CROSS", 5);
+    m.CrossId[5] = static_cast<char>('0' + id);
+    m.PresenceBits = with_account ? (1ULL << 9) : 0;
+    m.groups.resize(2);
+    for (auto& g : m.groups) {
+        g.Side = static_cast<uint8_t>(boe::Side::Buy);
+        g.AllocQty = 100u * static_cast<uint32_t>(id + 1);
+        std::memcpy(g.Account.data(), "ACCOUNT-0000001 ", 16);
+    }
+    m.groups[1].Side = static_cast<uint8_t>(boe::Side::Sell);
+    m.GroupCount = 2;
+    return m;
+}
+
+struct Client {
+    size_t responses = 0;
+    char response_status = 0;
+    std::vector<boe::OrderAcknowledgement> acks;
+
+    void on(const boe::LoginResponse& m) {
+        ++responses;
+        response_status = m.LoginResponseStatus;
+    }
+    void on(const boe::OrderAcknowledgement& m) { acks.push_back(m); }
+};
+
+bool receive(int fd, boe_mock::frame_reader& rx, Client& c) {
+    Bytes frame;
+    size_t consumed = 0;
+    return boe_mock::read_frame(fd, rx, frame, false) && boe::dispatch_boe(frame, c, consumed) == status::ok &&
+           consumed == frame.size();
+}
+
+}  // namespace
+
+int main() {
+    boe_mock::mock_exchange ex;
+    const uint16_t port = ex.start();
+    if (port == 0) return fail("listen");
+    const int fd = boe_mock::connect_loopback(port);
+    if (fd < 0) return fail("connect");
+
+    boe_mock::frame_reader rx;
+    Client c;
+    std::array<uint8_t, boe_mock::kMaxFrame> buf{};
+
+    // Login
+    boe::LoginRequest login;
+    login.StartOfMessage = 0xBABA;
+    login.MessageType = boe::MessageType::LoginRequest;
+    std::memcpy(login.Username.data(), "USR1", 4);
+    std::memset(login.Password.data(), 'p', login.Password.size());
+    if (boe_mock::send_message(fd, login, buf.data(), buf.size()) != status::ok || !receive(fd, rx, c) ||
+        c.responses != 1 || c.response_status != 'A')
+        return fail("login");
+
+    // One cross per round trip
+    for (int i = 0; i < 3; ++i) {
+        const auto m = make_cross(i, i == 1);
+        if (boe_mock::send_message(fd, m, buf.data(), buf.size()) != status::ok || !receive(fd, rx, c))
+            return fail("cross round trip");
+        if (c.acks.size() != static_cast<size_t>(i + 1) || c.acks.back().ClOrdId != m.CrossId ||
+            c.acks.back().OrderId != static_cast<uint64_t>(i + 1) ||
+            c.acks.back().MessageType != boe::MessageType::OrderAcknowledgement)
+            return fail("cross acknowledgement");
+    }
+
+    // Two crosses in one write, the second split across two writes
+    std::vector<uint8_t> stream;
+    for (int i = 3; i < 6; ++i) {
+        size_t written = 0;
+        if (boe::Encoder::encode(make_cross(i, false), buf.data(), buf.size(), written) != status::ok)
+            return fail("cross encode");
+        const uint8_t len[2] = {static_cast<uint8_t>(written >> 8), static_cast<uint8_t>(written)};
+        stream.insert(stream.end(), len, len + 2);
+        stream.insert(stream.end(), buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(written));
+    }
+    const size_t cut = stream.size() - 7;
+    if (!boe_mock::send_all(fd, stream.data(), cut)) return fail("pipelined send");
+    for (int i = 0; i < 2; ++i) {
+        if (!receive(fd, rx, c)) return fail("pipelined ack");
+    }
+    if (!boe_mock::send_all(fd, stream.data() + cut, stream.size() - cut) || !receive(fd, rx, c))
+        return fail("split frame ack");
+    for (size_t i = 0; i < c.acks.size(); ++i) {
+        if (c.acks[i].OrderId != i + 1 || c.acks[i].ClOrdId[5] != static_cast<char>('0' + i))
+            return fail("acknowledgement order");
+    }
+
+    // A frame neither dispatch_boe nor the NewOrderCross decoder accepts
+    const uint8_t junk[] = {0x00, 0x03, 0x01, 0x02, 0x03};
+    if (!boe_mock::send_all(fd, junk, sizeof(junk))) return fail("junk send");
+    ::shutdown(fd, SHUT_WR);
+    Bytes frame;
+    if (boe_mock::read_frame(fd, rx, frame, false)) return fail("reply to malformed frame");
+    ex.stop();
+    ::close(fd);
+    if (ex.logins() != 1 || ex.crosses() != 6 || ex.errors() != 1) return fail("exchange counters");
+
+    std::cout << "BOE mock exchange ok" << std::endl;
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "BOE mock exchange: sockets unavailable, skipped" << std::endl;
+    return 0;
+}
+
+#endif
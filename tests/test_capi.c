@@ -0,0 +1,231 @@
+/* C ABI batch decode, compiled as C to keep the generated headers C-clean. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "generated/cboe_boe_v3/capi.h"
+#include "generated/nasdaq_itch_5/capi.h"
+
+#define CHECK(cond, what)                                   \
+    do {                                                    \
+        if (!(cond)) {                                      \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, what); \
+            return 1;                                       \
+        }                                                   \
+    } while (0)
+
+static size_t put_be(uint8_t* p, uint64_t v, int n) {
+    for (int i = n - 1; i >= 0; --i) { p[i] = (uint8_t)v; v >>= 8; }
+    return (size_t)n;
+}
+
+static size_t put_le(uint8_t* p, uint64_t v, int n) {
+    for (int i = 0; i < n; ++i) { p[i] = (uint8_t)v; v >>= 8; }
+    return (size_t)n;
+}
+
+static size_t itch_add(uint8_t* p, uint32_t ts, uint64_t id, char side, uint32_t shares, const char* sym, uint32_t px) {
+    size_t o = 0;
+    p[o++] = 'A';
+    o += put_be(p + o, ts, 4);
+    o += put_be(p + o, id, 8);
+    p[o++] = (uint8_t)side;
+    o += put_be(p + o, shares, 4);
+    memcpy(p + o, sym, 8);
+    o += 8;
+    o += put_be(p + o, px, 4);
+    return o;
+}
+
+static size_t itch_delete(uint8_t* p, uint32_t ts, uint64_t id) {
+    size_t o = 0;
+    p[o++] = 'D';
+    o += put_be(p + o, ts, 4);
+    o += put_be(p + o, id, 8);
+    return o;
+}
+
+static int test_itch(void) {
+    uint8_t buf[256];
+    size_t len = 0;
+    len += itch_add(buf + len, 100, 1, 'B', 300, "MSFT    ", 4012500);
+    len += itch_delete(buf + len, 200, 1);
+    len += itch_add(buf + len, 300, 2, 'S', 100, "AAPL    ", 1890000);
+    const size_t whole = len;
+    len += itch_add(buf + len, 400, 3, 'B', 1, "IBM     ", 1);
+    len -= 5; /* trailing partial message */
+
+    nasdaq_itch_v5_AddOrder adds[8];
+    nasdaq_itch_v5_DeleteOrder dels[8];
+    nasdaq_itch_v5_entry entries[16];
+    nasdaq_itch_v5_batch out;
+    memset(&out, 0, sizeof(out));
+    out.AddOrder = adds;
+    out.AddOrder_capacity = 8;
+    out.DeleteOrder = dels;
+    out.DeleteOrder_capacity = 8;
+
+    size_t consumed = 0;
+    size_t n = nasdaq_itch_v5_decode_batch(buf, len, &out, entries, 16, &consumed);
+    CHECK(n == 3 && consumed == whole, "ITCH batch: entries/consumed");
+    CHECK(out.AddOrder_count == 2 && out.DeleteOrder_count == 1, "ITCH batch: record counts");
+    CHECK(entries[0].type == NASDAQ_ITCH_V5_MSG_AddOrder && entries[0].row == 0 && entries[0].length == 30,
+          "ITCH batch: first entry");
+    CHECK(entries[1].type == NASDAQ_ITCH_V5_MSG_DeleteOrder && entries[1].offset == 30 && entries[1].row == 0,
+          "ITCH batch: second entry");
+    CHECK(entries[2].status == MARKET_STATUS_OK && entries[2].row == 1, "ITCH batch: third entry");
+    CHECK(adds[0].Timestamp == 100 && adds[0].OrderId == 1 && adds[0].Side == 'B' && adds[0].Shares == 300 &&
+          memcmp(adds[0].Symbol, "MSFT    ", 8) == 0 && adds[0].Price == 4012500,
+          "ITCH batch: AddOrder fields");
+    CHECK(dels[0].OrderId == 1 && dels[0].Timestamp == 200, "ITCH batch: DeleteOrder fields");
+
+    /* Full record array: stop before the message, resume from *consumed */
+    out.AddOrder_capacity = 1;
+    n = nasdaq_itch_v5_decode_batch(buf, whole, &out, entries, 16, &consumed);
+    CHECK(n == 2 && consumed == 30 + 13, "ITCH capacity: stops before the third message");
+    out.AddOrder_capacity = 8;
+    n = nasdaq_itch_v5_decode_batch(buf + consumed, whole - consumed, &out, entries, 16, &consumed);
+    CHECK(n == 1 && out.AddOrder_count == 1 && adds[0].OrderId == 2, "ITCH capacity: resumed call");
+
+    /* Entry limit */
+    n = nasdaq_itch_v5_decode_batch(buf, whole, &out, entries, 1, &consumed);
+    CHECK(n == 1 && consumed == 30, "ITCH entry limit");
+
+    /* NULL array: validated and reported, not stored */
+    out.DeleteOrder = NULL;
+    n = nasdaq_itch_v5_decode_batch(buf, whole, &out, entries, 16, &consumed);
+    CHECK(n == 3 && entries[1].row == NASDAQ_ITCH_V5_NO_ROW && entries[1].status == MARKET_STATUS_OK,
+          "ITCH NULL array");
+    out.DeleteOrder = dels;
+
+    /* Undecodable message stops an unframed stream with an error entry */
+    buf[30] = 'Z';
+    n = nasdaq_itch_v5_decode_batch(buf, whole, &out, entries, 16, &consumed);
+    CHECK(n == 2 && consumed == 30, "ITCH error: stop at bad message");
+    CHECK(entries[1].status == MARKET_STATUS_UNKNOWN_TYPE && entries[1].type == NASDAQ_ITCH_V5_MSG_NONE &&
+          entries[1].row == NASDAQ_ITCH_V5_NO_ROW && entries[1].length == 0,
+          "ITCH error: entry");
+    buf[30] = 'D';
+
+    /* Framed block: a bad frame is reported and skipped */
+    uint8_t framed[256];
+    size_t fl = 0;
+    fl += put_be(framed + fl, 30, 2);
+    fl += itch_add(framed + fl, 1, 10, 'B', 5, "SPY     ", 5000);
+    fl += put_be(framed + fl, 13, 2);
+    fl += itch_delete(framed + fl, 2, 10);
+    framed[fl - 13] = 'Q';
+    fl += put_be(framed + fl, 13, 2);
+    fl += itch_delete(framed + fl, 3, 10);
+    n = nasdaq_itch_v5_decode_framed(framed, fl, 3, &out, entries, 16, &consumed);
+    CHECK(n == 3 && consumed == fl, "ITCH framed: entries/consumed");
+    CHECK(entries[0].offset == 2 && entries[1].status == MARKET_STATUS_UNKNOWN_TYPE &&
+          entries[2].status == MARKET_STATUS_OK && dels[0].Timestamp == 3,
+          "ITCH framed: error frame skipped");
+
+    CHECK(nasdaq_itch_v5_record_size(NASDAQ_ITCH_V5_MSG_AddOrder) == sizeof(nasdaq_itch_v5_AddOrder) &&
+          nasdaq_itch_v5_record_size(NASDAQ_ITCH_V5_MSG_COUNT) == 0,
+          "ITCH record_size");
+    CHECK(strcmp(nasdaq_itch_v5_message_name(NASDAQ_ITCH_V5_MSG_DeleteOrder), "DeleteOrder") == 0 &&
+          nasdaq_itch_v5_message_name(NASDAQ_ITCH_V5_MSG_NONE) == NULL,
+          "ITCH message_name");
+    return 0;
+}
+
+static size_t boe_cross(uint8_t* p, uint64_t bits, int groups) {
+    size_t o = 0;
+    o += put_le(p + o, bits, 8);
+    memcpy(p + o, "CROSS123456789012345", 20);
+    o += 20;
+    p[o++] = (uint8_t)groups;
+    for (int i = 0; i < groups; ++i) {
+        p[o++] = (uint8_t)(i % 2 ? 2 : 1);
+        o += put_le(p + o, 1000u * (uint32_t)(i + 1), 4);
+        memcpy(p + o, "ORDER12345678901234X", 20);
+        o += 20;
+        if (bits & (1u << 9)) {
+            memcpy(p + o, "ACCOUNT123456789", 16);
+            o += 16;
+        }
+    }
+    return o;
+}
+
+static int test_boe(void) {
+    uint8_t buf[512];
+    size_t len = 0;
+    /* NewOrderCross has no preamble in this schema; framed input carries it */
+    size_t first = boe_cross(buf + 2, 1u << 9, 2);
+    put_be(buf, first, 2);
+    len = 2 + first;
+    size_t second = boe_cross(buf + len + 2, 0, 3);
+    put_be(buf + len, second, 2);
+    len += 2 + second;
+
+    cboe_boe_v3_NewOrderCross crosses[4];
+    cboe_boe_v3_NewOrderCrossGroups rows[8];
+    cboe_boe_v3_entry entries[4];
+    cboe_boe_v3_batch out;
+    memset(&out, 0, sizeof(out));
+    out.NewOrderCross = crosses;
+    out.NewOrderCross_capacity = 4;
+    out.NewOrderCross_groups = rows;
+    out.NewOrderCross_groups_capacity = 8;
+
+    size_t consumed = 0;
+    size_t n = cboe_boe_v3_decode_framed(buf, len, 2, &out, entries, 4, &consumed);
+    /* dispatch_boe requires the 0xBABA preamble, which NewOrderCross lacks */
+    CHECK(n == 2 && consumed == len, "BOE framed: entries/consumed");
+    CHECK(entries[0].status == MARKET_STATUS_BAD_VALUE, "BOE framed: dispatcher preamble check");
+
+    /* LoginRequest through the dispatcher */
+    uint8_t login[64];
+    size_t o = 0;
+    o += put_le(login + o, 0xBABA, 2);
+    o += put_le(login + o, 29, 2);
+    login[o++] = 0x01;
+    memcpy(login + o, "USER", 4);
+    o += 4;
+    memcpy(login + o, "PASSWORD123456789012", 20);
+    o += 20;
+    cboe_boe_v3_LoginRequest logins[2];
+    out.LoginRequest = logins;
+    out.LoginRequest_capacity = 2;
+    n = cboe_boe_v3_decode_batch(login, o, &out, entries, 4, &consumed);
+    CHECK(n == 1 && consumed == 29 && entries[0].type == CBOE_BOE_V3_MSG_LoginRequest, "BOE login entry");
+    CHECK(logins[0].MessageLength == 29 && logins[0].MessageType == 0x01 && memcmp(logins[0].Username, "USER", 4) == 0,
+          "BOE login fields");
+
+    /* LoginResponse text: offset/length into the caller's buffer, no copy */
+    uint8_t resp[64];
+    memcpy(resp, login, o);
+    size_t r = o;
+    r += put_le(resp + r, 0xBABA, 2);
+    r += put_le(resp + r, 11 + 8, 2);
+    resp[r++] = 0x24;
+    resp[r++] = 'A';
+    r += put_le(resp + r, 7, 4);
+    resp[r++] = 8;
+    memcpy(resp + r, "Accepted", 8);
+    r += 8;
+    cboe_boe_v3_LoginResponse responses[2];
+    out.LoginResponse = responses;
+    out.LoginResponse_capacity = 2;
+    n = cboe_boe_v3_decode_batch(resp, r, &out, entries, 4, &consumed);
+    CHECK(n == 2 && consumed == r && entries[1].type == CBOE_BOE_V3_MSG_LoginResponse && entries[1].row == 0,
+          "BOE login response entry");
+    CHECK(responses[0].LoginResponseStatus == 'A' && responses[0].LastReceivedSequenceNumber == 7 &&
+          responses[0].LoginResponseText_length == 8 && responses[0].LoginResponseText_offset == o + 11 &&
+          memcmp(resp + responses[0].LoginResponseText_offset, "Accepted", 8) == 0,
+          "BOE login response text");
+    (void)rows;
+    return 0;
+}
+
+int main(void) {
+    if (test_itch() != 0) return 1;
+    if (test_boe() != 0) return 1;
+    printf("C ABI batch decode ok\n");
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "runtime/capture_merge.hpp"
+#include "runtime/pcap.hpp"
+
+using market::runtime::Bytes;
+using market::runtime::capture_merge;
+using market::runtime::msg_context;
+using market::runtime::pcap_packet;
+using market::runtime::pcap_reader;
+using market::runtime::status;
+
+namespace {
+
+uint32_t bswap(uint32_t v, bool swap) { return swap ? __builtin_bswap32(v) : v; }
+
+// Writes a pcap whose packets carry (source, n) as payload, at the given times.
+std::string write_pcap(const std::string& name, uint8_t source, const std::vector<uint64_t>& ts_ns, bool nanos,
+                       bool swap, size_t header_pad = 0) {
+    const std::string path = "/tmp/market_merge_" + std::to_string(::getpid()) + "_" + name + ".pcap";
+    std::ofstream out(path, std::ios::binary);
+    const uint32_t magic = nanos ? 0xa1b23c4d : 0xa1b2c3d4;
+    uint32_t g[6] = {bswap(magic, swap), 0, 0, 0, bswap(65535, swap), bswap(1, swap)};
+    const uint16_t ver[2] = {2, 4};
+    out.write(reinterpret_cast<const char*>(&g[0]), 4);
+    out.write(reinterpret_cast<const char*>(ver), 4);  // version bytes are not interpreted
+    out.write(reinterpret_cast<const char*>(&g[1]), 16);
+    for (size_t i = 0; i < ts_ns.size(); ++i) {
+        const uint64_t ts = ts_ns[i];
+        const uint32_t sec = static_cast<uint32_t>(ts / 1'000'000'000ULL);
+        const uint32_t frac = static_cast<uint32_t>(nanos ? ts % 1'000'000'000ULL : (ts % 1'000'000'000ULL) / 1000);
+        std::vector<uint8_t> payload(header_pad, 0xEE);
+        payload.push_back(source);
+        payload.push_back(static_cast<uint8_t>(i));
+        const uint32_t len = static_cast<uint32_t>(payload.size());
+        const uint32_t rec[4] = {bswap(sec, swap), bswap(frac, swap), bswap(len, swap), bswap(len, swap)};
+        out.write(reinterpret_cast<const char*>(rec), sizeof(rec));
+        out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    }
+    return path;
+}
+
+}
+
+int main() {
+    const uint64_t base = 1'700'000'000ULL * 1'000'000'000ULL;
+    // Whole microseconds, so the usec-resolution captures represent them exactly
+    auto us = [base](uint64_t v) { return base + v * 1000; };
+    const std::string a = write_pcap("a", 0, {us(1000), us(4000), us(7000), us(9000)}, false, false);
+    const std::string b = write_pcap("b", 1, {us(2000), us(4000), us(8000)}, true, false);
+    const std::string c = write_pcap("c", 2, {us(500), us(3000), us(4000), us(10000)}, false, true, 42);
+    const std::string empty = write_pcap("e", 3, {}, false, false);
+    int rc = 0;
+
+    // Single reader: headers in either byte order and resolution
+    {
+        pcap_reader r;
+        pcap_packet p;
+        if (r.open(c, 42) != status::ok || !r.next(p) || p.ts_ns != us(500) || p.data.size() != 2 ||
+            p.data[0] != 2 || p.data[1] != 0) {
+            std::cerr << "pcap_reader failed on swapped capture with payload offset" << std::endl;
+            rc = 1;
+        }
+        pcap_reader missing;
+        if (missing.open("/nonexistent/market.pcap") == status::ok) {
+            std::cerr << "pcap_reader opened a missing file" << std::endl;
+            rc = 1;
+        }
+    }
+
+    // Merge: global timestamp order, ties broken by add() order, tags reported
+    if (rc == 0) {
+        capture_merge m;
+        if (m.add(a, 10) != status::ok || m.add(b, 11) != status::ok || m.add(c, 12, 42) != status::ok ||
+            m.add(empty, 13) != status::ok) {
+            std::cerr << "capture_merge failed to open inputs" << std::endl;
+            rc = 1;
+        }
+        struct seen {
+            uint64_t ts;
+            uint8_t src;
+            uint8_t n;
+            uint32_t feed;
+            uint64_t seq;
+        };
+        std::vector<seen> out;
+        m.for_each([&](Bytes payload, const msg_context& ctx) {
+            out.push_back({ctx.capture_ns, payload[0], payload[1], ctx.feed, ctx.packet_seq});
+        });
+        const std::vector<std::pair<uint8_t, uint8_t>> expect = {
+            {2, 0}, {0, 0}, {1, 0}, {2, 1}, {0, 1}, {1, 1}, {2, 2}, {0, 2}, {1, 2}, {0, 3}, {2, 3}};
+        bool ok = out.size() == expect.size();
+        for (size_t i = 0; ok && i < out.size(); ++i) {
+            ok = out[i].src == expect[i].first && out[i].n == expect[i].second &&
+                 out[i].feed == 10u + out[i].src && out[i].seq == out[i].n + 1u &&
+                 (i == 0 || out[i - 1].ts <= out[i].ts);
+        }
+        if (!ok) {
+            std::cerr << "capture_merge order/tag mismatch" << std::endl;
+            rc = 1;
+        }
+    }
+
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+    std::remove(c.c_str());
+    std::remove(empty.c_str());
+    return rc;
+}
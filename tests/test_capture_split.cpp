@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "runtime/capture_split.hpp"
+#include "runtime/pcap.hpp"
+
+using market::runtime::Bytes;
+using market::runtime::pcap_packet;
+using market::runtime::pcap_reader;
+using market::runtime::split_config;
+using market::runtime::split_writer;
+using market::runtime::status;
+
+namespace {
+
+int fail(const char* what) {
+    std::cerr << "test_capture_split: " << what << std::endl;
+    return 1;
+}
+
+struct Record {
+    uint64_t ts_ns;
+    std::vector<uint8_t> payload;
+};
+
+bool exists(const std::string& path) {
+    struct stat st {};
+    return ::stat(path.c_str(), &st) == 0;
+}
+
+// Every output reads back as a pcap holding exactly its records, in order.
+bool verify(const split_writer& w, const std::vector<std::vector<Record>>& expected) {
+    for (uint32_t i = 0; i < expected.size(); ++i) {
+        if (expected[i].empty()) {
+            if (exists(w.path(i))) return false;
+            continue;
+        }
+        pcap_reader r;
+        if (r.open(w.path(i)) != status::ok || !r.nanosecond_resolution()) return false;
+        pcap_packet p;
+        for (const Record& rec : expected[i]) {
+            if (!r.next(p) || p.ts_ns != rec.ts_ns || p.orig_len != rec.payload.size() ||
+                p.data.size() != rec.payload.size() ||
+                !std::equal(p.data.begin(), p.data.end(), rec.payload.begin()))
+                return false;
+        }
+        if (r.next(p)) return false;
+    }
+    return true;
+}
+
+}
+
+int main() {
+    const std::string dir = "/tmp/market_split_" + std::to_string(::getpid());
+    if (::mkdir(dir.c_str(), 0755) != 0) return fail("mkdir");
+
+    // Small buffers and four descriptors for 40 outputs: constant flushing,
+    // evictions and reopen-for-append
+    split_config cfg;
+    cfg.buffer_bytes = 512;
+    cfg.max_open = 4;
+    constexpr uint32_t kOutputs = 40;
+    std::vector<std::vector<Record>> expected(kOutputs);
+    {
+        split_writer w(cfg);
+        for (uint32_t i = 0; i < kOutputs; ++i) {
+            if (w.add(dir + "/out_" + std::to_string(i) + ".pcap") != i) return fail("add");
+        }
+        uint64_t rng = 88172645463325252ull;
+        const uint64_t base = 1'700'000'000ULL * 1'000'000'000ULL;
+        for (uint64_t n = 0; n < 20000; ++n) {
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            const uint32_t out = static_cast<uint32_t>(rng % (kOutputs - 3));  // the last three stay empty
+            Record rec{base + n * 1237, std::vector<uint8_t>(1 + rng % 48)};
+            // Now and then one record larger than a whole buffer
+            if (n % 997 == 0) rec.payload.resize(cfg.buffer_bytes * 3);
+            for (size_t k = 0; k < rec.payload.size(); ++k) rec.payload[k] = static_cast<uint8_t>(n + k);
+            if (w.write(out, rec.ts_ns, Bytes{rec.payload.data(), rec.payload.size()}) != status::ok)
+                return fail("write");
+            if (w.open_files() > cfg.max_open) return fail("descriptor bound");
+            expected[out].push_back(std::move(rec));
+        }
+        if (w.write(kOutputs, 0, Bytes{}) != status::bad_value) return fail("unknown output");
+        if (w.close() != status::ok || w.open_files() != 0 || w.error() != 0) return fail("close");
+        if (w.stats().records != 20000 || w.stats().evictions == 0 || w.stats().opens <= kOutputs - 3)
+            return fail("stats");
+        if (!verify(w, expected)) return fail("read back");
+    }
+
+    // A new writer on the same paths truncates instead of appending
+    {
+        split_writer w(cfg);
+        const uint8_t one[3] = {1, 2, 3};
+        (void)w.add(dir + "/out_0.pcap");
+        if (w.write(0, 42, Bytes{one, sizeof(one)}) != status::ok || w.close() != status::ok) return fail("rewrite");
+        std::vector<std::vector<Record>> again{{Record{42, {1, 2, 3}}}};
+        if (!verify(w, again)) return fail("truncate");
+    }
+
+    // An output that cannot be created reports the error
+    {
+        split_writer w(cfg);
+        const uint8_t one[1] = {7};
+        (void)w.add(dir + "/missing/out.pcap");
+        (void)w.write(0, 1, Bytes{one, sizeof(one)});
+        if (w.close() != status::bad_value || w.error() == 0) return fail("open error");
+    }
+
+    for (uint32_t i = 0; i < kOutputs; ++i) std::remove((dir + "/out_" + std::to_string(i) + ".pcap").c_str());
+    ::rmdir(dir.c_str());
+    std::cout << "capture split ok" << std::endl;
+    return 0;
+}
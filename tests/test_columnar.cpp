@@ -0,0 +1,190 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "runtime/catchup.hpp"
+#include "runtime/columnar.hpp"
+#include "runtime/status.hpp"
+
+#include "../generated/cboe_boe_v3/encoder.hpp"
+#include "../generated/cboe_boe_v3/decoder.hpp"
+#include "../generated/nasdaq_itch_5/encoder.hpp"
+#include "../generated/nasdaq_itch_5/decoder.hpp"
+#include "../generated/nasdaq_itch_5/handler.hpp"
+
+// Columnar batch encode (Encoder::encode_batch) must produce exactly the bytes
+// of one Encoder::encode call per message, for every tile boundary.
+namespace itch = nasdaq::itch::v5;
+namespace boe = cboe::boe::v3;
+using market::runtime::framing;
+using market::runtime::status;
+
+namespace {
+
+int fail(const char* what) {
+    std::cerr << "test_columnar: " << what << std::endl;
+    return 1;
+}
+
+struct Columns {
+    std::vector<uint32_t> ts, shares, px;
+    std::vector<uint64_t> id;
+    std::vector<char> side;
+    std::vector<std::array<char, 8>> sym;
+
+    explicit Columns(size_t n) : ts(n), shares(n), px(n), id(n), side(n), sym(n) {
+        for (size_t i = 0; i < n; ++i) {
+            ts[i] = static_cast<uint32_t>(1000 + i);
+            id[i] = 0x0102030405060708ull * (i + 1);
+            side[i] = (i & 1) ? 'S' : 'B';
+            shares[i] = static_cast<uint32_t>(100 * (i + 1));
+            std::memcpy(sym[i].data(), "SYM     ", 8);
+            sym[i][3] = static_cast<char>('A' + i % 26);
+            px[i] = static_cast<uint32_t>(1'000'000 + 25 * i);
+        }
+    }
+
+    itch::AddOrderColumns view() const {
+        itch::AddOrderColumns c;
+        c.Timestamp = ts.data();
+        c.OrderId = id.data();
+        c.Side = side.data();
+        c.Shares = shares.data();
+        c.Symbol = sym.data();
+        c.Price = px.data();
+        return c;
+    }
+
+    itch::AddOrder row(size_t i) const {
+        itch::AddOrder m;
+        m.Type = 'A';
+        m.Timestamp = ts[i];
+        m.OrderId = id[i];
+        m.Side = side[i];
+        m.Shares = shares[i];
+        m.Symbol = sym[i];
+        m.Price = px[i];
+        return m;
+    }
+};
+
+struct Counter {
+    size_t adds = 0;
+    uint64_t last_id = 0;
+    void on(const itch::AddOrder& m) { ++adds; last_id = m.OrderId; }
+};
+
+// to_wire against a byte-at-a-time reference, across the SIMD body and tail.
+template<class U>
+bool check_to_wire() {
+    namespace columnar = market::runtime::columnar;
+    std::array<U, 37> src{};
+    std::array<U, 37> dst{};
+    for (size_t i = 0; i < src.size(); ++i) src[i] = static_cast<U>(0x0102030405060708ull * (i + 1));
+    columnar::to_wire<std::endian::big>(src.data(), dst.data(), src.size(), U{0});
+    for (size_t i = 0; i < src.size(); ++i) {
+        std::array<uint8_t, sizeof(U)> be{};
+        for (size_t b = 0; b < sizeof(U); ++b) be[b] = static_cast<uint8_t>(src[i] >> (8 * (sizeof(U) - 1 - b)));
+        if (std::memcmp(&dst[i], be.data(), sizeof(U)) != 0) return false;
+    }
+    columnar::to_wire<std::endian::native>(static_cast<const U*>(nullptr), dst.data(), 5, U{7});
+    return dst[4] == U{7};
+}
+
+}  // namespace
+
+int main() {
+    if (!check_to_wire<uint16_t>() || !check_to_wire<uint32_t>() || !check_to_wire<uint64_t>())
+        return fail("to_wire byte order");
+
+    // Sizes around the tile width
+    for (size_t n : {size_t{0}, size_t{1}, size_t{31}, size_t{32}, size_t{33}, size_t{100}}) {
+        const Columns cols(n);
+        std::vector<uint8_t> batch(n * 30 + 7, 0xEE);
+        size_t written = 0;
+        if (itch::Encoder::encode_batch(cols.view(), n, batch.data(), batch.size(), written) != status::ok ||
+            written != n * 30)
+            return fail("AddOrder batch size");
+        std::array<uint8_t, 64> one{};
+        for (size_t i = 0; i < n; ++i) {
+            size_t w = 0;
+            if (itch::Encoder::encode(cols.row(i), one.data(), one.size(), w) != status::ok || w != 30 ||
+                std::memcmp(one.data(), batch.data() + i * 30, 30) != 0)
+                return fail("AddOrder batch differs from per-message encode");
+        }
+        if (batch[n * 30] != 0xEE) return fail("AddOrder batch wrote past its output");
+    }
+
+    // Framed output reads back through dispatch_itch_framed
+    {
+        const size_t n = 70;
+        const Columns cols(n);
+        std::vector<uint8_t> framed(n * 32);
+        size_t written = 0;
+        if (itch::Encoder::encode_batch(cols.view(), n, framed.data(), framed.size(), written, framing::u16_be) !=
+                status::ok ||
+            written != n * 32 || framed[0] != 0 || framed[1] != 30)
+            return fail("AddOrder framed batch");
+        Counter h;
+        size_t consumed = 0;
+        size_t messages = 0;
+        if (itch::dispatch_itch_framed(market::runtime::Bytes{framed.data(), written}, n, h, consumed, messages) !=
+                status::ok ||
+            messages != n || h.adds != n || h.last_id != cols.id[n - 1])
+            return fail("AddOrder framed batch dispatch");
+    }
+
+    // Short output: nothing written
+    {
+        const Columns cols(4);
+        std::array<uint8_t, 119> small{};
+        size_t written = 1;
+        if (itch::Encoder::encode_batch(cols.view(), 4, small.data(), small.size(), written) != status::short_buffer ||
+            written != 0)
+            return fail("AddOrder short output");
+    }
+
+    // Null columns encode the field default; constant fields come from the schema
+    {
+        const std::vector<uint64_t> ids = {7, 8, 9};
+        itch::DeleteOrderColumns c;
+        c.OrderId = ids.data();
+        std::array<uint8_t, 64> buf{};
+        size_t written = 0;
+        if (itch::Encoder::encode_batch(c, ids.size(), buf.data(), buf.size(), written) != status::ok ||
+            written != 3 * 13)
+            return fail("DeleteOrder batch");
+        itch::DeleteOrder d;
+        size_t consumed = 0;
+        if (itch::Decoder::decode(buf.data() + 13, 13, d, consumed) != status::ok || d.Type != 'D' ||
+            d.OrderId != 8 || d.Timestamp != 0)
+            return fail("DeleteOrder batch decode");
+    }
+
+    // Little-endian schema with length and discriminator filled by the encoder
+    {
+        std::array<std::array<char, 4>, 2> users{{{'U', 'S', 'R', '1'}, {'U', 'S', 'R', '2'}}};
+        std::array<std::array<char, 20>, 2> pws{};
+        boe::LoginRequestColumns c;
+        c.Username = users.data();
+        c.Password = pws.data();
+        std::array<uint8_t, 64> buf{};
+        size_t written = 0;
+        if (boe::Encoder::encode_batch(c, 2, buf.data(), buf.size(), written) != status::ok || written != 58)
+            return fail("LoginRequest batch");
+        boe::LoginRequest m;
+        m.StartOfMessage = 0xBABA;
+        m.MessageType = boe::MessageType::LoginRequest;
+        m.Username = users[1];
+        std::array<uint8_t, 64> one{};
+        size_t w = 0;
+        if (boe::Encoder::encode(m, one.data(), one.size(), w) != status::ok || w != 29 ||
+            std::memcmp(one.data(), buf.data() + 29, 29) != 0)
+            return fail("LoginRequest batch differs from per-message encode");
+    }
+
+    std::cout << "Columnar batch encode ok" << std::endl;
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "runtime/conflation_queue.hpp"
+#include "runtime/top_of_book.hpp"
+
+using market::runtime::conflation_queue;
+using market::runtime::top_of_book;
+
+static top_of_book make_tob(uint32_t symbol, uint64_t seq) {
+    top_of_book t;
+    t.sequence = seq;
+    t.bid_price = 10000 + symbol * 100 + (seq % 50);
+    t.ask_price = t.bid_price + 1;
+    t.bid_size = seq * 3 + symbol;
+    t.ask_size = seq * 7 + symbol;
+    return t;
+}
+
+static bool consistent(uint32_t symbol, const top_of_book& t) {
+    const top_of_book e = make_tob(symbol, t.sequence);
+    return t.bid_price == e.bid_price && t.ask_price == e.ask_price && t.bid_size == e.bid_size &&
+           t.ask_size == e.ask_size;
+}
+
+int main() {
+    // Newer state overwrites the pending entry; order follows first update
+    {
+        conflation_queue<top_of_book> q(4);
+        q.push(2, make_tob(2, 1));
+        q.push(0, make_tob(0, 2));
+        q.push(2, make_tob(2, 3));
+        q.push(2, make_tob(2, 4));
+        if (q.pending() != 2 || q.conflated() != 2) {
+            std::cerr << "Conflation did not collapse repeated symbol updates" << std::endl;
+            return 1;
+        }
+        uint32_t id = 0;
+        top_of_book t;
+        if (!q.pop(id, t) || id != 2 || t.sequence != 4) {
+            std::cerr << "Expected newest state for first dirty symbol" << std::endl;
+            return 1;
+        }
+        if (!q.pop(id, t) || id != 0 || t.sequence != 2 || q.pop(id, t)) {
+            std::cerr << "Unexpected conflation queue contents" << std::endl;
+            return 1;
+        }
+        // A symbol becomes pending again once consumed
+        q.push(2, make_tob(2, 5));
+        size_t seen = q.drain([](uint32_t sym, const top_of_book& v) {
+            if (sym != 2 || v.sequence != 5) std::cerr << "drain delivered wrong entry" << std::endl;
+        });
+        if (seen != 1 || q.pending() != 0) {
+            std::cerr << "Re-enqueue after consume failed" << std::endl;
+            return 1;
+        }
+    }
+
+    // Fast producer, slow consumer: bounded memory, monotonic and consistent
+    // per-symbol state, and the final state of every symbol is delivered.
+    {
+        constexpr uint32_t kSymbols = 64;
+        constexpr uint64_t kUpdates = 400'000;
+        conflation_queue<top_of_book> q(kSymbols);
+        std::atomic<bool> done{false};
+        std::vector<uint64_t> last(kSymbols, 0);
+        int errors = 0;
+
+        std::thread consumer([&] {
+            uint32_t id;
+            top_of_book t;
+            while (true) {
+                const bool finished = done.load(std::memory_order_acquire);
+                bool any = false;
+                while (q.pop(id, t)) {
+                    any = true;
+                    if (id >= kSymbols || !consistent(id, t) || t.sequence <= last[id]) ++errors;
+                    last[id] = t.sequence;
+                    if (q.pending() > kSymbols) ++errors;
+                }
+                if (!any && finished) break;
+                std::this_thread::yield();
+            }
+        });
+
+        std::vector<uint64_t> final_seq(kSymbols, 0);
+        for (uint64_t n = 1; n <= kUpdates; ++n) {
+            const uint32_t sym = static_cast<uint32_t>((n * 2654435761u) % kSymbols);
+            q.push(sym, make_tob(sym, n));
+            final_seq[sym] = n;
+        }
+        done.store(true, std::memory_order_release);
+        consumer.join();
+
+        if (errors != 0) {
+            std::cerr << "Conflation consumer saw torn, stale or unbounded state" << std::endl;
+            return 1;
+        }
+        if (last != final_seq) {
+            std::cerr << "Final per-symbol state not delivered" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,227 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "runtime/dsl.hpp"
+#include "runtime/status.hpp"
+
+#include "../generated/cboe_boe_v3/encoder.hpp"
+#include "../generated/cboe_boe_v3/decoder.hpp"
+#include "../generated/nasdaq_itch_5/encoder.hpp"
+#include "../generated/nasdaq_itch_5/decoder.hpp"
+
+namespace dsl = market::runtime::dsl;
+using market::runtime::status;
+
+// DSL layouts over the generated structs, so both codecs can be compared
+// byte for byte and status for status.
+namespace boe = cboe::boe::v3;
+namespace itch = nasdaq::itch::v5;
+
+using LoginRequestLayout = dsl::message<boe::LoginRequest,
+    dsl::constant<&boe::LoginRequest::StartOfMessage, 0xBABA, std::endian::little>,
+    dsl::length<&boe::LoginRequest::MessageLength, std::endian::little>,
+    dsl::message_type<&boe::LoginRequest::MessageType, boe::MessageType::LoginRequest>,
+    dsl::field<&boe::LoginRequest::Username>,
+    dsl::field<&boe::LoginRequest::Password>>;
+
+using NewOrderCrossLayout = dsl::message<boe::NewOrderCross,
+    dsl::presence<&boe::NewOrderCross::PresenceBits, std::endian::little>,
+    dsl::field<&boe::NewOrderCross::CrossId>,
+    dsl::field<&boe::NewOrderCross::GroupCount>,
+    dsl::group<&boe::NewOrderCross::groups, &boe::NewOrderCross::GroupCount,
+        dsl::field<&boe::NewOrderCrossGroups::Side>,
+        dsl::field<&boe::NewOrderCrossGroups::AllocQty, std::endian::little>,
+        dsl::field<&boe::NewOrderCrossGroups::ClOrdId>,
+        dsl::optional<&boe::NewOrderCrossGroups::Account, 9>>>;
+
+using AddOrderLayout = dsl::message<itch::AddOrder,
+    dsl::constant<&itch::AddOrder::Type, 'A'>,
+    dsl::field<&itch::AddOrder::Timestamp>,
+    dsl::field<&itch::AddOrder::OrderId>,
+    dsl::field<&itch::AddOrder::Side>,
+    dsl::field<&itch::AddOrder::Shares>,
+    dsl::field<&itch::AddOrder::Symbol>,
+    dsl::field<&itch::AddOrder::Price>>;
+
+static_assert(AddOrderLayout::is_fixed_size && AddOrderLayout::min_size == 30);
+static_assert(AddOrderLayout::field_count == 7 && !AddOrderLayout::has_presence_map);
+static_assert(LoginRequestLayout::is_fixed_size && LoginRequestLayout::min_size == 29);
+static_assert(!NewOrderCrossLayout::is_fixed_size && NewOrderCrossLayout::min_size == 29);
+static_assert(NewOrderCrossLayout::has_groups && NewOrderCrossLayout::has_optional);
+
+// A message defined only through the DSL: multi-byte enum, top-level optional
+// fields and a big-endian presence map.
+enum class Venue : uint16_t { XNAS = 0x0101, BATS = 0x0202 };
+
+struct Quote {
+    uint16_t Length{};
+    uint8_t Kind{};
+    uint32_t Presence{};
+    Venue Where{};
+    uint64_t Bid{};
+    uint64_t Ask{};
+    std::array<char, 6> Tag{};
+};
+
+using QuoteLayout = dsl::message<Quote,
+    dsl::length<&Quote::Length, std::endian::little>,
+    dsl::message_type<&Quote::Kind, 0x51>,
+    dsl::presence<&Quote::Presence>,
+    dsl::field<&Quote::Where>,
+    dsl::optional<&Quote::Bid, 0>,
+    dsl::optional<&Quote::Ask, 1, std::endian::little>,
+    dsl::field<&Quote::Tag>>;
+
+static_assert(QuoteLayout::min_size == 2 + 1 + 4 + 2 + 6);
+
+template<typename Layout, typename M>
+static bool same_as_generated(const char* name, const M& msg, auto& gen_encoder, auto& gen_decoder) {
+    std::array<uint8_t, 512> a{};
+    std::array<uint8_t, 512> b{};
+    size_t wa = 0, wb = 0;
+    if (Layout::encode(msg, a.data(), a.size(), wa) != status::ok ||
+        gen_encoder(msg, b.data(), b.size(), wb) != status::ok || wa != wb ||
+        std::memcmp(a.data(), b.data(), wa) != 0 || Layout::encoded_size(msg) != wa) {
+        std::cerr << name << ": DSL encoding differs from generated" << std::endl;
+        return false;
+    }
+    // Every truncation and every single-byte corruption yields the same status
+    // and consumed count from both decoders.
+    for (size_t len = 0; len <= wa; ++len) {
+        for (size_t flip = 0; flip <= wa; ++flip) {
+            std::array<uint8_t, 512> in = a;
+            if (flip < wa) in[flip] ^= 0x5A;
+            M da{};
+            M db{};
+            size_t ca = 99, cb = 99;
+            const status sa = Layout::decode(in.data(), len, da, ca);
+            const status sb = gen_decoder(in.data(), len, db, cb);
+            if (sa != sb || ca != cb) {
+                std::cerr << name << ": status mismatch at len=" << len << " flip=" << flip << ": "
+                          << market::runtime::status_to_string(sa) << " vs "
+                          << market::runtime::status_to_string(sb) << std::endl;
+                return false;
+            }
+        }
+    }
+    M out{};
+    size_t consumed = 0;
+    if (Layout::decode(market::runtime::Bytes{a.data(), wa}, out, consumed) != status::ok || consumed != wa) {
+        std::cerr << name << ": DSL decode failed" << std::endl;
+        return false;
+    }
+    size_t again = 0;
+    if (Layout::encode(out, market::runtime::MutBytes{b.data(), b.size()}, again) != status::ok || again != wa ||
+        std::memcmp(a.data(), b.data(), wa) != 0) {
+        std::cerr << name << ": DSL round-trip differs" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    auto boe_enc = [](const auto& m, uint8_t* o, size_t n, size_t& w) { return boe::Encoder::encode(m, o, n, w); };
+    auto boe_dec = [](const uint8_t* i, size_t n, auto& m, size_t& c) { return boe::Decoder::decode(i, n, m, c); };
+    auto itch_enc = [](const auto& m, uint8_t* o, size_t n, size_t& w) { return itch::Encoder::encode(m, o, n, w); };
+    auto itch_dec = [](const uint8_t* i, size_t n, auto& m, size_t& c) { return itch::Decoder::decode(i, n, m, c); };
+
+    // BOE LoginRequest: LE constant, length field, discriminator
+    {
+        boe::LoginRequest m{};
+        m.MessageType = boe::MessageType::LoginRequest;
+        std::memcpy(m.Username.data(), "USER", 4);
+        std::memcpy(m.Password.data(), "PASSWORD123456789012", 20);
+        if (!same_as_generated<LoginRequestLayout>("LoginRequest", m, boe_enc, boe_dec)) return 1;
+    }
+
+    // BOE NewOrderCross: presence map, repeating group with an optional field
+    for (uint64_t bits : {uint64_t{0}, uint64_t{1} << 9}) {
+        boe::NewOrderCross m{};
+        m.PresenceBits = bits;
+        std::memcpy(m.CrossId.data(), "CROSS123456789012345", 20);
+        for (int i = 0; i < 3; ++i) {
+            boe::NewOrderCrossGroups g{};
+            g.Side = static_cast<uint8_t>(i % 2 ? boe::Side::Sell : boe::Side::Buy);
+            g.AllocQty = 1000u * static_cast<uint32_t>(i + 1);
+            std::memcpy(g.ClOrdId.data(), "ORDER12345678901234X", 20);
+            std::memcpy(g.Account.data(), "ACCOUNT123456789", 16);
+            m.groups.push_back(g);
+        }
+        if (!same_as_generated<NewOrderCrossLayout>("NewOrderCross", m, boe_enc, boe_dec)) return 1;
+    }
+
+    // ITCH AddOrder: big-endian fields, char constant
+    {
+        itch::AddOrder m{};
+        m.Type = 'A';
+        m.Timestamp = 123456u;
+        m.OrderId = 0x1234567890ABCDEFULL;
+        m.Side = 'B';
+        m.Shares = 300u;
+        std::memcpy(m.Symbol.data(), "MSFT    ", 8);
+        m.Price = 4012500u;
+        if (!same_as_generated<AddOrderLayout>("AddOrder", m, itch_enc, itch_dec)) return 1;
+    }
+
+    // Short output buffer
+    {
+        itch::AddOrder m{};
+        std::array<uint8_t, 16> small{};
+        size_t written = 7;
+        if (AddOrderLayout::encode(m, small.data(), small.size(), written) != status::short_buffer || written != 0) {
+            std::cerr << "Short buffer not reported" << std::endl;
+            return 1;
+        }
+    }
+
+    // DSL-only message: optional fields and enum width
+    {
+        Quote q{};
+        q.Kind = 0x51;
+        q.Presence = 0x2;  // Ask only
+        q.Where = Venue::BATS;
+        q.Bid = 111;
+        q.Ask = 0x0102030405060708ULL;
+        std::memcpy(q.Tag.data(), "ABCDEF", 6);
+
+        std::array<uint8_t, 64> buf{};
+        size_t written = 0;
+        if (QuoteLayout::encode(q, buf.data(), buf.size(), written) != status::ok || written != 23) {
+            std::cerr << "Quote encode: written=" << written << std::endl;
+            return 1;
+        }
+        const uint8_t expect[] = {23, 0, 0x51, 0, 0, 0, 2, 0x02, 0x02,
+                                  8, 7, 6, 5, 4, 3, 2, 1, 'A', 'B', 'C', 'D', 'E', 'F'};
+        if (std::memcmp(buf.data(), expect, sizeof(expect)) != 0) {
+            std::cerr << "Quote wire layout differs" << std::endl;
+            return 1;
+        }
+
+        Quote out{};
+        out.Bid = 999;  // absent on the wire: must be cleared
+        size_t consumed = 0;
+        if (QuoteLayout::decode(buf.data(), written, out, consumed) != status::ok || consumed != written ||
+            out.Bid != 0 || out.Ask != q.Ask || out.Where != Venue::BATS || out.Tag != q.Tag) {
+            std::cerr << "Quote decode mismatch" << std::endl;
+            return 1;
+        }
+
+        buf[2] = 0x52;
+        if (QuoteLayout::decode(buf.data(), written, out, consumed) != status::unknown_type || consumed != 0) {
+            std::cerr << "Quote discriminator not checked" << std::endl;
+            return 1;
+        }
+        buf[2] = 0x51;
+        buf[0] = 22;
+        if (QuoteLayout::decode(buf.data(), written, out, consumed) != status::bad_value) {
+            std::cerr << "Quote length not checked" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "DSL codecs match generated code" << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+#include "runtime/multicast_ring.hpp"
+
+using market::runtime::multicast_ring;
+using market::runtime::ring_barrier;
+using market::runtime::ring_cursor;
+
+namespace {
+
+struct event {
+    uint64_t value{0};
+    uint64_t booked{0};  // written by the book stage, read by the recorder
+};
+
+}
+
+int main() {
+    // Single-threaded: claim/publish/consume batches and gating on a full ring
+    {
+        multicast_ring<event> ring(6);
+        ring_cursor done;
+        ring.add_gating(done);
+        auto in = ring.barrier();
+        if (ring.capacity() != 8) {
+            std::cerr << "Capacity not rounded to power of two" << std::endl;
+            return 1;
+        }
+        int64_t hi = ring.claim(8);
+        for (int64_t s = 0; s <= hi; ++s) ring[s].value = static_cast<uint64_t>(s);
+        ring.publish(hi);
+        int64_t probe;
+        if (ring.try_claim(1, probe)) {
+            std::cerr << "Producer lapped the gating consumer" << std::endl;
+            return 1;
+        }
+        uint64_t sum = 0;
+        size_t ends = 0;
+        size_t n = ring.consume(in, done, [&](event& e, int64_t, bool end) {
+            sum += e.value;
+            ends += end;
+        });
+        if (n != 8 || sum != 28 || ends != 1 || done.get() != 7) {
+            std::cerr << "Batch consume mismatch" << std::endl;
+            return 1;
+        }
+        if (!ring.try_claim(3, probe) || probe != 10) {
+            std::cerr << "Claim after release failed" << std::endl;
+            return 1;
+        }
+    }
+
+    // Pipeline: book -> recorder (dependent), plus an independent stats stage
+    {
+        constexpr int64_t kCount = 500'000;
+        multicast_ring<event> ring(1024);
+        ring_cursor book_done, rec_done, stats_done;
+        auto book_in = ring.barrier();
+        auto rec_in = ring.barrier({&book_done});
+        auto stats_in = ring.barrier();
+        ring.add_gating(rec_done);
+        ring.add_gating(stats_done);
+
+        std::atomic<int> errors{0};
+        uint64_t rec_sum = 0, stats_sum = 0;
+
+        std::thread book([&] {
+            while (book_done.get() < kCount - 1) {
+                if (!ring.consume(book_in, book_done, [&](event& e, int64_t, bool) { e.booked = e.value * 2; })) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        std::thread recorder([&] {
+            int64_t expect = 0;
+            while (rec_done.get() < kCount - 1) {
+                if (!ring.consume(rec_in, rec_done, [&](event& e, int64_t s, bool) {
+                        if (s != expect++ || e.booked != e.value * 2) errors.fetch_add(1);
+                        rec_sum += e.value;
+                    })) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        std::thread stats([&] {
+            while (stats_done.get() < kCount - 1) {
+                if (!ring.consume(stats_in, stats_done, [&](event& e, int64_t, bool) { stats_sum += e.value; })) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        int64_t next = 0;
+        while (next < kCount) {
+            const size_t batch = static_cast<size_t>(std::min<int64_t>(16, kCount - next));
+            int64_t hi;
+            while (!ring.try_claim(batch, hi)) {
+                std::this_thread::yield();
+            }
+            for (int64_t s = hi - static_cast<int64_t>(batch) + 1; s <= hi; ++s) {
+                ring[s].value = static_cast<uint64_t>(s + 1);
+                ring[s].booked = 0;
+            }
+            ring.publish(hi);
+            next = hi + 1;
+        }
+        book.join();
+        recorder.join();
+        stats.join();
+
+        const uint64_t expect = static_cast<uint64_t>(kCount) * (kCount + 1) / 2;
+        if (errors.load() != 0 || rec_sum != expect || stats_sum != expect) {
+            std::cerr << "Multicast pipeline mismatch: errors=" << errors.load() << " rec=" << rec_sum
+                      << " stats=" << stats_sum << " expect=" << expect << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
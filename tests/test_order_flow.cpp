@@ -0,0 +1,222 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+#include "runtime/flat_map.hpp"
+#include "runtime/histogram.hpp"
+#include "runtime/order_flow.hpp"
+
+using market::runtime::flat_u64_map;
+using market::runtime::log_histogram;
+using market::runtime::order_flow_tracker;
+
+// Shapes of the generated ITCH AddOrder / DeleteOrder
+struct AddOrder {
+    char Type{'A'};
+    uint32_t Timestamp{};
+    uint64_t OrderId{};
+    char Side{};
+    uint32_t Shares{};
+    std::array<char, 8> Symbol{};
+    uint32_t Price{};
+};
+
+struct DeleteOrder {
+    char Type{'D'};
+    uint32_t Timestamp{};
+    uint64_t OrderId{};
+};
+
+static_assert(market::runtime::add_order_message<AddOrder>);
+static_assert(market::runtime::delete_order_message<DeleteOrder>);
+static_assert(!market::runtime::delete_order_message<AddOrder>);
+
+static std::array<char, 8> sym(const char* s) {
+    std::array<char, 8> a;
+    a.fill(' ');
+    std::memcpy(a.data(), s, std::strlen(s));
+    return a;
+}
+
+static AddOrder add(uint64_t id, const char* s, char side, uint32_t px, uint32_t qty, uint32_t ts) {
+    AddOrder a;
+    a.OrderId = id;
+    a.Symbol = sym(s);
+    a.Side = side;
+    a.Price = px;
+    a.Shares = qty;
+    a.Timestamp = ts;
+    return a;
+}
+
+static DeleteOrder del(uint64_t id, uint32_t ts) {
+    DeleteOrder d;
+    d.OrderId = id;
+    d.Timestamp = ts;
+    return d;
+}
+
+int main() {
+    // Histogram: exact below 2^SubBits, bounded relative error above, mergeable
+    {
+        log_histogram<4> a, b;
+        for (uint64_t v = 1; v <= 1000; ++v) (v % 2 ? a : b).record(v);
+        a.merge(b);
+        if (a.count() != 1000 || a.min() != 1 || a.max() != 1000) {
+            std::cerr << "histogram merge lost samples" << std::endl;
+            return 1;
+        }
+        const uint64_t p50 = a.quantile(0.5);
+        const uint64_t p99 = a.quantile(0.99);
+        if (p50 < 500 || p50 > 500 + 500 / 16 + 1 || p99 < 990 || p99 > 1000) {
+            std::cerr << "histogram quantiles out of bounds: p50=" << p50 << " p99=" << p99 << std::endl;
+            return 1;
+        }
+        for (uint64_t v : {uint64_t{0}, uint64_t{15}, uint64_t{16}, uint64_t{12345}, ~uint64_t{0}}) {
+            const size_t i = log_histogram<4>::index(v);
+            if (i >= log_histogram<4>::kBuckets || log_histogram<4>::upper_bound(i) < v) {
+                std::cerr << "histogram bucket does not cover " << v << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // Open-addressed map against std::unordered_map under add/delete churn
+    {
+        flat_u64_map<uint64_t> m(16);
+        std::unordered_map<uint64_t, uint64_t> ref;
+        std::mt19937_64 rng(7);
+        for (int i = 0; i < 200000; ++i) {
+            const uint64_t k = rng() % 5000;
+            if (rng() % 3 == 0) {
+                if (m.erase(k) != (ref.erase(k) == 1)) {
+                    std::cerr << "flat map erase mismatch" << std::endl;
+                    return 1;
+                }
+            } else {
+                m.insert(k, k * 3 + i);
+                ref[k] = k * 3 + i;
+            }
+        }
+        if (m.size() != ref.size()) {
+            std::cerr << "flat map size mismatch" << std::endl;
+            return 1;
+        }
+        for (const auto& [k, v] : ref) {
+            const uint64_t* p = m.find(k);
+            if (!p || *p != v) {
+                std::cerr << "flat map lost key " << k << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // ~0 marks empty slots; as a key it is stored out of line
+    {
+        constexpr uint64_t kMax = flat_u64_map<uint64_t>::kEmpty;
+        flat_u64_map<uint64_t> m(16);
+        m.insert(1, 10);
+        if (m.find(kMax) || m.erase(kMax) || m.size() != 1 || !m.find(1)) {
+            std::cerr << "flat map absent ~0 key" << std::endl;
+            return 1;
+        }
+        m.insert(kMax, 20);
+        for (uint64_t k = 2; k < 100; ++k) m.insert(k, k);  // rehashes with ~0 present
+        const uint64_t* v = m.find(kMax);
+        size_t visited = 0;
+        m.for_each([&](uint64_t, uint64_t) { ++visited; });
+        if (!v || *v != 20 || m.size() != 100 || visited != 100) {
+            std::cerr << "flat map ~0 key" << std::endl;
+            return 1;
+        }
+        if (!m.erase(kMax) || m.find(kMax) || m.size() != 99 || !m.find(1)) {
+            std::cerr << "flat map erase ~0 key" << std::endl;
+            return 1;
+        }
+    }
+
+    // An unseen order id ~0 is unknown, also before any symbol exists, and
+    // leaves resting orders alone
+    {
+        order_flow_tracker empty(64);
+        empty.on(del(~0ULL, 5));
+        if (empty.unknown_orders() != 1 || empty.symbol_count() != 0) {
+            std::cerr << "~0 delete on an empty tracker" << std::endl;
+            return 1;
+        }
+        order_flow_tracker t(64);
+        t.on(add(1, "AAPL", 'B', 1000, 100, 10));
+        t.on(del(~0ULL, 20));
+        const auto* aapl = t.find(sym("AAPL"));
+        if (t.open_orders() != 1 || t.unknown_orders() != 1 || !aapl || aapl->cancels != 0) {
+            std::cerr << "~0 delete disturbed the book" << std::endl;
+            return 1;
+        }
+        t.on(add(~0ULL, "AAPL", 'B', 1000, 50, 30));
+        t.on(del(~0ULL, 40));
+        if (t.open_orders() != 1 || t.unknown_orders() != 1 || aapl->cancels != 1) {
+            std::cerr << "~0 order id not tracked" << std::endl;
+            return 1;
+        }
+    }
+
+    // Lifetimes, cancel-to-add ratio and queue position at cancel
+    {
+        order_flow_tracker t(64);
+        t.on(add(1, "AAPL", 'B', 1000, 100, 10));
+        t.on(add(2, "AAPL", 'B', 1000, 200, 20));
+        t.on(add(3, "AAPL", 'B', 1000, 300, 30));
+        t.on(add(4, "MSFT", 'S', 2000, 50, 40));
+        // Order 3 had 300 ahead on arrival; order 1 leaves first, so only 200 remain
+        t.on(del(1, 110));
+        t.on(del(3, 530));
+        t.on(del(99, 600));  // unknown order id
+
+        const auto* aapl = t.find(sym("AAPL"));
+        if (!aapl || aapl->adds != 3 || aapl->cancels != 2 || aapl->cancel_to_add() < 0.66 ||
+            aapl->cancel_to_add() > 0.67) {
+            std::cerr << "AAPL counts wrong" << std::endl;
+            return 1;
+        }
+        if (aapl->lifetime.min() != 100 || aapl->lifetime.max() != 500) {
+            std::cerr << "AAPL lifetimes wrong" << std::endl;
+            return 1;
+        }
+        if (aapl->queue_ahead.min() != 0 || aapl->queue_ahead.max() != 200) {
+            std::cerr << "AAPL queue position at cancel wrong: " << aapl->queue_ahead.max() << std::endl;
+            return 1;
+        }
+        if (t.open_orders() != 2 || t.unknown_orders() != 1 || t.symbol_count() != 2) {
+            std::cerr << "tracker bookkeeping wrong" << std::endl;
+            return 1;
+        }
+
+        // Executions and replaces through the event interface
+        t.on_execute(2, 50, 700);
+        t.on_replace(2, 5, 1001, 150, 800);
+        t.on_execute(5, 150, 900);
+        if (aapl->executions != 2 || aapl->replaces != 1 || aapl->filled != 1 || t.open_orders() != 1) {
+            std::cerr << "execute/replace bookkeeping wrong" << std::endl;
+            return 1;
+        }
+
+        // Shards merge by symbol
+        order_flow_tracker shard(64);
+        shard.on(add(10, "MSFT", 'S', 2000, 10, 0));
+        shard.on(del(10, 1000));
+        shard.on(add(11, "TSLA", 'B', 3000, 10, 0));
+        t.merge(shard);
+        const auto* msft = t.find(sym("MSFT"));
+        if (!msft || msft->adds != 2 || msft->cancels != 1 || !t.find(sym("TSLA")) ||
+            t.totals().adds != 6) {
+            std::cerr << "shard merge wrong" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "Order-flow analytics tests passed!" << std::endl;
+    return 0;
+}
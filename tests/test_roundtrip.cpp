@@ -2,6 +2,8 @@
 #include <cstring>
 #include <cassert>
 #include <iostream>
+#include <string>
+#include <string_view>
 #include "runtime/status.hpp"
 #include "runtime/bytes.hpp"
 
@@ -37,6 +39,19 @@
 #include "../generated/nasdaq_itch_5/handler.hpp"
 #endif
 
+#if __has_include("../generated/cboe_boe_v3/warmup.hpp")
+#include "../generated/cboe_boe_v3/warmup.hpp"
+#endif
+
+#if __has_include("../generated/nasdaq_itch_5/warmup.hpp")
+#include "../generated/nasdaq_itch_5/warmup.hpp"
+#endif
+
+#include "runtime/catchup.hpp"
+#include "runtime/fanout.hpp"
+#include "runtime/order_flow.hpp"
+#include "runtime/warmup.hpp"
+
 int main() {
 #if HAS_GENERATED_BOE
     using namespace cboe::boe::v3;
@@ -481,6 +496,70 @@ int main() {
             return 1;
         }
     }
+
+    // BOE LoginResponse: u8 length-prefixed vstring decoded as a view into the input
+    {
+        using namespace cboe::boe::v3;
+        LoginResponse original;
+        original.MessageType = MessageType::LoginResponse;
+        original.LoginResponseStatus = 'A';
+        original.LastReceivedSequenceNumber = 0x01020304;
+        original.LoginResponseText = "Session accepted";
+
+        std::array<uint8_t, 128> buffer{};
+        size_t written = 0;
+        if (Encoder::encode(original, buffer.data(), buffer.size(), written) != market::runtime::status::ok ||
+            written != 11 + 16 || market::runtime::load_le<uint32_t>(buffer.data() + 6) != 0x01020304 ||
+            buffer[10] != 16 || std::memcmp(buffer.data() + 11, "Session accepted", 16) != 0) {
+            std::cerr << "BOE LoginResponse encode mismatch" << std::endl;
+            return 1;
+        }
+
+        struct ResponseHandler {
+            std::string_view text;
+            uint32_t last_received = 0;
+            void on(const LoginResponse& msg) {
+                text = msg.LoginResponseText;
+                last_received = msg.LastReceivedSequenceNumber;
+            }
+        } handler;
+        size_t consumed = 0;
+        if (dispatch_boe(market::runtime::Bytes{buffer.data(), written}, handler, consumed) !=
+                market::runtime::status::ok ||
+            consumed != written || handler.text != "Session accepted" || handler.last_received != 0x01020304 ||
+            handler.text.data() != reinterpret_cast<const char*>(buffer.data()) + 11) {
+            std::cerr << "BOE LoginResponse text is not a view into the input" << std::endl;
+            return 1;
+        }
+
+        // Empty text, truncated data, and the schema's max_length on both sides
+        LoginResponse decoded;
+        original.LoginResponseText = {};
+        if (Encoder::encode(original, buffer.data(), buffer.size(), written) != market::runtime::status::ok ||
+            written != 11 || Decoder::decode(buffer.data(), written, decoded, consumed) != market::runtime::status::ok ||
+            !decoded.LoginResponseText.empty()) {
+            std::cerr << "BOE LoginResponse empty text round-trip failed" << std::endl;
+            return 1;
+        }
+        original.LoginResponseText = "Session accepted";
+        Encoder::encode(original, buffer.data(), buffer.size(), written);
+        if (Decoder::decode(buffer.data(), written - 1, decoded, consumed) != market::runtime::status::short_buffer) {
+            std::cerr << "BOE LoginResponse truncated text not reported" << std::endl;
+            return 1;
+        }
+        const std::string too_long(61, 'x');
+        original.LoginResponseText = too_long;
+        if (Encoder::encode(original, buffer.data(), buffer.size(), written) != market::runtime::status::bad_value ||
+            written != 0) {
+            std::cerr << "BOE LoginResponse text above max_length was encoded" << std::endl;
+            return 1;
+        }
+        buffer[10] = 61;
+        if (Decoder::decode(buffer.data(), buffer.size(), decoded, consumed) != market::runtime::status::bad_value) {
+            std::cerr << "BOE LoginResponse text above max_length was decoded" << std::endl;
+            return 1;
+        }
+    }
 #endif
 
 #if __has_include("../generated/nasdaq_itch_5/handler.hpp")
@@ -539,8 +618,333 @@ int main() {
             return 1;
         }
     }
+
+    // Test ITCH dispatch through a fan-out of partial handlers
+    {
+        using namespace nasdaq::itch::v5;
+
+        std::array<uint8_t, 64> add_buf{};
+        std::array<uint8_t, 64> del_buf{};
+        size_t add_size = 0;
+        size_t del_size = 0;
+
+        AddOrder add;
+        add.Type = 'A';
+        add.OrderId = 77;
+        add.Side = 'S';
+        add.Shares = 300u;
+        std::memcpy(add.Symbol.data(), "FANOUT  ", 8);
+        add.Price = 4200u;
+        DeleteOrder del;
+        del.Type = 'D';
+        del.OrderId = 77;
+
+        if (nasdaq::itch::v5::Encoder::encode(add, add_buf.data(), add_buf.size(), add_size) != market::runtime::status::ok ||
+            nasdaq::itch::v5::Encoder::encode(del, del_buf.data(), del_buf.size(), del_size) != market::runtime::status::ok) {
+            std::cerr << "ITCH encode for fanout test failed" << std::endl;
+            return 1;
+        }
+
+        // Handles both message types
+        struct Book {
+            uint64_t live_shares = 0;
+            void on(const AddOrder& m) { live_shares += m.Shares; }
+            void on(const DeleteOrder&) { live_shares = 0; }
+        } book;
+
+        // Handles AddOrder only; DeleteOrder must be skipped at compile time
+        struct AddCounter {
+            int adds = 0;
+            uint64_t last_order = 0;
+            void on(const AddOrder& m) { ++adds; last_order = m.OrderId; }
+        } counter;
+
+        // Counts every message it sees
+        struct Recorder {
+            int seen = 0;
+            void on(const AddOrder&) { ++seen; }
+            void on(const DeleteOrder&) { ++seen; }
+        } recorder;
+
+        auto h = market::runtime::fanout(book, counter, recorder);
+
+        size_t consumed = 0;
+        if (dispatch_itch(market::runtime::Bytes{add_buf.data(), add_size}, h, consumed) != market::runtime::status::ok ||
+            consumed != add_size) {
+            std::cerr << "ITCH fanout dispatch (AddOrder) failed" << std::endl;
+            return 1;
+        }
+        if (book.live_shares != 300u || counter.adds != 1 || counter.last_order != 77 || recorder.seen != 1) {
+            std::cerr << "ITCH fanout did not reach every AddOrder handler" << std::endl;
+            return 1;
+        }
+
+        if (dispatch_itch(market::runtime::Bytes{del_buf.data(), del_size}, h, consumed) != market::runtime::status::ok ||
+            consumed != del_size) {
+            std::cerr << "ITCH fanout dispatch (DeleteOrder) failed" << std::endl;
+            return 1;
+        }
+        if (book.live_shares != 0u || counter.adds != 1 || recorder.seen != 2) {
+            std::cerr << "ITCH fanout DeleteOrder routing mismatch" << std::endl;
+            return 1;
+        }
+        if (&h.get<1>() != &counter) {
+            std::cerr << "ITCH fanout get<> returned wrong handler" << std::endl;
+            return 1;
+        }
+    }
+#endif
+
+#if __has_include("../generated/nasdaq_itch_5/handler.hpp")
+    // Receive metadata reaches on(msg, ctx) handlers, including through a fan-out
+    {
+        using namespace nasdaq::itch::v5;
+        AddOrder add;
+        add.Type = 'A';
+        add.OrderId = 5;
+        add.Side = 'S';
+        add.Shares = 10;
+        add.Price = 20;
+        std::array<uint8_t, 64> buf{};
+        size_t size = 0;
+        nasdaq::itch::v5::Encoder::encode(add, buf.data(), buf.size(), size);
+
+        struct CtxHandler {
+            uint64_t recv = 0, seq = 0;
+            uint32_t feed = 0, offset = 0;
+            void on(const AddOrder&, const market::runtime::msg_context& ctx) {
+                recv = ctx.recv_ns;
+                seq = ctx.packet_seq;
+                feed = ctx.feed;
+                offset = ctx.offset;
+            }
+        } with_ctx;
+        struct PlainHandler {
+            size_t adds = 0;
+            void on(const AddOrder&) { ++adds; }
+        } plain;
+
+        market::runtime::msg_context ctx;
+        ctx.recv_ns = 1234;
+        ctx.packet_seq = 99;
+        ctx.feed = 2;
+        ctx.offset = 18;
+        size_t consumed = 0;
+        auto h = market::runtime::fanout(with_ctx, plain);
+        if (dispatch_itch(market::runtime::Bytes{buf.data(), size}, h, consumed, ctx) != market::runtime::status::ok ||
+            with_ctx.recv != 1234 || with_ctx.seq != 99 || with_ctx.feed != 2 || with_ctx.offset != 18 ||
+            plain.adds != 1) {
+            std::cerr << "ITCH dispatch did not deliver receive context" << std::endl;
+            return 1;
+        }
+
+        // No context supplied: context-only handlers see an empty one
+        with_ctx.seq = 7;
+        if (dispatch_itch(market::runtime::Bytes{buf.data(), size}, with_ctx, consumed) != market::runtime::status::ok ||
+            with_ctx.seq != 0) {
+            std::cerr << "ITCH dispatch without context mishandled on(msg, ctx)" << std::endl;
+            return 1;
+        }
+    }
+#endif
+
+#if __has_include("../generated/nasdaq_itch_5/handler.hpp")
+    // Order-flow analytics as an ITCH handler
+    {
+        using namespace nasdaq::itch::v5;
+        std::array<uint8_t, 256> run{};
+        size_t run_size = 0;
+        for (uint64_t i = 1; i <= 4; ++i) {
+            AddOrder a;
+            a.Type = 'A';
+            a.Timestamp = static_cast<uint32_t>(i * 10);
+            a.OrderId = i;
+            a.Side = 'B';
+            a.Shares = 100;
+            a.Price = 5000;
+            std::memcpy(a.Symbol.data(), "ZVZZT   ", 8);
+            size_t w = 0;
+            nasdaq::itch::v5::Encoder::encode(a, run.data() + run_size, run.size() - run_size, w);
+            run_size += w;
+        }
+        for (uint64_t i : {uint64_t{4}, uint64_t{1}}) {
+            DeleteOrder d;
+            d.Type = 'D';
+            d.Timestamp = 1000;
+            d.OrderId = i;
+            size_t w = 0;
+            nasdaq::itch::v5::Encoder::encode(d, run.data() + run_size, run.size() - run_size, w);
+            run_size += w;
+        }
+
+        market::runtime::order_flow_tracker flow(64);
+        size_t consumed = 0, messages = 0;
+        std::array<char, 8> zvzzt;
+        std::memcpy(zvzzt.data(), "ZVZZT   ", 8);
+        dispatch_itch_batch(market::runtime::Bytes{run.data(), run_size}, flow, consumed, messages);
+        const auto* f = flow.find(zvzzt);
+        // Order 4 had 300 shares ahead; order 1 had none
+        if (messages != 6 || !f || f->adds != 4 || f->cancels != 2 || f->lifetime.max() != 990 ||
+            f->queue_ahead.max() != 300 || f->queue_ahead.min() != 0 || flow.open_orders() != 2) {
+            std::cerr << "ITCH order-flow analytics mismatch" << std::endl;
+            return 1;
+        }
+    }
+#endif
+
+#if __has_include("../generated/nasdaq_itch_5/handler.hpp")
+    // Catch-up batch paths: back-to-back and u16-length-framed runs
+    {
+        using namespace nasdaq::itch::v5;
+        std::array<uint8_t, 1024> run{};
+        std::array<uint8_t, 1024> framed{};
+        size_t run_size = 0, framed_size = 0;
+        for (uint64_t i = 0; i < 20; ++i) {
+            size_t w = 0;
+            if (i % 2 == 0) {
+                AddOrder a;
+                a.Type = 'A';
+                a.OrderId = i;
+                a.Side = 'B';
+                a.Shares = 1;
+                nasdaq::itch::v5::Encoder::encode(a, run.data() + run_size, run.size() - run_size, w);
+            } else {
+                DeleteOrder d;
+                d.Type = 'D';
+                d.OrderId = i - 1;
+                nasdaq::itch::v5::Encoder::encode(d, run.data() + run_size, run.size() - run_size, w);
+            }
+            framed[framed_size] = static_cast<uint8_t>(w >> 8);
+            framed[framed_size + 1] = static_cast<uint8_t>(w);
+            std::memcpy(framed.data() + framed_size + 2, run.data() + run_size, w);
+            framed_size += 2 + w;
+            run_size += w;
+        }
+
+        struct BatchHandler {
+            size_t adds = 0, deletes = 0, live_msgs = 0, batch_ends = 0;
+            void on(const AddOrder&) {
+                ++adds;
+                if (!market::runtime::catching_up()) ++live_msgs;
+            }
+            void on(const DeleteOrder&) { ++deletes; }
+            void on_batch_end() { ++batch_ends; }
+        } bh;
+        size_t consumed = 0, messages = 0;
+        if (dispatch_itch_batch(market::runtime::Bytes{run.data(), run_size}, bh, consumed, messages) !=
+                market::runtime::status::ok ||
+            consumed != run_size || messages != 20 || bh.adds != 10 || bh.deletes != 10 || bh.live_msgs != 0 ||
+            bh.batch_ends != 1 || market::runtime::catching_up()) {
+            std::cerr << "ITCH catch-up batch dispatch mismatch" << std::endl;
+            return 1;
+        }
+        if (dispatch_itch_framed(market::runtime::Bytes{framed.data(), framed_size}, 20, bh, consumed, messages) !=
+                market::runtime::status::ok ||
+            consumed != framed_size || messages != 20 || bh.adds != 20 || bh.batch_ends != 2) {
+            std::cerr << "ITCH catch-up framed dispatch mismatch" << std::endl;
+            return 1;
+        }
+        // A truncated tail stops the run after the last complete message
+        if (dispatch_itch_batch(market::runtime::Bytes{run.data(), run_size - 3}, bh, consumed, messages) !=
+                market::runtime::status::short_buffer ||
+            messages != 19 || consumed != run_size - 13) {
+            std::cerr << "ITCH catch-up batch did not stop at truncated message" << std::endl;
+            return 1;
+        }
+    }
 #endif
 
+    // Backlog detection with hysteresis
+    {
+        market::runtime::catchup_thresholds t;
+        t.enter_depth = 100;
+        t.exit_depth = 10;
+        t.enter_lag_ns = 1000;
+        t.exit_lag_ns = 100;
+        market::runtime::backlog_detector d(t);
+        using market::runtime::feed_mode;
+        if (d.update(50, 0) != feed_mode::live || d.update(100, 0) != feed_mode::catch_up ||
+            d.update(50, 0) != feed_mode::catch_up || d.update(10, 500) != feed_mode::catch_up ||
+            d.update(10, 100) != feed_mode::live || d.update(0, 1000) != feed_mode::catch_up ||
+            d.transitions() != 3) {
+            std::cerr << "backlog_detector hysteresis mismatch" << std::endl;
+            return 1;
+        }
+    }
+
+#if __has_include("../generated/nasdaq_itch_5/warmup.hpp")
+    // Warm-up drives every ITCH message type through dispatch in sandbox mode
+    {
+        using namespace nasdaq::itch::v5;
+        struct WarmHandler {
+            size_t adds = 0, deletes = 0, outside = 0;
+            void on(const AddOrder& msg) {
+                if (!market::runtime::warming_up() || msg.Type != 'A') ++outside;
+                ++adds;
+            }
+            void on(const DeleteOrder&) {
+                if (!market::runtime::warming_up()) ++outside;
+                ++deletes;
+            }
+        } warm;
+        const size_t n = nasdaq::itch::v5::warmup(warm, 16);
+        if (n != 32 || warm.adds != 16 || warm.deletes != 16 || warm.outside != 0 ||
+            market::runtime::warming_up()) {
+            std::cerr << "ITCH warmup did not deliver every message type in sandbox mode" << std::endl;
+            return 1;
+        }
+    }
+#endif
+
+#if __has_include("../generated/cboe_boe_v3/warmup.hpp")
+    // Warm-up covers BOE messages the dispatcher cannot route (decoder fallback)
+    {
+        using namespace cboe::boe::v3;
+        struct WarmHandler {
+            size_t logins = 0, responses = 0, crosses = 0, with_account = 0, acks = 0, orders = 0, heartbeats = 0;
+            void on(const LoginRequest&) { ++logins; }
+            void on(const OrderAcknowledgement&) { ++acks; }
+            void on(const NewOrder&) { ++orders; }
+            void on(const ClientHeartbeat&) { ++heartbeats; }
+            void on(const ServerHeartbeat&) { ++heartbeats; }
+            void on(const LoginResponse& msg) {
+                if (!msg.LoginResponseText.empty()) ++responses;
+            }
+            void on(const NewOrderCross& msg) {
+                ++crosses;
+                if (msg.groups.size() != 2) crosses += 1000;
+                if (msg.PresenceBits & (1ULL << 9)) ++with_account;
+            }
+        } warm;
+        const size_t n = cboe::boe::v3::warmup(warm, 8);
+        if (n != 56 || warm.logins != 8 || warm.responses != 8 || warm.crosses != 8 || warm.with_account != 4 ||
+            warm.acks != 8 || warm.orders != 8 || warm.heartbeats != 16) {
+            std::cerr << "BOE warmup message coverage mismatch" << std::endl;
+            return 1;
+        }
+    }
+#endif
+
+    // Idle re-warm scheduling and memory pre-faulting
+    {
+        market::runtime::idle_warmer warmer(1000);
+        size_t runs = 0;
+        warmer.on_activity(5000);
+        if (warmer.poll(5500, [&] { ++runs; }) || !warmer.poll(6000, [&] { ++runs; }) ||
+            warmer.poll(6500, [&] { ++runs; }) || !warmer.poll(7000, [&] { ++runs; }) || runs != 2) {
+            std::cerr << "idle_warmer scheduling mismatch" << std::endl;
+            return 1;
+        }
+        std::array<uint8_t, 10000> scratch{};
+        scratch[9999] = 7;
+        market::runtime::prefault(market::runtime::MutBytes{scratch.data(), scratch.size()});
+        market::runtime::prefault_stack<64 * 1024>();
+        if (scratch[9999] != 7) {
+            std::cerr << "prefault modified buffer contents" << std::endl;
+            return 1;
+        }
+    }
+
     // Test passes - no output on success
     return 0;
 }
@@ -0,0 +1,346 @@
+#include <array>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "runtime/bytes.hpp"
+#include "runtime/schema_interp.hpp"
+#include "runtime/status.hpp"
+
+#include "../generated/cboe_boe_v3/encoder.hpp"
+#include "../generated/nasdaq_itch_5/encoder.hpp"
+
+#ifndef MARKET_GENERATED_DIR
+#define MARKET_GENERATED_DIR "generated"
+#endif
+
+using market::runtime::status;
+using market::runtime::interp::interpreter;
+using market::runtime::interp::record;
+using market::runtime::interp::schema;
+
+int main() {
+    // Malformed descriptors are rejected
+    {
+        schema s;
+        const uint8_t junk[] = {'N', 'O', 'P', 'E', 1, 0, 0, 0};
+        if (s.load(market::runtime::Bytes{junk, sizeof(junk)}) != status::bad_value) {
+            std::cerr << "Bad descriptor magic not rejected" << std::endl;
+            return 1;
+        }
+        if (s.load(market::runtime::Bytes{junk, 3}) != status::short_buffer) {
+            std::cerr << "Truncated descriptor not rejected" << std::endl;
+            return 1;
+        }
+    }
+
+    // A forged u64 group count must not wrap past the record capacity check,
+    // and a group without fields must not loop over its count
+    {
+        // Format 2, version 1, protocol "x", one message: Count (u64 LE) and two groups on it
+        std::vector<uint8_t> d = {'M', 'D', 'S', 'D', 2, 0, 1, 0, 1, 'x', 1, 0};
+        auto u16 = [&d](uint16_t v) {
+            d.push_back(static_cast<uint8_t>(v));
+            d.push_back(static_cast<uint8_t>(v >> 8));
+        };
+        auto str = [&d](const char* t) {
+            d.push_back(static_cast<uint8_t>(std::strlen(t)));
+            d.insert(d.end(), t, t + std::strlen(t));
+        };
+        auto field = [&](const char* name, uint16_t size) {
+            str(name);
+            d.push_back(0);  // field_kind::uint
+            u16(size);
+            d.push_back(0);  // flags
+            d.push_back(0);  // optional bit
+            d.insert(d.end(), 8, 0);
+        };
+        str("Forged");
+        u16(1);
+        u16(market::runtime::interp::no_index);
+        u16(market::runtime::interp::no_index);
+        u16(market::runtime::interp::no_index);
+        field("Count", 8);
+        u16(2);
+        str("Empty");
+        u16(0);
+        u16(0);
+        str("Pairs");
+        u16(0);
+        u16(2);
+        field("A", 1);
+        field("B", 1);
+
+        schema s;
+        if (s.load(market::runtime::Bytes{d.data(), d.size()}) != status::ok) {
+            std::cerr << "Failed to load forged-count descriptor" << std::endl;
+            return 1;
+        }
+        interpreter it(s);
+        record rec;
+        size_t consumed = 0;
+        std::array<uint8_t, 64> in{};
+        in[7] = 0x80;  // Count = 2^63 (little-endian): 2^63 * 2 entries wraps to 0
+        if (it.decode_as(0, in.data(), in.size(), rec, consumed) != status::bad_value) {
+            std::cerr << "Interpreter accepted a group count beyond the record capacity" << std::endl;
+            return 1;
+        }
+    }
+
+    // Descriptors decode() cannot honour are rejected at load: more slots than
+    // a record holds, optional bits past the presence map, length prefixes
+    // other than 1 or 2 bytes, and indexes naming no field
+    {
+        struct spec {
+            uint16_t fields = 4;
+            uint16_t group_fields = 0;
+            uint8_t kind = 0;  // of the last field
+            uint16_t size = 1;
+            uint8_t optional_bit = 0;
+            uint16_t presence = market::runtime::interp::no_index;
+            uint16_t length = market::runtime::interp::no_index;
+            uint16_t discriminator = market::runtime::interp::no_index;
+        };
+        auto load = [](const spec& sp) {
+            std::vector<uint8_t> d = {'M', 'D', 'S', 'D', 2, 0, 1, 0, 1, 'x', 1, 0};
+            auto u16 = [&d](uint16_t v) {
+                d.push_back(static_cast<uint8_t>(v));
+                d.push_back(static_cast<uint8_t>(v >> 8));
+            };
+            auto field = [&](uint8_t kind, uint16_t size, uint8_t bit) {
+                d.push_back(1);
+                d.push_back('f');
+                d.push_back(kind);
+                u16(size);
+                d.push_back(0);
+                d.push_back(bit);
+                d.insert(d.end(), 8, 0);
+            };
+            d.push_back(1);
+            d.push_back('M');
+            u16(sp.fields);
+            u16(sp.presence);
+            u16(sp.length);
+            u16(sp.discriminator);
+            for (uint16_t f = 0; f + 1 < sp.fields; ++f) field(0, 1, 0);
+            field(sp.kind, sp.size, sp.optional_bit);
+            u16(sp.group_fields ? 1 : 0);
+            if (sp.group_fields) {
+                d.push_back(1);
+                d.push_back('g');
+                u16(0);
+                u16(sp.group_fields);
+                for (uint16_t f = 0; f < sp.group_fields; ++f) field(0, 1, 0);
+            }
+            schema s;
+            return s.load(market::runtime::Bytes{d.data(), d.size()});
+        };
+        auto with = [](auto edit) {
+            spec sp;
+            edit(sp);
+            return sp;
+        };
+        const struct {
+            const char* what;
+            spec sp;
+            status expect;
+        } cases[] = {
+            {"plain", spec{}, status::ok},
+            {"fields at capacity", with([](spec& s) { s.fields = 512; }), status::ok},
+            {"fields past capacity", with([](spec& s) { s.fields = 700; }), status::bad_value},
+            {"group past capacity", with([](spec& s) { s.fields = 500; s.group_fields = 13; }), status::bad_value},
+            {"group at capacity", with([](spec& s) { s.fields = 500; s.group_fields = 12; }), status::ok},
+            {"optional bit 63", with([](spec& s) { s.optional_bit = 63; }), status::ok},
+            {"optional bit 64", with([](spec& s) { s.optional_bit = 64; }), status::bad_value},
+            {"vstring prefix 2", with([](spec& s) { s.kind = 3; s.size = 2; }), status::ok},
+            {"vstring prefix 0", with([](spec& s) { s.kind = 3; s.size = 0; }), status::bad_value},
+            {"bytes prefix 4", with([](spec& s) { s.kind = 4; s.size = 4; }), status::bad_value},
+            {"presence index", with([](spec& s) { s.presence = 4; }), status::bad_value},
+            {"length index", with([](spec& s) { s.length = 4; }), status::bad_value},
+            {"discriminator index", with([](spec& s) { s.discriminator = 4; }), status::bad_value},
+            {"indexes in range", with([](spec& s) { s.presence = 0; s.length = 1; s.discriminator = 3; }), status::ok},
+        };
+        for (const auto& c : cases) {
+            if (load(c.sp) != c.expect) {
+                std::cerr << "Descriptor check failed: " << c.what << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    // ITCH: identify by Type and decode fixed-size messages
+    {
+        schema s;
+        if (s.load_file(std::string(MARKET_GENERATED_DIR) + "/nasdaq_itch_5/schema.bin") != status::ok) {
+            std::cerr << "Failed to load ITCH descriptor" << std::endl;
+            return 1;
+        }
+        if (s.protocol() != "nasdaq_itch" || s.version() != 5 || s.messages().size() != 2) {
+            std::cerr << "ITCH descriptor header mismatch" << std::endl;
+            return 1;
+        }
+        interpreter it(s);
+
+        using namespace nasdaq::itch::v5;
+        AddOrder add;
+        add.Type = 'A';
+        add.Timestamp = 123456u;
+        add.OrderId = 0x0102030405060708ULL;
+        add.Side = 'B';
+        add.Shares = 1000u;
+        std::memcpy(add.Symbol.data(), "ABCDEF  ", 8);
+        add.Price = 123450u;
+        std::array<uint8_t, 64> buf{};
+        size_t written = 0;
+        nasdaq::itch::v5::Encoder::encode(add, buf.data(), buf.size(), written);
+
+        record rec;
+        size_t consumed = 0;
+        if (it.decode(buf.data(), written, rec, consumed) != status::ok || consumed != written) {
+            std::cerr << "Interpreter ITCH AddOrder decode failed" << std::endl;
+            return 1;
+        }
+        const size_t msg = rec.message;
+        if (s.messages()[msg].name != "AddOrder") {
+            std::cerr << "Interpreter identified wrong ITCH message" << std::endl;
+            return 1;
+        }
+        auto slot = [&](const char* name) { return static_cast<size_t>(s.find_field(msg, name)); };
+        if (rec.u(slot("Timestamp")) != add.Timestamp || rec.u(slot("OrderId")) != add.OrderId ||
+            rec.u(slot("Side")) != static_cast<uint64_t>('B') || rec.u(slot("Shares")) != add.Shares ||
+            rec.u(slot("Price")) != add.Price || rec.str(slot("Symbol")) != "ABCDEF  ") {
+            std::cerr << "Interpreter ITCH AddOrder field mismatch" << std::endl;
+            return 1;
+        }
+        if (rec.str(slot("Symbol")).data() != reinterpret_cast<const char*>(buf.data()) + 18) {
+            std::cerr << "Interpreter char field is not a view into the input" << std::endl;
+            return 1;
+        }
+
+        if (it.decode(buf.data(), written - 1, rec, consumed) != status::short_buffer) {
+            std::cerr << "Interpreter accepted truncated AddOrder" << std::endl;
+            return 1;
+        }
+
+        DeleteOrder del;
+        del.Type = 'D';
+        del.Timestamp = 654321u;
+        del.OrderId = 0x0908070605040302ULL;
+        nasdaq::itch::v5::Encoder::encode(del, buf.data(), buf.size(), written);
+        if (it.decode(buf.data(), written, rec, consumed) != status::ok || consumed != 13 ||
+            s.messages()[rec.message].name != "DeleteOrder" ||
+            rec.u(static_cast<size_t>(s.find_field(rec.message, "OrderId"))) != del.OrderId) {
+            std::cerr << "Interpreter ITCH DeleteOrder decode failed" << std::endl;
+            return 1;
+        }
+
+        buf[0] = 'Z';
+        if (it.decode(buf.data(), written, rec, consumed) != status::unknown_type) {
+            std::cerr << "Interpreter accepted unknown ITCH type" << std::endl;
+            return 1;
+        }
+    }
+
+    // BOE: enum discriminator, length validation, groups and optional fields
+    {
+        schema s;
+        if (s.load_file(std::string(MARKET_GENERATED_DIR) + "/cboe_boe_v3/schema.bin") != status::ok) {
+            std::cerr << "Failed to load BOE descriptor" << std::endl;
+            return 1;
+        }
+        interpreter it(s);
+
+        using namespace cboe::boe::v3;
+        LoginRequest login;
+        std::memcpy(login.Username.data(), "ABCD", 4);
+        std::memcpy(login.Password.data(), "ABCDEFGHIJKLMNOPQRST", 20);
+        login.MessageType = MessageType::LoginRequest;
+        std::array<uint8_t, 256> buf{};
+        size_t written = 0;
+        cboe::boe::v3::Encoder::encode(login, buf.data(), buf.size(), written);
+
+        record rec;
+        size_t consumed = 0;
+        if (it.decode(buf.data(), written, rec, consumed) != status::ok || consumed != written ||
+            s.messages()[rec.message].name != "LoginRequest" ||
+            rec.str(static_cast<size_t>(s.find_field(rec.message, "Password"))) != "ABCDEFGHIJKLMNOPQRST") {
+            std::cerr << "Interpreter BOE LoginRequest decode failed" << std::endl;
+            return 1;
+        }
+
+        buf[2] = static_cast<uint8_t>(buf[2] + 1);  // corrupt MessageLength
+        if (it.decode(buf.data(), written, rec, consumed) != status::bad_value) {
+            std::cerr << "Interpreter accepted bad BOE MessageLength" << std::endl;
+            return 1;
+        }
+
+        NewOrderCross cross;
+        cross.PresenceBits = (1ULL << 9);
+        std::memcpy(cross.CrossId.data(), "CROSS234567890123456", 20);
+        NewOrderCrossGroups g1;
+        g1.Side = static_cast<uint8_t>(Side::Buy);
+        g1.AllocQty = 1500;
+        std::memcpy(g1.ClOrdId.data(), "ORDER3456789012345678", 20);
+        std::memcpy(g1.Account.data(), "ACCOUNT123456789", 16);
+        NewOrderCrossGroups g2 = g1;
+        g2.Side = static_cast<uint8_t>(Side::Sell);
+        g2.AllocQty = 2500;
+        cross.groups = {g1, g2};
+        cross.GroupCount = 2;
+        cboe::boe::v3::Encoder::encode(cross, buf.data(), buf.size(), written);
+
+        const int msg = s.find_message("NewOrderCross");
+        if (msg < 0 || it.decode_as(static_cast<size_t>(msg), buf.data(), written, rec, consumed) != status::ok ||
+            consumed != written || rec.group_size(0) != 2) {
+            std::cerr << "Interpreter BOE NewOrderCross decode failed" << std::endl;
+            return 1;
+        }
+        const auto& gfields = s.messages()[static_cast<size_t>(msg)].groups[0].fields;
+        size_t qty = 0, account = 0;
+        for (size_t i = 0; i < gfields.size(); ++i) {
+            if (gfields[i].name == "AllocQty") qty = i;
+            if (gfields[i].name == "Account") account = i;
+        }
+        if (rec.u(rec.group_slot(0, 1, qty)) != 2500 || !rec.has(rec.group_slot(0, 0, account)) ||
+            rec.str(rec.group_slot(0, 0, account)) != "ACCOUNT123456789") {
+            std::cerr << "Interpreter BOE NewOrderCross group mismatch" << std::endl;
+            return 1;
+        }
+
+        cross.PresenceBits = 0;
+        cboe::boe::v3::Encoder::encode(cross, buf.data(), buf.size(), written);
+        if (it.decode_as(static_cast<size_t>(msg), buf.data(), written, rec, consumed) != status::ok ||
+            consumed != written || rec.has(rec.group_slot(0, 1, account))) {
+            std::cerr << "Interpreter BOE NewOrderCross optional Account handling failed" << std::endl;
+            return 1;
+        }
+
+        // Length-prefixed text: view into the input, data skipped before the length check
+        LoginResponse resp;
+        resp.MessageType = MessageType::LoginResponse;
+        resp.LoginResponseStatus = 'A';
+        resp.LastReceivedSequenceNumber = 42;
+        resp.LoginResponseText = "Accepted";
+        cboe::boe::v3::Encoder::encode(resp, buf.data(), buf.size(), written);
+        const size_t text = static_cast<size_t>(s.find_field(static_cast<size_t>(s.find_message("LoginResponse")),
+                                                             "LoginResponseText"));
+        if (it.decode(buf.data(), written, rec, consumed) != status::ok || consumed != written ||
+            s.messages()[rec.message].name != "LoginResponse" || rec.str(text) != "Accepted" ||
+            rec.str(text).data() != reinterpret_cast<const char*>(buf.data()) + 11) {
+            std::cerr << "Interpreter BOE LoginResponse decode failed" << std::endl;
+            return 1;
+        }
+        if (it.decode(buf.data(), written - 1, rec, consumed) != status::short_buffer) {
+            std::cerr << "Interpreter accepted truncated LoginResponse text" << std::endl;
+            return 1;
+        }
+        buf[10] = 61;  // above max_length
+        if (it.decode(buf.data(), buf.size(), rec, consumed) != status::bad_value) {
+            std::cerr << "Interpreter accepted LoginResponse text above max_length" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "runtime/seqlock.hpp"
+#include "runtime/top_of_book.hpp"
+
+using market::runtime::seqlock;
+using market::runtime::top_of_book;
+using market::runtime::top_of_book_table;
+
+// Every snapshot the writer publishes satisfies these relations, so a torn read
+// (fields from two different updates) is detected by the readers.
+static top_of_book make_tob(uint32_t symbol, uint64_t seq) {
+    top_of_book t;
+    t.sequence = seq;
+    t.bid_price = 10000 + symbol * 100 + (seq % 50);
+    t.ask_price = t.bid_price + 1 + (seq % 3);
+    t.bid_size = seq * 3 + symbol;
+    t.ask_size = seq * 7 + symbol;
+    t.timestamp = seq ^ 0xA5A5A5A5A5A5A5A5ULL;
+    return t;
+}
+
+static bool consistent(uint32_t symbol, const top_of_book& t) {
+    if (t.sequence == 0) {
+        return t.bid_price == 0 && t.ask_price == 0 && t.bid_size == 0 && t.ask_size == 0;
+    }
+    const top_of_book expect = make_tob(symbol, t.sequence);
+    return t.bid_price == expect.bid_price && t.ask_price == expect.ask_price &&
+           t.bid_size == expect.bid_size && t.ask_size == expect.ask_size &&
+           t.timestamp == expect.timestamp;
+}
+
+int main() {
+    // Basic single-threaded semantics
+    {
+        seqlock<top_of_book> lock;
+        if (lock.version() != 0) {
+            std::cerr << "seqlock initial version != 0" << std::endl;
+            return 1;
+        }
+        lock.store(make_tob(1, 42));
+        top_of_book out;
+        if (!lock.try_load(out) || out.sequence != 42 || !consistent(1, out)) {
+            std::cerr << "seqlock try_load after store failed" << std::endl;
+            return 1;
+        }
+        if (lock.version() != 2) {
+            std::cerr << "seqlock version after one store != 2" << std::endl;
+            return 1;
+        }
+    }
+
+    // One writer, several readers polling a per-symbol table
+    {
+        constexpr uint32_t kSymbols = 16;
+        constexpr uint64_t kUpdates = 200000;
+        top_of_book_table table(kSymbols);
+
+        std::atomic<bool> done{false};
+        std::atomic<bool> error{false};
+        const int num_readers = 3;
+        std::vector<std::thread> readers;
+        std::vector<uint64_t> reads(num_readers, 0);
+
+        for (int r = 0; r < num_readers; ++r) {
+            readers.emplace_back([&, r] {
+                std::vector<uint64_t> last_seq(kSymbols, 0);
+                while (!done.load(std::memory_order_acquire)) {
+                    for (uint32_t s = 0; s < kSymbols; ++s) {
+                        top_of_book t = table.read(s);
+                        if (!consistent(s, t)) {
+                            std::cerr << "Torn top-of-book read for symbol " << s << std::endl;
+                            error.store(true);
+                            return;
+                        }
+                        if (t.sequence < last_seq[s]) {
+                            std::cerr << "Top-of-book sequence went backwards for symbol " << s
+                                      << std::endl;
+                            error.store(true);
+                            return;
+                        }
+                        last_seq[s] = t.sequence;
+                        ++reads[r];
+                    }
+                }
+            });
+        }
+
+        for (uint64_t seq = 1; seq <= kUpdates; ++seq) {
+            const uint32_t symbol = static_cast<uint32_t>(seq % kSymbols);
+            table.publish(symbol, make_tob(symbol, seq));
+        }
+        done.store(true, std::memory_order_release);
+        for (auto& t : readers) {
+            t.join();
+        }
+
+        if (error.load()) {
+            return 1;
+        }
+
+        for (uint32_t s = 0; s < kSymbols; ++s) {
+            top_of_book t = table.read(s);
+            const uint64_t expect_seq = kUpdates - ((kUpdates - s) % kSymbols);
+            if (t.sequence != expect_seq || !consistent(s, t)) {
+                std::cerr << "Final snapshot mismatch for symbol " << s << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
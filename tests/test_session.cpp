@@ -0,0 +1,352 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "boe_mock_exchange.hpp"
+
+// BOE client session against the loopback mock exchange: login, sequenced
+// orders and their acknowledgements, heartbeats, a dropped connection whose
+// lost orders are replayed after the next login, send ring wraparound with
+// replay eviction and backpressure, and a replay to a peer that stops reading.
+#if HAS_BOE_MOCK && __has_include("../generated/cboe_boe_v3/session.hpp")
+
+#include "../generated/cboe_boe_v3/session.hpp"
+
+namespace boe = cboe::boe::v3;
+using market::runtime::Bytes;
+using market::runtime::frame_reader;
+using market::runtime::session_config;
+using market::runtime::session_state;
+using market::runtime::status;
+
+namespace {
+
+int fail(const char* what) {
+    std::cerr << "test_session: " << what << std::endl;
+    return 1;
+}
+
+struct Client {
+    size_t responses = 0;
+    std::vector<boe::OrderAcknowledgement> acks;
+
+    void on(const boe::LoginResponse&) { ++responses; }
+    void on(const boe::OrderAcknowledgement& m) { acks.push_back(m); }
+};
+
+boe::LoginRequest make_login() {
+    boe::LoginRequest m;
+    m.MessageType = boe::MessageType::LoginRequest;
+    std::memcpy(m.Username.data(), "SES1", 4);
+    std::memset(m.Password.data(), 'p', m.Password.size());
+    return m;
+}
+
+boe::NewOrder make_order(int id) {
+    boe::NewOrder m;
+    m.MessageType = boe::MessageType::NewOrder;
+    std::memset(m.ClOrdId.data(), ' ', m.ClOrdId.size());
+    std::memcpy(m.ClOrdId.data(), "ORD", 3);
+    m.ClOrdId[3] = static_cast<char>('0' + id / 10);
+    m.ClOrdId[4] = static_cast<char>('0' + id % 10);
+    m.Side = static_cast<uint8_t>(boe::Side::Buy);
+    m.OrderQty = 100;
+    m.Price = 1'000'000;
+    std::memcpy(m.Symbol.data(), "AAPL    ", 8);
+    return m;
+}
+
+// Poll until `done` or a 5 s deadline; time passed to poll() is real time
+// plus `skew`, so tests can fast-forward heartbeat timers.
+template<class Pred>
+bool pump(boe::Session& s, Client& c, Pred done, uint64_t skew = 0) {
+    const uint64_t deadline = boe_mock::now_ns() + 5'000'000'000ull;
+    while (!done()) {
+        if (boe_mock::now_ns() > deadline) return false;
+        (void)s.poll(c, boe_mock::now_ns() + skew);
+    }
+    return true;
+}
+
+bool connect_and_login(boe::Session& s, Client& c, uint16_t port, int& fd) {
+    fd = boe_mock::connect_loopback(port);
+    if (fd < 0 || s.attach(fd) != status::ok || s.login(make_login()) != status::ok) return false;
+    return pump(s, c, [&] { return s.state() != session_state::logging_in; }) && s.state() == session_state::active;
+}
+
+int session_round_trips() {
+    boe_mock::mock_options opt;
+    opt.busy_poll = false;
+    opt.disconnect_after = 3;
+    boe_mock::mock_exchange ex(opt);
+    const uint16_t port = ex.start();
+    if (port == 0) return fail("listen");
+
+    session_config cfg;
+    cfg.heartbeat_ns = 50'000'000;
+    boe::Session s(cfg);
+    if (!s.valid()) return fail("session setup");
+    Client c;
+
+    // Nothing sequenced goes out before login
+    auto early = make_order(0);
+    if (s.send(early) != status::bad_value) return fail("send before login");
+
+    int fd = -1;
+    if (!connect_and_login(s, c, port, fd) || c.responses != 1) return fail("login");
+
+    // Sequenced orders, acknowledged in order
+    for (int i = 1; i <= 3; ++i) {
+        auto m = make_order(i);
+        if (s.send(m) != status::ok || m.SequenceNumber != static_cast<uint32_t>(i)) return fail("send order");
+    }
+    if (!pump(s, c, [&] { return c.acks.size() == 3; })) return fail("acknowledgements");
+    for (size_t i = 0; i < 3; ++i) {
+        if (c.acks[i].ClOrdId != make_order(static_cast<int>(i + 1)).ClOrdId || c.acks[i].SequenceNumber != i + 1)
+            return fail("acknowledgement contents");
+    }
+
+    // The exchange drops the connection after three orders: these two are lost
+    for (int i = 4; i <= 5; ++i) {
+        auto m = make_order(i);
+        (void)s.send(m);
+    }
+    if (!pump(s, c, [&] { return s.state() == session_state::disconnected; })) return fail("disconnect");
+    ::close(fd);
+    if (s.next_seq() != 6) return fail("next sequence number");
+
+    // The next login reports 3 received; the session resends 4 and 5
+    if (!connect_and_login(s, c, port, fd) || c.responses != 2) return fail("re-login");
+    if (!pump(s, c, [&] { return c.acks.size() == 5; })) return fail("replayed acknowledgements");
+    if (s.stats().replayed != 2 || c.acks[3].ClOrdId != make_order(4).ClOrdId ||
+        c.acks[4].ClOrdId != make_order(5).ClOrdId)
+        return fail("replay");
+
+    // Idle for longer than the heartbeat interval
+    const size_t hb_sent = s.stats().heartbeats_sent;
+    (void)s.poll(c, boe_mock::now_ns() + 2 * cfg.heartbeat_ns);
+    if (s.stats().heartbeats_sent != hb_sent + 1) return fail("heartbeat");
+    if (!pump(s, c, [&] { return ex.heartbeats() >= 1; }, 2 * cfg.heartbeat_ns)) return fail("heartbeat received");
+    if (s.peer_silent(boe_mock::now_ns()) || !s.peer_silent(boe_mock::now_ns() + 2 * cfg.peer_timeout_ns))
+        return fail("peer timeout");
+
+    ::close(fd);
+    ex.stop();
+    if (ex.sessions() != 2 || ex.logins() != 2 || ex.orders() != 5 || ex.sequence_errors() != 0 || ex.errors() != 0)
+        return fail("exchange counters");
+    if (s.stats().inbound_gaps != 0 || s.stats().inbound_errors != 0) return fail("inbound sequence");
+    return 0;
+}
+
+int ring_wraparound() {
+    boe_mock::mock_options opt;
+    opt.busy_poll = false;
+    boe_mock::mock_exchange ex(opt);
+    const uint16_t port = ex.start();
+    if (port == 0) return fail("listen");
+
+    // A 4 KiB ring holds about 75 NewOrders; only 16 are kept for replay
+    session_config cfg;
+    cfg.ring_bytes = 4096;
+    cfg.replay_slots = 16;
+    cfg.max_message = 256;
+    cfg.zerocopy_min = 1024;  // loopback: the kernel copies, completions still arrive
+    boe::Session s(cfg);
+    Client c;
+    int fd = -1;
+    if (!connect_and_login(s, c, port, fd)) return fail("login");
+
+    size_t queued = 0;
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 40; ++i) {
+            auto m = make_order(i);
+            const status st = s.queue(m);
+            if (st == status::short_buffer) break;  // ring full of unsent bytes
+            if (st != status::ok) return fail("queue");
+            ++queued;
+        }
+        if (s.flush() != status::ok) return fail("flush");
+        if (!pump(s, c, [&] { return c.acks.size() == queued && s.pending_bytes() == 0; })) return fail("drain");
+    }
+    if (queued < 20 * 16) return fail("ring capacity");
+    if (s.next_seq() != queued + 1 || s.oldest_replayable() != queued + 1 - 16) return fail("replay window");
+    for (size_t i = 0; i < c.acks.size(); ++i) {
+        if (c.acks[i].SequenceNumber != i + 1) return fail("acknowledgement order");
+    }
+
+    // Evicted messages cannot be replayed; retained ones can
+    if (s.replay(1) != status::bad_value) return fail("replay evicted");
+    if (s.replay(s.next_seq() - 4) != status::ok) return fail("replay retained");
+    if (!pump(s, c, [&] { return ex.orders() == queued + 4; })) return fail("replayed orders");
+
+    // Backpressure: without a flush, queue() stops once the ring is full of
+    // unsent bytes instead of overwriting them
+    size_t held = 0;
+    for (;;) {
+        auto m = make_order(static_cast<int>(held % 100));
+        const status st = s.queue(m);
+        if (st == status::short_buffer) break;
+        if (st != status::ok || ++held > 1000) return fail("backpressure");
+    }
+    if (held == 0 || s.pending_bytes() < cfg.ring_bytes / 2) return fail("ring full");
+    if (!pump(s, c, [&] { return ex.orders() == queued + 4 + held && s.pending_bytes() == 0; }))
+        return fail("drain after backpressure");
+
+    ::close(fd);
+    ex.stop();
+    if (ex.sequence_errors() != 4 || ex.errors() != 0) return fail("exchange counters");
+    std::cout << "  zero-copy: " << (s.zerocopy() ? "on" : "unavailable") << ", sends=" << s.stats().zerocopy_sends
+              << " copied=" << s.stats().zerocopy_copied << std::endl;
+    return 0;
+}
+
+// The exchange end of a socketpair, driven by hand: it reads only when told to.
+struct Peer {
+    int fd = -1;
+    frame_reader rx;
+    uint8_t out[boe_mock::kMaxFrame];
+    std::vector<uint32_t> orders;
+    size_t logins = 0;
+    size_t heartbeats = 0;
+    size_t errors = 0;
+
+    void on(const boe::LoginRequest&) { ++logins; }
+    void on(const boe::NewOrder& m) { orders.push_back(m.SequenceNumber); }
+    void on(const boe::ClientHeartbeat&) { ++heartbeats; }
+
+    // Decode whatever has arrived
+    void drain() {
+        Bytes frame;
+        while (rx.fill(fd, true) > 0) {
+            while (rx.next(frame) == status::ok) {
+                size_t consumed = 0;
+                if (boe::dispatch_boe(frame, *this, consumed) != status::ok) ++errors;
+            }
+        }
+    }
+
+    bool login_response(uint32_t last_received) {
+        boe::LoginResponse r;
+        r.StartOfMessage = 0xBABA;
+        r.MessageType = boe::MessageType::LoginResponse;
+        r.LoginResponseStatus = 'A';
+        r.LastReceivedSequenceNumber = last_received;
+        r.LoginResponseText = std::string_view("Accepted");
+        return boe_mock::send_message(fd, r, out, sizeof(out)) == status::ok;
+    }
+
+    bool server_heartbeat() {
+        boe::ServerHeartbeat h;
+        h.StartOfMessage = 0xBABA;
+        h.MessageType = boe::MessageType::ServerHeartbeat;
+        return boe_mock::send_message(fd, h, out, sizeof(out)) == status::ok;
+    }
+};
+
+// A fresh socketpair with a small send buffer on the session's end; the
+// session logs in and the peer answers with `last_received`.
+bool connect_pair(boe::Session& s, Client& c, Peer& peer, int& fd, uint32_t last_received) {
+    int sv[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) return false;
+    const int small = 4096;
+    ::setsockopt(sv[0], SOL_SOCKET, SO_SNDBUF, &small, sizeof(small));
+    fd = sv[0];
+    peer.fd = sv[1];
+    peer.rx.reset();
+    if (s.attach(fd) != status::ok || s.login(make_login()) != status::ok) return false;
+    const size_t logins = peer.logins;
+    peer.drain();
+    if (peer.logins != logins + 1 || !peer.login_response(last_received)) return false;
+    return pump(s, c, [&] { return s.state() != session_state::logging_in; }) && s.state() == session_state::active;
+}
+
+int replay_to_stalled_peer() {
+    session_config cfg;
+    cfg.heartbeat_ns = 50'000'000;
+    boe::Session s(cfg);
+    Client c;
+    Peer peer;
+    int fd = -1;
+    if (!connect_pair(s, c, peer, fd, 0)) return fail("stalled: login");
+
+    // Far more orders than the socket buffers hold, all received
+    constexpr uint32_t kOrders = 400;
+    for (uint32_t i = 1; i <= kOrders; ++i) {
+        auto m = make_order(static_cast<int>(i % 100));
+        if (s.queue(m) != status::ok) return fail("stalled: queue");
+        if (s.flush() != status::ok) return fail("stalled: flush");
+        peer.drain();
+    }
+    if (!pump(s, c, [&] {
+            peer.drain();
+            return peer.orders.size() == kOrders;
+        }))
+        return fail("stalled: first delivery");
+    ::close(fd);
+    ::close(peer.fd);
+
+    // Reconnect; the peer claims nothing arrived and then stops reading. The
+    // login response is dispatched and poll() returns with the replay partly sent
+    peer.orders.clear();
+    if (!connect_pair(s, c, peer, fd, 0)) return fail("stalled: re-login");
+    if (!s.replaying() || s.stats().replayed >= kOrders) return fail("stalled: replay in progress");
+    auto held = make_order(0);
+    if (s.queue(held) != status::short_buffer) return fail("stalled: queue during replay");
+
+    // Inbound traffic is still read meanwhile, and a due heartbeat waits its turn
+    const uint64_t hb_received = s.stats().heartbeats_received;
+    if (!peer.server_heartbeat()) return fail("stalled: server heartbeat");
+    if (!pump(s, c, [&] { return s.stats().heartbeats_received == hb_received + 1; }))
+        return fail("stalled: inbound during replay");
+    const uint64_t hb_sent = s.stats().heartbeats_sent;
+    if (s.poll(c, boe_mock::now_ns() + 2 * cfg.heartbeat_ns) != status::ok || s.stats().heartbeats_sent != hb_sent + 1)
+        return fail("stalled: heartbeat during replay");
+    if (!s.replaying()) return fail("stalled: replay finished without a reader");
+
+    // The peer reads again: every order arrives once, in order, in whole frames
+    if (!pump(s, c, [&] {
+            peer.drain();
+            return !s.replaying() && s.pending_bytes() == 0 && peer.orders.size() == kOrders;
+        }))
+        return fail("stalled: replay drained");
+    for (uint32_t i = 0; i < kOrders; ++i) {
+        if (peer.orders[i] != i + 1) return fail("stalled: replay order");
+    }
+    if (peer.errors != 0 || peer.heartbeats == 0 || s.stats().replayed != kOrders) return fail("stalled: replay frames");
+    if (s.queue(held) != status::ok || held.SequenceNumber != kOrders + 1) return fail("stalled: queue after replay");
+    ::close(fd);
+    ::close(peer.fd);
+
+    // A replay the connection cannot take disconnects the session
+    int sv[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) return fail("stalled: socketpair");
+    fd = sv[0];
+    peer.fd = sv[1];
+    peer.rx.reset();
+    if (s.attach(fd) != status::ok || s.login(make_login()) != status::ok) return fail("stalled: last login");
+    if (!peer.login_response(0) || ::shutdown(peer.fd, SHUT_RD) != 0) return fail("stalled: peer shutdown");
+    if (!pump(s, c, [&] { return s.state() != session_state::logging_in; })) return fail("stalled: last response");
+    if (s.state() != session_state::disconnected) return fail("stalled: failed replay");
+    ::close(fd);
+    ::close(peer.fd);
+    return 0;
+}
+
+}  // namespace
+
+int main() {
+    if (session_round_trips() != 0 || ring_wraparound() != 0 || replay_to_stalled_peer() != 0) return 1;
+    std::cout << "BOE session ok" << std::endl;
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cout << "BOE session: sockets or generated session traits unavailable, skipped" << std::endl;
+    return 0;
+}
+
+#endif
@@ -0,0 +1,243 @@
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "runtime/shm_ring.hpp"
+#include "runtime/status.hpp"
+
+using market::runtime::shm_read_status;
+using market::runtime::shm_ring_publisher;
+using market::runtime::shm_ring_subscriber;
+using market::runtime::status;
+namespace shm_detail = market::runtime::shm_detail;
+
+namespace {
+
+struct tick {
+    uint64_t seq;
+    uint64_t price;
+    uint64_t check;  // seq ^ price, detects torn copies
+    char symbol[8];
+};
+
+tick make_tick(uint64_t n) {
+    tick t{};
+    t.seq = n;
+    t.price = n * 7 + 100;
+    t.check = t.seq ^ t.price;
+    std::memcpy(t.symbol, "SYMBOL00", 8);
+    return t;
+}
+
+}
+
+int main() {
+    const std::string name = "/market_test_shm_" + std::to_string(::getpid());
+    shm_ring_publisher::unlink(name.c_str());
+
+    shm_ring_publisher pub;
+    if (pub.create(name.c_str(), sizeof(tick), 60) != status::ok || pub.capacity() != 64) {
+        std::cerr << "Failed to create shm ring" << std::endl;
+        return 1;
+    }
+
+    shm_ring_subscriber a;
+    shm_ring_subscriber b;
+    if (a.open(name.c_str()) != status::ok || b.open(name.c_str()) != status::ok) {
+        std::cerr << "Failed to attach to shm ring" << std::endl;
+        shm_ring_publisher::unlink(name.c_str());
+        return 1;
+    }
+
+    int rc = 0;
+    uint32_t type = 0;
+    tick t{};
+
+    // Independent cursors: both subscribers see every message in order
+    for (uint64_t n = 0; n < 40; ++n) pub.publish(make_tick(n), 7);
+    for (uint64_t n = 0; n < 40 && rc == 0; ++n) {
+        if (a.poll(t, type) != shm_read_status::ok || t.seq != n || type != 7) rc = 1;
+    }
+    if (rc == 0 && (a.poll(t, type) != shm_read_status::empty || a.lag() != 0 || b.lag() != 40)) rc = 1;
+    for (uint64_t n = 0; n < 40 && rc == 0; ++n) {
+        if (b.poll(t, type) != shm_read_status::ok || t.seq != n) rc = 1;
+    }
+    if (rc) std::cerr << "Subscribers did not read independently" << std::endl;
+
+    // Lapped subscriber reports overrun, skips ahead, and keeps reading
+    if (rc == 0) {
+        for (uint64_t n = 40; n < 240; ++n) pub.publish(make_tick(n), 7);
+        if (a.poll(t, type) != shm_read_status::overrun || a.lost() == 0) {
+            std::cerr << "Overrun not detected" << std::endl;
+            rc = 1;
+        } else {
+            uint64_t expect = a.position();
+            uint64_t read = 0;
+            shm_read_status st;
+            while ((st = a.poll(t, type)) == shm_read_status::ok) {
+                if (t.seq != expect++) break;
+                ++read;
+            }
+            if (st != shm_read_status::empty || a.lost() + read != 200) {
+                std::cerr << "Resync after overrun lost track of sequence" << std::endl;
+                rc = 1;
+            }
+        }
+    }
+
+    // Oversized publish and too-small output buffer are rejected
+    if (rc == 0) {
+        uint8_t big[256] = {};
+        if (pub.publish(big, sizeof(big))) {
+            std::cerr << "Oversized publish accepted" << std::endl;
+            rc = 1;
+        }
+        uint32_t size = 0;
+        pub.publish(make_tick(240), 7);
+        if (rc == 0 && (a.poll(big, 4, size, type) != shm_read_status::too_small || size != sizeof(tick))) {
+            std::cerr << "Too-small output buffer not reported" << std::endl;
+            rc = 1;
+        }
+        a.poll(t, type);
+    }
+
+    // Concurrent publisher: readers never observe a torn or out-of-order message
+    if (rc == 0) {
+        constexpr uint64_t kCount = 200'000;
+        while (b.poll(t, type) != shm_read_status::empty) {
+        }
+        const uint64_t start = pub.sequence();
+        std::atomic<bool> done{false};
+        std::atomic<int> errors{0};
+        auto reader = [&](shm_ring_subscriber& sub) {
+            tick r{};
+            uint32_t ty = 0;
+            uint64_t last = start - 1;
+            while (true) {
+                const bool finished = done.load(std::memory_order_acquire);
+                const auto st = sub.poll(r, ty);
+                if (st == shm_read_status::ok) {
+                    if (r.check != (r.seq ^ r.price) || r.seq <= last) errors.fetch_add(1);
+                    last = r.seq;
+                } else if (st == shm_read_status::empty && finished) {
+                    break;
+                }
+            }
+            if (last != start + kCount - 1) errors.fetch_add(1);
+        };
+        std::thread ra(reader, std::ref(a));
+        std::thread rb(reader, std::ref(b));
+        for (uint64_t n = start; n < start + kCount; ++n) pub.publish(make_tick(n), 7);
+        done.store(true, std::memory_order_release);
+        ra.join();
+        rb.join();
+        if (errors.load() != 0) {
+            std::cerr << "Concurrent readers saw torn or out-of-order messages" << std::endl;
+            rc = 1;
+        }
+    }
+
+    // Attaching to a missing segment fails cleanly
+    if (rc == 0) {
+        shm_ring_subscriber c;
+        if (c.open("/market_test_shm_missing_segment") == status::ok) {
+            std::cerr << "Opened a missing segment" << std::endl;
+            rc = 1;
+        }
+    }
+
+    // Forged geometry in an otherwise valid header is rejected before any slot
+    // is addressed: zero or non-power-of-two capacity, zero or undersized
+    // stride, capacity * stride overflowing, and a payload wider than the slot.
+    // A slot whose size exceeds the payload is skipped, not copied
+    if (rc == 0) {
+        const std::string forged = name + "_forged";
+        shm_ring_publisher fp;
+        int fd = -1;
+        void* p = MAP_FAILED;
+        size_t bytes = 0;
+        if (fp.create(forged.c_str(), sizeof(tick), 64) == status::ok)
+            fd = ::shm_open(forged.c_str(), O_RDWR, 0);
+        struct stat st {};
+        if (fd >= 0 && ::fstat(fd, &st) == 0) bytes = static_cast<size_t>(st.st_size);
+        if (bytes != 0) p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (fd >= 0) ::close(fd);
+        if (p == MAP_FAILED) {
+            std::cerr << "Failed to map forged segment" << std::endl;
+            rc = 1;
+        } else {
+            auto* h = static_cast<shm_detail::header*>(p);
+            const uint64_t capacity = h->capacity;
+            const uint64_t stride = h->slot_stride;
+            const uint64_t geometry[][2] = {
+                {0, stride}, {48, stride}, {capacity, 0}, {capacity, 8}, {1ULL << 62, 64}, {capacity, 1ULL << 60},
+            };
+            for (const auto& g : geometry) {
+                h->capacity = g[0];
+                h->slot_stride = g[1];
+                shm_ring_subscriber c;
+                if (c.open(forged.c_str()) != status::bad_value) {
+                    std::cerr << "Accepted forged geometry capacity=" << g[0] << " stride=" << g[1] << std::endl;
+                    rc = 1;
+                }
+            }
+            h->capacity = capacity;
+            h->slot_stride = stride;
+            const uint32_t payload = h->slot_payload;
+            h->slot_payload = static_cast<uint32_t>(stride - 15);
+            shm_ring_subscriber c;
+            if (c.open(forged.c_str()) != status::bad_value) {
+                std::cerr << "Accepted a slot payload wider than the stride" << std::endl;
+                rc = 1;
+            }
+            h->slot_payload = payload;
+            if (c.open(forged.c_str(), true) != status::ok) {
+                std::cerr << "Rejected restored geometry" << std::endl;
+                rc = 1;
+            }
+
+            fp.publish(make_tick(0), 7);
+            fp.publish(make_tick(1), 7);
+            auto* slot0 = reinterpret_cast<uint8_t*>(p) + sizeof(shm_detail::header);
+            const uint64_t meta = (uint64_t{7} << 32) | (1u << 20);
+            std::memcpy(slot0 + 8, &meta, sizeof(meta));
+            std::vector<uint8_t> out(1 << 21);
+            uint32_t size = 0;
+            if (rc == 0 && (c.poll(out.data(), static_cast<uint32_t>(out.size()), size, type) != shm_read_status::overrun ||
+                            c.lost() != 1 || c.poll(t, type) != shm_read_status::ok || t.seq != 1)) {
+                std::cerr << "Oversized slot not skipped" << std::endl;
+                rc = 1;
+            }
+            ::munmap(p, bytes);
+        }
+
+        // A restarted publisher replaces the segment instead of shrinking it
+        // under a subscriber that is still mapped
+        shm_ring_subscriber d;
+        for (uint64_t n = 2; n < 63; ++n) fp.publish(make_tick(n), 7);
+        if (rc == 0 && (d.open(forged.c_str()) != status::ok || fp.create(forged.c_str(), sizeof(tick), 4) != status::ok ||
+                        d.poll(t, type) != shm_read_status::empty)) {
+            std::cerr << "Publisher restart disturbed a mapped subscriber" << std::endl;
+            rc = 1;
+        }
+        shm_ring_subscriber e;
+        if (rc == 0 && (e.open(forged.c_str()) != status::ok || !fp.publish(make_tick(0), 7) ||
+                        e.poll(t, type) != shm_read_status::ok || t.seq != 0)) {
+            std::cerr << "Reopen after publisher restart" << std::endl;
+            rc = 1;
+        }
+        shm_ring_publisher::unlink(forged.c_str());
+    }
+
+    shm_ring_publisher::unlink(name.c_str());
+    return rc;
+}
@@ -0,0 +1,160 @@
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "runtime/histogram.hpp"
+#include "runtime/stats_registry.hpp"
+#include "runtime/status.hpp"
+
+using market::runtime::stats_entry;
+using market::runtime::stats_histogram_snapshot;
+using market::runtime::stats_kind;
+using market::runtime::stats_log_histogram;
+using market::runtime::stats_reader;
+using market::runtime::stats_registry;
+using market::runtime::status;
+namespace stats_detail = market::runtime::stats_detail;
+
+namespace {
+
+int fail(const char* what) {
+    std::cerr << "test_stats: " << what << std::endl;
+    return 1;
+}
+
+bool find(const stats_reader& r, std::string_view name, stats_entry& out) {
+    for (uint32_t i = 0; i < r.size(); ++i) {
+        out = r.entry(i);
+        if (out.name == name) return true;
+    }
+    return false;
+}
+
+}
+
+int main() {
+    const std::string name = "/market_test_stats_" + std::to_string(::getpid());
+    stats_registry::unlink(name.c_str());
+
+    stats_reader missing;
+    if (missing.open(name.c_str()) == status::ok) return fail("opened a missing segment");
+
+    stats_registry reg;
+    if (reg.create(name.c_str(), 8, 64 * 1024) != status::ok) return fail("create");
+
+    // A reader may attach before anything is registered
+    stats_reader r;
+    if (r.open(name.c_str()) != status::ok || r.size() != 0 || r.pid() != ::getpid()) return fail("open");
+
+    auto messages = reg.counter("itch.messages");
+    auto depth = reg.gauge("ring.depth");
+    auto results = reg.status_counts("itch.decode");
+    auto latency = reg.histogram("wire_to_book_ns");
+    if (!messages.bound() || !depth.bound() || !results.bound() || !latency.bound()) return fail("register");
+
+    stats_log_histogram reference;
+    for (uint64_t i = 1; i <= 10000; ++i) {
+        messages.add();
+        results.record(i % 100 == 0 ? status::bad_value : status::ok);
+        latency.record(i * 37 % 5000 + 200);
+        reference.record(i * 37 % 5000 + 200);
+    }
+    depth.set(-3);
+    depth.set(42);
+    results.record(status::unknown_type, 5);
+    reg.touch(123456789);
+
+    stats_entry e;
+    if (r.size() != 4) return fail("entry count");
+    if (!find(r, "itch.messages", e) || e.kind != stats_kind::counter || stats_reader::value(e) != 10000)
+        return fail("counter");
+    if (!find(r, "ring.depth", e) || e.kind != stats_kind::gauge || stats_reader::gauge(e) != 42) return fail("gauge");
+    if (!find(r, "itch.decode", e) || stats_reader::status_count(e, status::ok) != 9900 ||
+        stats_reader::status_count(e, status::bad_value) != 100 ||
+        stats_reader::status_count(e, status::unknown_type) != 5 ||
+        stats_reader::status_count(e, status::short_buffer) != 0)
+        return fail("status counts");
+
+    stats_histogram_snapshot h;
+    if (!find(r, "wire_to_book_ns", e) || !stats_reader::histogram(e, h)) return fail("histogram entry");
+    if (h.count != reference.count() || h.min != reference.min() || h.max != reference.max() ||
+        h.mean() != reference.mean())
+        return fail("histogram summary");
+    for (double q : {0.0, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+        if (h.quantile(q) != reference.quantile(q)) return fail("histogram quantile");
+    }
+    if (r.heartbeat_ns() != 123456789) return fail("heartbeat");
+
+    // Full registry: handles still work but write to the local sink
+    for (int i = 0; i < 4; ++i) (void)reg.counter("extra." + std::to_string(i));
+    auto overflow = reg.counter("overflow");
+    overflow.add(7);
+    if (overflow.bound() || r.size() != 8 || find(r, "overflow", e)) return fail("full registry");
+
+    // Entries registered after the reader attached are visible to it
+    if (!find(r, "extra.3", e)) return fail("late entry");
+
+    // Another process updates the same entries through its own mapping
+    const pid_t child = ::fork();
+    if (child == 0) {
+        for (int i = 0; i < 500; ++i) messages.add(2);
+        depth.set(7);
+        _exit(0);
+    }
+    int wstatus = 0;
+    if (child < 0 || ::waitpid(child, &wstatus, 0) != child || !WIFEXITED(wstatus)) return fail("fork");
+    if (!find(r, "itch.messages", e) || stats_reader::value(e) != 11000) return fail("child counter");
+    if (!find(r, "ring.depth", e) || stats_reader::gauge(e) != 7) return fail("child gauge");
+
+    // Without a segment every handle is unbound and harmless
+    stats_registry none;
+    auto unbound = none.histogram("x");
+    unbound.record(5);
+    if (unbound.bound()) return fail("unbound handle");
+
+    reg.close();
+    // Values stay readable after the writer unmaps until the name is unlinked
+    if (!find(r, "itch.messages", e) || stats_reader::value(e) != 11000) return fail("after close");
+
+    // A restarted writer replaces the segment instead of truncating it under
+    // the attached reader, which reopens to follow the new one
+    stats_registry again;
+    if (again.create(name.c_str(), 4, 4096) != status::ok) return fail("recreate");
+    if (!find(r, "itch.messages", e) || stats_reader::value(e) != 11000) return fail("reader after restart");
+    if (r.open(name.c_str()) != status::ok || r.size() != 0) return fail("reopen after restart");
+    again.close();
+    r.close();
+
+    // A header whose entry table runs past the segment is rejected
+    {
+        const std::string forged = name + "_forged";
+        stats_registry fr;
+        if (fr.create(forged.c_str(), 4, 4096) != status::ok) return fail("forged create");
+        const int fd = ::shm_open(forged.c_str(), O_RDWR, 0);
+        void* p = fd >= 0 ? ::mmap(nullptr, sizeof(stats_detail::header), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                          : MAP_FAILED;
+        if (fd >= 0) ::close(fd);
+        if (p == MAP_FAILED) return fail("forged map");
+        auto* h = static_cast<stats_detail::header*>(p);
+        const uint32_t max_entries = h->max_entries;
+        const uint64_t data_offset = h->data_offset;
+        h->max_entries = 1u << 20;
+        h->data_offset = sizeof(stats_detail::header) + size_t{h->max_entries} * sizeof(stats_detail::descriptor);
+        stats_reader fr_reader;
+        if (fr_reader.open(forged.c_str()) != status::bad_value) return fail("forged entry table");
+        h->max_entries = max_entries;
+        h->data_offset = data_offset;
+        if (fr_reader.open(forged.c_str()) != status::ok) return fail("restored entry table");
+        ::munmap(p, sizeof(stats_detail::header));
+        stats_registry::unlink(forged.c_str());
+    }
+    stats_registry::unlink(name.c_str());
+
+    std::cout << "stats registry ok" << std::endl;
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "runtime/symbol_batch.hpp"
+#include "runtime/wire_types.hpp"
+
+#include "../generated/nasdaq_itch_5/encoder.hpp"
+#include "../generated/nasdaq_itch_5/wire.hpp"
+
+// Symbol normalisation: symbol_key / symbol_keys against a byte-at-a-time
+// reference, over the SIMD body, the tail and strided record layouts.
+namespace itch = nasdaq::itch::v5;
+namespace rt = market::runtime;
+using sym8 = std::array<char, 8>;
+
+namespace {
+
+int fail(const char* what) {
+    std::cerr << "test_symbol: " << what << std::endl;
+    return 1;
+}
+
+sym8 sym(const char* s) {
+    sym8 out;
+    std::memcpy(out.data(), s, 8);
+    return out;
+}
+
+// Reference: trim trailing spaces/NULs, require printable ASCII, upper-case,
+// big-endian key.
+uint64_t reference_key(const char* p, size_t& len) {
+    len = 8;
+    while (len > 0 && (p[len - 1] == ' ' || p[len - 1] == '\0')) --len;
+    uint64_t key = 0;
+    bool ok = len > 0;
+    for (size_t i = 0; i < 8; ++i) {
+        auto c = static_cast<unsigned char>(i < len ? p[i] : 0);
+        if (i < len && (c < 0x20 || c > 0x7E)) ok = false;
+        if (c >= 'a' && c <= 'z') c = static_cast<unsigned char>(c - 32);
+        key = (key << 8) | c;
+    }
+    return ok ? key : 0;
+}
+
+}  // namespace
+
+int main() {
+    // Padding, case and validity
+    const uint64_t aapl = rt::symbol_key(sym("AAPL    "));
+    if (aapl != 0x4141504C00000000ull || rt::symbol_key(sym("aapl\0\0\0\0")) != aapl ||
+        rt::symbol_key(sym("AaPl \0 \0")) != aapl)
+        return fail("padding and case");
+    if (rt::symbol_length(sym("BRK A   ").data()) != 5 || rt::symbol_key(sym("BRK A   ")) == 0 ||
+        rt::symbol_length(sym("ABCDEFGH").data()) != 8 || rt::symbol_length(sym("        ").data()) != 0)
+        return fail("lengths");
+    for (const char* bad : {"        ", "\0\0\0\0\0\0\0\0", "AB\x01" "C    ", "A\0B     ", "\x7F       ",
+                            "\xC3\xA9       ", "ABCDEFG\x80"}) {
+        if (rt::symbol_valid(sym(bad).data())) return fail("invalid symbol accepted");
+    }
+    if (!(rt::symbol_key(sym("AAPL    ")) < rt::symbol_key(sym("AAPLX   ")) &&
+          rt::symbol_key(sym("AAPLX   ")) < rt::symbol_key(sym("AB      ")) &&
+          rt::symbol_key(sym("~       ")) > rt::symbol_key(sym("ZZZZZZZZ"))))
+        return fail("key order");
+    if (rt::symbol_from_key(aapl) != sym("AAPL    ") || rt::symbol_from_key(0) != sym("        "))
+        return fail("symbol_from_key");
+
+    // Random symbols: mostly plausible, with lower case, padding mixes and bad bytes
+    std::mt19937 rng(7);
+    const char alphabet[] = "ABCXYZabcxyz019.-/ \0\x7F\x80\x1F~";
+    std::vector<sym8> syms(1000);
+    for (auto& s : syms) {
+        const size_t len = rng() % 9;
+        for (size_t i = 0; i < 8; ++i) {
+            if (i < len) {
+                s[i] = (rng() % 8 == 0) ? alphabet[rng() % (sizeof(alphabet) - 1)] : static_cast<char>('A' + rng() % 26);
+            } else {
+                s[i] = (rng() & 1) ? ' ' : '\0';
+            }
+        }
+    }
+    for (const auto& s : syms) {
+        size_t len = 0;
+        const uint64_t expect = reference_key(s.data(), len);
+        if (rt::symbol_key(s) != expect) return fail("symbol_key vs reference");
+        if (expect != 0 && rt::symbol_length(s.data()) != len) return fail("symbol_length vs reference");
+    }
+
+    // Batch, contiguous and strided, at sizes around the vector widths
+    for (size_t n : {size_t{0}, size_t{1}, size_t{2}, size_t{3}, size_t{5}, size_t{8}, size_t{999}, size_t{1000}}) {
+        std::vector<uint64_t> keys(n + 1, 0xABABABABABABABABull);
+        std::vector<uint8_t> lengths(n + 1, 0xEE);
+        const size_t invalid = rt::symbol_keys(syms.data(), n, keys.data(), lengths.data());
+        size_t expect_invalid = 0;
+        for (size_t i = 0; i < n; ++i) {
+            size_t len = 0;
+            const uint64_t expect = reference_key(syms[i].data(), len);
+            expect_invalid += expect == 0;
+            if (keys[i] != expect || (expect != 0 && lengths[i] != len)) return fail("symbol_keys vs reference");
+        }
+        if (invalid != expect_invalid) return fail("symbol_keys invalid count");
+        if (keys[n] != 0xABABABABABABABABull || lengths[n] != 0xEE) return fail("symbol_keys wrote past n");
+
+        std::vector<char> records(n * 30 + 8);
+        for (size_t i = 0; i < n; ++i) std::memcpy(records.data() + i * 30 + 18, syms[i].data(), 8);
+        std::vector<uint64_t> strided(n + 1);
+        if (rt::symbol_keys(records.data() + 18, 30, n, strided.data()) != invalid ||
+            !std::equal(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(n), strided.begin()))
+            return fail("strided symbol_keys");
+    }
+
+    // Generated helpers on messages and wire overlays
+    std::vector<uint8_t> capture(4 * sizeof(itch::AddOrderWire));
+    const std::array<sym8, 4> names{sym("msft    "), sym("AAPL    "), sym("BRK B\0\0\0"), sym("\x01XYZ    ")};
+    for (size_t i = 0; i < names.size(); ++i) {
+        itch::AddOrder m;
+        m.Type = 'A';
+        m.Symbol = names[i];
+        if (i == 0 && m.Symbol_key() != rt::symbol_key(sym("MSFT    "))) return fail("AddOrder::Symbol_key");
+        size_t written = 0;
+        (void)itch::Encoder::encode(m, capture.data() + i * 30, 30, written);
+    }
+    const auto adds = rt::overlay_array<itch::AddOrderWire>(rt::Bytes{capture.data(), capture.size()});
+    std::array<uint64_t, 4> keys{};
+    std::array<uint8_t, 4> lengths{};
+    if (itch::Symbol_keys(adds, keys.data(), lengths.data()) != 1 || keys[1] != aapl || keys[3] != 0 ||
+        lengths[2] != 5 || adds[2].Symbol_key() != keys[2] || rt::symbol_from_key(keys[0]) != sym("MSFT    "))
+        return fail("AddOrderWire Symbol_keys");
+
+#if MARKET_SYMBOL_AVX2
+    std::cout << "Symbol normalisation ok (AVX2)" << std::endl;
+#else
+    std::cout << "Symbol normalisation ok" << std::endl;
+#endif
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include "runtime/status.hpp"
+#include "runtime/wire_types.hpp"
+
+#include "../generated/cboe_boe_v3/encoder.hpp"
+#include "../generated/cboe_boe_v3/wire.hpp"
+#include "../generated/cme_mdp3_v9/encoder.hpp"
+#include "../generated/cme_mdp3_v9/wire.hpp"
+#include "../generated/nasdaq_itch_5/encoder.hpp"
+#include "../generated/nasdaq_itch_5/decoder.hpp"
+#include "../generated/nasdaq_itch_5/wire.hpp"
+
+// Endian wrapper types and the generated wire overlays (wire.hpp): overlay
+// reads and writes must agree with the Encoder/Decoder byte for byte.
+namespace itch = nasdaq::itch::v5;
+namespace boe = cboe::boe::v3;
+namespace mdp = mktdata::v9;
+namespace rt = market::runtime;
+using market::runtime::status;
+
+static_assert(sizeof(rt::be_u16) == 2 && sizeof(rt::be_u32) == 4 && sizeof(rt::be_u48) == 6 && sizeof(rt::be_u64) == 8);
+static_assert(alignof(rt::be_u64) == 1 && alignof(rt::le_u48) == 1);
+static_assert(std::is_trivially_copyable_v<rt::be_u32> && std::is_trivially_copyable_v<rt::le_i64>);
+static_assert(std::is_trivially_default_constructible_v<rt::le_u16>);
+
+namespace {
+
+int fail(const char* what) {
+    std::cerr << "test_wire: " << what << std::endl;
+    return 1;
+}
+
+template<class W>
+bool bytes_are(const W& w, std::initializer_list<uint8_t> expect) {
+    return sizeof(W) == expect.size() && std::memcmp(&w, expect.begin(), sizeof(W)) == 0;
+}
+
+}  // namespace
+
+int main() {
+    // Wrapper types: wire byte order in memory, native values in and out
+    rt::be_u32 b32 = 0x01020304u;
+    rt::le_u32 l32 = 0x01020304u;
+    rt::be_u48 b48 = 0x0000A1A2A3A4A5A6ull;
+    rt::le_u48 l48 = 0x0000A1A2A3A4A5A6ull;
+    rt::le_i32 neg = -7;
+    rt::be_u16 b16 = 0xBEEF;
+    if (!bytes_are(b32, {1, 2, 3, 4}) || !bytes_are(l32, {4, 3, 2, 1}) ||
+        !bytes_are(b48, {0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6}) || !bytes_are(l48, {0xA6, 0xA5, 0xA4, 0xA3, 0xA2, 0xA1}) ||
+        !bytes_are(b16, {0xBE, 0xEF}))
+        return fail("wrapper byte order");
+    if (b32 != 0x01020304u || l32 != 0x01020304u || b48 != 0xA1A2A3A4A5A6ull || l48 != 0xA1A2A3A4A5A6ull ||
+        neg != -7 || b16 != 0xBEEF)
+        return fail("wrapper values");
+    const uint64_t sum = b32 + uint64_t{b48};
+    if (sum != 0x01020304u + 0xA1A2A3A4A5A6ull) return fail("wrapper arithmetic");
+    rt::wire_int<std::endian::big, 6, int64_t> i48 = -2;
+    if (i48 != -2 || !bytes_are(i48, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE})) return fail("signed 48-bit");
+    rt::wire_int<std::endian::little, 2, boe::MessageType> et = boe::MessageType::LoginRequest;
+    if (et != boe::MessageType::LoginRequest) return fail("enum wrapper");
+
+    // ITCH: a run of encoded AddOrders viewed as an array of overlays
+    std::vector<uint8_t> capture(5 * sizeof(itch::AddOrderWire) + 3);
+    for (size_t i = 0; i < 5; ++i) {
+        itch::AddOrder m;
+        m.Type = 'A';
+        m.Timestamp = static_cast<uint32_t>(1000 + i);
+        m.OrderId = 0x0102030405060708ull + i;
+        m.Side = (i & 1) ? 'S' : 'B';
+        m.Shares = static_cast<uint32_t>(100 * (i + 1));
+        std::memcpy(m.Symbol.data(), "AAPL    ", 8);
+        m.Price = static_cast<uint32_t>(1'500'000 + i);
+        size_t written = 0;
+        if (itch::Encoder::encode(m, capture.data() + i * 30, 30, written) != status::ok || written != 30)
+            return fail("AddOrder encode");
+    }
+    const auto adds = rt::overlay_array<itch::AddOrderWire>(rt::Bytes{capture.data(), capture.size()});
+    if (adds.size() != 5) return fail("overlay_array size");
+    uint64_t notional = 0;
+    for (size_t i = 0; i < adds.size(); ++i) {
+        const itch::AddOrderWire& w = adds[i];
+        if (w.Type != 'A' || w.Timestamp != 1000 + i || w.OrderId != 0x0102030405060708ull + i ||
+            w.Side != ((i & 1) ? 'S' : 'B') || std::memcmp(w.Symbol.data(), "AAPL    ", 8) != 0)
+            return fail("AddOrder overlay fields");
+        notional += uint64_t{w.Shares} * w.Price;
+    }
+    if (notional != 100 * 1'500'000ull + 200 * 1'500'001ull + 300 * 1'500'002ull + 400 * 1'500'003ull +
+                        500 * 1'500'004ull)
+        return fail("AddOrder overlay arithmetic");
+
+    // Writes through an overlay are what the decoder reads
+    itch::AddOrderWire* w2 = rt::overlay<itch::AddOrderWire>(capture.data() + 2 * 30);
+    w2->Price = 42;
+    w2->OrderId = w2->OrderId + 1;
+    itch::AddOrder back;
+    size_t consumed = 0;
+    if (itch::Decoder::decode(capture.data() + 2 * 30, 30, back, consumed) != status::ok || back.Price != 42 ||
+        back.OrderId != 0x0102030405060708ull + 3)
+        return fail("AddOrder overlay write");
+
+    // An overlay filled field by field encodes like Encoder::encode
+    itch::DeleteOrderWire d{};
+    d.Type = 'D';
+    d.Timestamp = 77u;
+    d.OrderId = 0xDEADBEEFull;
+    itch::DeleteOrder dm;
+    dm.Type = 'D';
+    dm.Timestamp = 77;
+    dm.OrderId = 0xDEADBEEF;
+    std::array<uint8_t, 13> enc{};
+    size_t written = 0;
+    if (itch::Encoder::encode(dm, enc.data(), enc.size(), written) != status::ok ||
+        std::memcmp(&d, enc.data(), sizeof(d)) != 0)
+        return fail("DeleteOrder overlay bytes");
+
+    // BOE: little-endian fields and the enum discriminator
+    boe::LoginRequest login;
+    login.StartOfMessage = 0xBABA;
+    login.MessageType = boe::MessageType::LoginRequest;
+    std::memcpy(login.Username.data(), "USR1", 4);
+    std::array<uint8_t, 64> buf{};
+    if (boe::Encoder::encode(login, buf.data(), buf.size(), written) != status::ok ||
+        written != sizeof(boe::LoginRequestWire))
+        return fail("LoginRequest encode");
+    const auto* lw = rt::overlay<boe::LoginRequestWire>(buf.data());
+    if (lw->StartOfMessage != 0xBABA || lw->MessageLength != written ||
+        lw->MessageType != boe::MessageType::LoginRequest || lw->Username != login.Username)
+        return fail("LoginRequest overlay");
+
+    // SBE: message header, signed fields and null values in place
+    mdp::SecurityStatus30 ss;
+    ss.TransactTime = 1700000000123456789ull;
+    ss.SecurityTradingStatus = mdp::SecurityTradingStatus::ReadyToTrade;
+    if (mdp::Encoder::encode(ss, buf.data(), buf.size(), written) != status::ok ||
+        written != sizeof(mdp::SecurityStatus30Wire))
+        return fail("SecurityStatus30 encode");
+    const auto* sw = rt::overlay<mdp::SecurityStatus30Wire>(buf.data());
+    if (sw->TemplateId != 30 || sw->BlockLength != 30 || sw->TransactTime != 1700000000123456789ull ||
+        sw->SecurityID != mdp::SecurityStatus30::SecurityID_null ||
+        sw->SecurityTradingStatus != mdp::SecurityTradingStatus::ReadyToTrade)
+        return fail("SecurityStatus30 overlay");
+
+    std::cout << "Wire overlays ok" << std::endl;
+    return 0;
+}
@@ -0,0 +1,374 @@
+// Split ITCH captures into one pcap per symbol, or per symbol hash bucket, so a
+// per-symbol backtest reads only its own messages instead of filtering the day.
+//
+//   mdp_split out/ itch_a.pcap itch_b.pcap            out/AAPL.pcap, out/MSFT.pcap, ...
+//   mdp_split --buckets 64 out/ itch.pcap             out/bucket_0000.pcap .. out/bucket_0063.pcap
+//   PAYLOAD_OFFSET=42 mdp_split --workers 4 out/ raw.pcap
+//
+// Options: --buckets N (hash symbols into N files instead of one per symbol),
+// --workers N (writer threads, default 2), --buffer-kb N (per-output buffer,
+// default 1024), --max-open N (descriptors held across all workers, default 256).
+//
+// Inputs are merged in timestamp order (runtime/capture_merge.hpp) and every
+// message becomes one record stamped with its packet's capture time; the split
+// files read back with pcap_decode or capture_merge at payload offset 0.
+// AddOrder carries the symbol; DeleteOrder is routed through an OrderId ->
+// symbol map built from the adds. Messages that cannot be attributed (orders
+// added before the capture started, unknown types and anything after them in
+// the packet) go to _unrouted.pcap.
+//
+// Routing needs the adds in order, so it runs on the reading thread; it hands
+// batches of (output, timestamp, message view) to writer threads that each own
+// a disjoint set of outputs (output % workers) and a split_writer for them.
+// The views point into the mapped captures, so no message is copied before it
+// lands in its output's buffer.
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "runtime/bytes.hpp"
+#include "runtime/capture_merge.hpp"
+#include "runtime/capture_split.hpp"
+#include "runtime/context.hpp"
+#include "runtime/flat_map.hpp"
+#include "runtime/status.hpp"
+#include "runtime/symbol.hpp"
+
+#if __has_include("../generated/nasdaq_itch_5/handler.hpp")
+#include "../generated/nasdaq_itch_5/handler.hpp"
+#define MDP_SPLIT_ITCH 1
+#else
+#define MDP_SPLIT_ITCH 0
+#endif
+
+using market::runtime::Bytes;
+using market::runtime::capture_merge;
+using market::runtime::flat_u64_map;
+using market::runtime::msg_context;
+using market::runtime::split_config;
+using market::runtime::split_stats;
+using market::runtime::split_writer;
+using market::runtime::status;
+
+namespace {
+
+constexpr const char* kUsage =
+    "Usage: mdp_split [--buckets N] [--workers N] [--buffer-kb N] [--max-open N] <out_dir> <pcap_file> "
+    "[pcap_file...]\n"
+    "  PAYLOAD_OFFSET env: bytes to strip per packet (e.g. 42 for Eth/IPv4/UDP)\n";
+
+struct Route {
+    uint32_t output;
+    uint64_t ts_ns;
+    Bytes msg;
+};
+
+// One hand-off to a writer thread. Outputs first seen in this batch are
+// registered before its routes are written.
+struct Batch {
+    std::vector<std::pair<uint32_t, std::string>> added;
+    std::vector<Route> routes;
+};
+
+class Worker {
+public:
+    Worker(split_config cfg, size_t workers) : writer_(cfg), workers_(workers) {
+        thread_ = std::thread([this] { run(); });
+    }
+
+    // Blocks while `kDepth` batches are already waiting.
+    void push(Batch&& b) {
+        std::unique_lock<std::mutex> lk(mu_);
+        space_.wait(lk, [this] { return queue_.size() < kDepth; });
+        queue_.push_back(std::move(b));
+        ready_.notify_one();
+    }
+
+    status finish() {
+        {
+            std::lock_guard<std::mutex> lk(mu_);
+            done_ = true;
+        }
+        ready_.notify_one();
+        thread_.join();
+        const status st = writer_.close();
+        return st != status::ok ? st : result_;
+    }
+
+    const split_writer& writer() const noexcept { return writer_; }
+
+private:
+    static constexpr size_t kDepth = 8;
+
+    void run() {
+        Batch b;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(mu_);
+                ready_.wait(lk, [this] { return !queue_.empty() || done_; });
+                if (queue_.empty()) return;
+                b = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            space_.notify_one();
+            for (auto& [output, path] : b.added) {
+                // Outputs are numbered globally and dealt round-robin, so this
+                // worker's local indices follow in the same order
+                if (writer_.add(std::move(path)) != output / workers_) result_ = status::bad_value;
+            }
+            for (const Route& r : b.routes) {
+                const status st = writer_.write(r.output / static_cast<uint32_t>(workers_), r.ts_ns, r.msg);
+                if (st != status::ok && result_ == status::ok) result_ = st;
+            }
+        }
+    }
+
+    split_writer writer_;
+    size_t workers_;
+    status result_ = status::ok;
+    std::mutex mu_;
+    std::condition_variable ready_;
+    std::condition_variable space_;
+    std::deque<Batch> queue_;
+    bool done_ = false;
+    std::thread thread_;
+};
+
+// Symbol -> file name: the trimmed symbol, with anything outside [A-Za-z0-9._-]
+// percent-escaped so "BRK A" and "BRK/A" get distinct, valid names.
+std::string file_stem(uint64_t key) {
+    static constexpr char kHex[] = "0123456789ABCDEF";
+    const auto sym = market::runtime::symbol_from_key(key);
+    const size_t n = market::runtime::symbol_length(sym.data());
+    std::string out;
+    for (size_t i = 0; i < n; ++i) {
+        const auto c = static_cast<unsigned char>(sym[i]);
+        const bool plain = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '.' ||
+                           c == '_' || c == '-';
+        if (plain) {
+            out += static_cast<char>(c);
+        } else {
+            out += '%';
+            out += kHex[c >> 4];
+            out += kHex[c & 15];
+        }
+    }
+    return out;
+}
+
+class Router {
+public:
+    Router(std::string dir, std::vector<Worker*> workers, size_t buckets)
+        : dir_(std::move(dir)), workers_(std::move(workers)), buckets_(buckets), pending_(workers_.size()) {
+        orders_.reserve(1 << 20);
+        add_output("_unrouted");  // output 0
+    }
+
+#if MDP_SPLIT_ITCH
+    // Each on() leaves the message's symbol key in key_, 0 if it cannot be attributed.
+    void on(const nasdaq::itch::v5::AddOrder& m) {
+        key_ = m.Symbol_key();
+        if (key_ != 0) orders_.insert(m.OrderId, key_);
+    }
+    void on(const nasdaq::itch::v5::DeleteOrder& m) {
+        const uint64_t* k = orders_.find(m.OrderId);
+        key_ = k ? *k : 0;
+        if (k) orders_.erase(m.OrderId);
+    }
+#endif
+
+    void packet(Bytes pkt, const msg_context& ctx) {
+        ++packets_;
+        size_t off = 0;
+        while (off < pkt.size()) {
+            size_t consumed = 0;
+            key_ = 0;
+#if MDP_SPLIT_ITCH
+            const status st = nasdaq::itch::v5::dispatch_itch(pkt.subspan(off), *this, consumed);
+#else
+            const status st = status::unknown_type;
+#endif
+            if (st != status::ok || consumed == 0) {
+                route(0, ctx.capture_ns, pkt.subspan(off));
+                ++unparsed_;
+                return;
+            }
+            ++messages_;
+            route(output_for(key_), ctx.capture_ns, pkt.subspan(off, consumed));
+            off += consumed;
+        }
+    }
+
+    void finish() {
+        for (size_t w = 0; w < workers_.size(); ++w) hand_off(w);
+    }
+
+    uint64_t packets() const noexcept { return packets_; }
+    uint64_t messages() const noexcept { return messages_; }
+    uint64_t unrouted() const noexcept { return unrouted_; }
+    uint64_t unparsed() const noexcept { return unparsed_; }
+    size_t outputs() const noexcept { return next_output_; }
+    size_t open_orders() const noexcept { return orders_.size(); }
+
+private:
+    static constexpr size_t kBatch = 4096;
+
+    uint32_t output_for(uint64_t key) {
+        if (key == 0) return 0;
+        if (buckets_) {
+            // Fibonacci hash: symbol keys share their low (padding) bytes
+            const uint64_t b = ((key * 0x9E3779B97F4A7C15ull) >> 32) % buckets_;
+            if (uint32_t* id = symbols_.find(b)) return *id;
+            char name[32];
+            std::snprintf(name, sizeof(name), "bucket_%04llu", static_cast<unsigned long long>(b));
+            return *symbols_.insert(b, add_output(name));
+        }
+        if (uint32_t* id = symbols_.find(key)) return *id;
+        return *symbols_.insert(key, add_output(file_stem(key)));
+    }
+
+    uint32_t add_output(const std::string& stem) {
+        const uint32_t id = next_output_++;
+        pending_[id % workers_.size()].added.emplace_back(id, dir_ + "/" + stem + ".pcap");
+        return id;
+    }
+
+    void route(uint32_t output, uint64_t ts_ns, Bytes msg) {
+        if (output == 0) ++unrouted_;
+        const size_t w = output % workers_.size();
+        pending_[w].routes.push_back(Route{output, ts_ns, msg});
+        if (pending_[w].routes.size() == kBatch) hand_off(w);
+    }
+
+    void hand_off(size_t w) {
+        if (pending_[w].routes.empty() && pending_[w].added.empty()) return;
+        workers_[w]->push(std::move(pending_[w]));
+        pending_[w] = Batch{};
+        pending_[w].routes.reserve(kBatch);
+    }
+
+    std::string dir_;
+    std::vector<Worker*> workers_;
+    size_t buckets_;
+    std::vector<Batch> pending_;
+    flat_u64_map<uint64_t> orders_;   // OrderId -> symbol key
+    flat_u64_map<uint32_t> symbols_;  // symbol key (or bucket) -> output
+    uint32_t next_output_ = 0;
+    uint64_t key_ = 0;
+    uint64_t packets_ = 0;
+    uint64_t messages_ = 0;
+    uint64_t unrouted_ = 0;
+    uint64_t unparsed_ = 0;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    size_t buckets = 0;
+    size_t workers = 2;
+    size_t buffer_kb = 1024;
+    size_t max_open = 256;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&](size_t& out) {
+            if (i + 1 >= argc) return false;
+            out = std::strtoul(argv[++i], nullptr, 10);
+            return true;
+        };
+        if (arg == "-h" || arg == "--help") {
+            std::printf("%s", kUsage);
+            return 0;
+        } else if (arg == "--buckets" || arg == "--workers" || arg == "--buffer-kb" || arg == "--max-open") {
+            size_t& out = arg == "--buckets" ? buckets : arg == "--workers" ? workers
+                        : arg == "--buffer-kb" ? buffer_kb : max_open;
+            if (!value(out)) {
+                std::fprintf(stderr, "%s", kUsage);
+                return 2;
+            }
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (args.size() < 2 || workers == 0) {
+        std::fprintf(stderr, "%s", kUsage);
+        return 2;
+    }
+#if !MDP_SPLIT_ITCH
+    std::fprintf(stderr, "ITCH generated handlers not found. Generate code first.\n");
+    return 2;
+#endif
+
+    const std::string& dir = args[0];
+    ::mkdir(dir.c_str(), 0755);
+    struct stat st {};
+    if (::stat(dir.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+        std::fprintf(stderr, "mdp_split: cannot create output directory %s\n", dir.c_str());
+        return 1;
+    }
+
+    const char* off_env = std::getenv("PAYLOAD_OFFSET");
+    const size_t payload_offset = off_env ? std::strtoul(off_env, nullptr, 10) : 0;
+    capture_merge merge;
+    for (size_t i = 1; i < args.size(); ++i) {
+        if (merge.add(args[i], static_cast<uint32_t>(i - 1), payload_offset) != status::ok) {
+            std::fprintf(stderr, "mdp_split: cannot open pcap %s\n", args[i].c_str());
+            return 1;
+        }
+    }
+
+    split_config cfg;
+    cfg.buffer_bytes = buffer_kb << 10;
+    cfg.max_open = max_open / workers ? max_open / workers : 1;
+    std::vector<std::unique_ptr<Worker>> pool;
+    std::vector<Worker*> raw;
+    for (size_t w = 0; w < workers; ++w) {
+        pool.push_back(std::make_unique<Worker>(cfg, workers));
+        raw.push_back(pool.back().get());
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    Router router(dir, raw, buckets);
+    merge.for_each([&](Bytes pkt, const msg_context& ctx) { router.packet(pkt, ctx); });
+    router.finish();
+
+    int rc = 0;
+    split_stats total;
+    for (auto& w : pool) {
+        if (w->finish() != status::ok) {
+            std::fprintf(stderr, "mdp_split: write failed: %s\n", std::strerror(w->writer().error()));
+            rc = 1;
+        }
+        const split_stats& s = w->writer().stats();
+        total.records += s.records;
+        total.bytes += s.bytes;
+        total.writes += s.writes;
+        total.opens += s.opens;
+        total.evictions += s.evictions;
+    }
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    std::fprintf(stderr,
+                 "mdp_split: %llu packets, %llu messages -> %zu outputs (%llu unrouted, %llu unparsed)\n"
+                 "  %llu records, %.1f MB in %llu writes, %llu opens, %llu evictions, %zu orders open at end\n"
+                 "  %.3f s, %.1f MB/s\n",
+                 static_cast<unsigned long long>(router.packets()), static_cast<unsigned long long>(router.messages()),
+                 router.outputs(), static_cast<unsigned long long>(router.unrouted()),
+                 static_cast<unsigned long long>(router.unparsed()), static_cast<unsigned long long>(total.records),
+                 static_cast<double>(total.bytes) / 1e6, static_cast<unsigned long long>(total.writes),
+                 static_cast<unsigned long long>(total.opens), static_cast<unsigned long long>(total.evictions),
+                 router.open_orders(), secs, secs > 0 ? static_cast<double>(total.bytes) / 1e6 / secs : 0.0);
+    return rc;
+}
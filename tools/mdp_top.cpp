@@ -0,0 +1,153 @@
+// Live view of a feed handler's shared-memory statistics (runtime/stats_registry.hpp)
+//
+//   mdp_top /itch_feed_stats            refresh every second until interrupted
+//   mdp_top /itch_feed_stats -i 250     refresh every 250 ms
+//   mdp_top /itch_feed_stats --once     print one table and exit
+//
+// Counters show their value and the rate since the previous refresh, gauges
+// their current value, status counts one column per status and histograms
+// count and percentiles. The reader only maps the segment read-only; the feed
+// process never notices it.
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <signal.h>
+
+#include "runtime/stats_registry.hpp"
+#include "runtime/status.hpp"
+
+using market::runtime::stats_entry;
+using market::runtime::stats_histogram_snapshot;
+using market::runtime::stats_kind;
+using market::runtime::stats_reader;
+using market::runtime::status;
+
+namespace {
+
+uint64_t now_ns() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+bool writer_running(int64_t pid) {
+    return pid > 0 && (::kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+}
+
+const char* kind_name(stats_kind k) {
+    switch (k) {
+        case stats_kind::counter: return "counter";
+        case stats_kind::gauge: return "gauge";
+        case stats_kind::status_counts: return "status";
+        case stats_kind::histogram: return "histogram";
+    }
+    return "?";
+}
+
+// Previous counter values, for rates.
+struct Sample {
+    uint64_t value = 0;
+    uint64_t at_ns = 0;
+};
+
+void render(const char* segment, const stats_reader& r, std::unordered_map<std::string, Sample>& last, bool clear) {
+    const uint64_t now = now_ns();
+    if (clear) std::printf("\x1b[H\x1b[2J");
+    const uint64_t hb = r.heartbeat_ns();
+    std::printf("mdp_top %s  pid %" PRId64 " (%s)", segment, r.pid(), writer_running(r.pid()) ? "running" : "exited");
+    if (hb != 0 && now >= hb) std::printf("  heartbeat %.1f s ago", static_cast<double>(now - hb) / 1e9);
+    std::printf("  %u entries\n\n", r.size());
+    std::printf("%-40s %-9s %16s %14s  %s\n", "NAME", "KIND", "VALUE", "RATE/s", "DETAIL");
+
+    stats_histogram_snapshot h;
+    for (uint32_t i = 0; i < r.size(); ++i) {
+        const stats_entry e = r.entry(i);
+        const std::string name(e.name);
+        switch (e.kind) {
+            case stats_kind::counter: {
+                const uint64_t v = stats_reader::value(e);
+                auto it = last.find(name);
+                if (it != last.end() && now > it->second.at_ns && v >= it->second.value) {
+                    const double rate = static_cast<double>(v - it->second.value) * 1e9 /
+                                        static_cast<double>(now - it->second.at_ns);
+                    std::printf("%-40s %-9s %16" PRIu64 " %14.1f\n", name.c_str(), kind_name(e.kind), v, rate);
+                } else {
+                    std::printf("%-40s %-9s %16" PRIu64 " %14s\n", name.c_str(), kind_name(e.kind), v, "");
+                }
+                last[name] = Sample{v, now};
+                break;
+            }
+            case stats_kind::gauge:
+                std::printf("%-40s %-9s %16" PRId64 "\n", name.c_str(), kind_name(e.kind), stats_reader::gauge(e));
+                break;
+            case stats_kind::status_counts: {
+                uint64_t total = 0;
+                std::string detail;
+                for (status s : {status::ok, status::short_buffer, status::bad_value, status::unknown_type}) {
+                    const uint64_t n = stats_reader::status_count(e, s);
+                    total += n;
+                    detail += std::string(market::runtime::status_to_string(s)) + "=" + std::to_string(n) + " ";
+                }
+                std::printf("%-40s %-9s %16" PRIu64 " %14s  %s\n", name.c_str(), kind_name(e.kind), total, "",
+                            detail.c_str());
+                break;
+            }
+            case stats_kind::histogram:
+                stats_reader::histogram(e, h);
+                std::printf("%-40s %-9s %16" PRIu64 " %14s  min=%" PRIu64 " p50=%" PRIu64 " p90=%" PRIu64
+                            " p99=%" PRIu64 " p99.9=%" PRIu64 " max=%" PRIu64 "\n",
+                            name.c_str(), kind_name(e.kind), h.count, "", h.min, h.quantile(0.5), h.quantile(0.9),
+                            h.quantile(0.99), h.quantile(0.999), h.max);
+                break;
+            default:
+                std::printf("%-40s %-9s (unreadable descriptor)\n", name.c_str(), "?");
+                break;
+        }
+    }
+    std::fflush(stdout);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const char* segment = nullptr;
+    unsigned interval_ms = 1000;
+    bool once = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "-i" && i + 1 < argc) {
+            interval_ms = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--once") {
+            once = true;
+        } else if (arg == "-h" || arg == "--help") {
+            std::printf("Usage: mdp_top <segment> [-i interval_ms] [--once]\n");
+            return 0;
+        } else {
+            segment = argv[i];
+        }
+    }
+    if (!segment) {
+        std::fprintf(stderr, "Usage: mdp_top <segment> [-i interval_ms] [--once]\n");
+        return 2;
+    }
+
+    stats_reader r;
+    if (r.open(segment) != status::ok) {
+        std::fprintf(stderr, "mdp_top: cannot open statistics segment %s (missing or another layout version)\n",
+                     segment);
+        return 1;
+    }
+    std::unordered_map<std::string, Sample> last;
+    for (;;) {
+        render(segment, r, last, !once);
+        if (once) return 0;
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms ? interval_ms : 1));
+    }
+}
@@ -1,11 +1,15 @@
-// Minimal PCAP reader that decodes BOE/ITCH payloads and emits JSON per message
+// Minimal PCAP reader that decodes BOE/ITCH payloads and emits JSON per message,
+// wrapped with the capture timestamp, source feed, packet index and offset within
+// the packet. Several captures (e.g. one per feed line) are merged in global
+// timestamp order; the feed field is the file's position on the command line.
 #include <cstdint>
-#include <fstream>
+#include <cstdlib>
 #include <iostream>
-#include <vector>
 #include <string>
 
 #include "runtime/bytes.hpp"
+#include "runtime/capture_merge.hpp"
+#include "runtime/context.hpp"
 #include "runtime/status.hpp"
 
 #if __has_include("../../generated/cboe_boe_v3/handler.hpp")
@@ -17,63 +21,58 @@
 #include "../../generated/nasdaq_itch_5/json.hpp"
 #endif
 
-struct PcapGlobal {
-    uint32_t magic;
-    uint16_t vmajor;
-    uint16_t vminor;
-    int32_t thiszone;
-    uint32_t sigfigs;
-    uint32_t snaplen;
-    uint32_t network;
-};
-struct PcapRecHdr {
-    uint32_t ts_sec;
-    uint32_t ts_usec;
-    uint32_t incl_len;
-    uint32_t orig_len;
-};
+using market::runtime::Bytes;
+using market::runtime::msg_context;
+using market::runtime::status;
 
-static bool read_exact(std::ifstream& in, void* buf, size_t n) {
-    in.read(reinterpret_cast<char*>(buf), n);
-    return static_cast<size_t>(in.gcount()) == n;
+static void emit(const msg_context& ctx, const std::string& json) {
+    std::cout << "{\"capture_ns\":" << ctx.capture_ns << ",\"feed\":" << ctx.feed << ",\"packet\":" << ctx.packet_seq
+              << ",\"offset\":" << ctx.offset << ",\"msg\":" << json << "}\n";
+}
+
+// Dispatch every message in each merged packet, stamping its offset into ctx.
+template<typename Dispatch>
+static void run(market::runtime::capture_merge& merge, Dispatch&& dispatch) {
+    merge.for_each([&](Bytes pkt, const msg_context& packet_ctx) {
+        msg_context ctx = packet_ctx;
+        size_t off = 0;
+        while (off < pkt.size()) {
+            size_t consumed = 0;
+            ctx.offset = static_cast<uint32_t>(off);
+            auto st = dispatch(pkt.subspan(off), consumed, ctx);
+            if (st != status::ok || consumed == 0) break;
+            off += consumed;
+        }
+    });
 }
 
 int main(int argc, char** argv) {
     if (argc < 3) {
-        std::cerr << "Usage: pcap_decode <boe|itch> <pcap_file>" << std::endl;
+        std::cerr << "Usage: pcap_decode <boe|itch> <pcap_file> [pcap_file...]" << std::endl;
+        std::cerr << "  PAYLOAD_OFFSET env: bytes to strip per packet (e.g. 42 for Eth/IPv4/UDP)" << std::endl;
         return 1;
     }
     std::string protocol = argv[1];
-    std::ifstream in(argv[2], std::ios::binary);
-    if (!in) { std::cerr << "Cannot open: " << argv[2] << std::endl; return 1; }
+    const char* off_env = std::getenv("PAYLOAD_OFFSET");
+    const size_t payload_offset = off_env ? std::strtoul(off_env, nullptr, 10) : 0;
 
-    PcapGlobal gh{};
-    if (!read_exact(in, &gh, sizeof(gh))) { std::cerr << "Bad pcap header" << std::endl; return 1; }
-    const bool swap = (gh.magic == 0xd4c3b2a1); // little vs big endian magic
-    (void)swap; // assume native order for minimal demo
-
-    using market::runtime::Bytes;
-    using market::runtime::status;
+    market::runtime::capture_merge merge;
+    for (int i = 2; i < argc; ++i) {
+        if (merge.add(argv[i], static_cast<uint32_t>(i - 2), payload_offset) != status::ok) {
+            std::cerr << "Cannot open pcap: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
 
     if (protocol == "boe") {
 #if __has_include("../../generated/cboe_boe_v3/handler.hpp")
         struct H {
-            void on(const cboe::boe::v3::LoginRequest& m) { std::cout << cboe::boe::v3::to_json(m) << "\n"; }
-            void on(const cboe::boe::v3::NewOrderCross& m) { std::cout << cboe::boe::v3::to_json(m) << "\n"; }
+            void on(const cboe::boe::v3::LoginRequest& m, const msg_context& c) { emit(c, cboe::boe::v3::to_json(m)); }
+            void on(const cboe::boe::v3::NewOrderCross& m, const msg_context& c) { emit(c, cboe::boe::v3::to_json(m)); }
         } h;
-        while (in) {
-            PcapRecHdr rh{};
-            if (!read_exact(in, &rh, sizeof(rh))) break;
-            std::vector<uint8_t> pkt(rh.incl_len);
-            if (!read_exact(in, pkt.data(), pkt.size())) break;
-            size_t off = 0;
-            while (off < pkt.size()) {
-                size_t consumed = 0;
-                auto st = cboe::boe::v3::dispatch_boe(Bytes{pkt.data() + off, pkt.size() - off}, h, consumed);
-                if (st != status::ok || consumed == 0) break;
-                off += consumed;
-            }
-        }
+        run(merge, [&h](Bytes in, size_t& consumed, const msg_context& ctx) {
+            return cboe::boe::v3::dispatch_boe(in, h, consumed, ctx);
+        });
         return 0;
 #else
         std::cerr << "BOE generated handlers not found. Generate code first." << std::endl; return 2;
@@ -81,26 +80,15 @@ int main(int argc, char** argv) {
     } else {
 #if __has_include("../../generated/nasdaq_itch_5/handler.hpp")
         struct H {
-            void on(const nasdaq::itch::v5::AddOrder& m) { std::cout << nasdaq::itch::v5::to_json(m) << "\n"; }
-            void on(const nasdaq::itch::v5::DeleteOrder& m) { std::cout << nasdaq::itch::v5::to_json(m) << "\n"; }
+            void on(const nasdaq::itch::v5::AddOrder& m, const msg_context& c) { emit(c, nasdaq::itch::v5::to_json(m)); }
+            void on(const nasdaq::itch::v5::DeleteOrder& m, const msg_context& c) { emit(c, nasdaq::itch::v5::to_json(m)); }
         } h;
-        while (in) {
-            PcapRecHdr rh{};
-            if (!read_exact(in, &rh, sizeof(rh))) break;
-            std::vector<uint8_t> pkt(rh.incl_len);
-            if (!read_exact(in, pkt.data(), pkt.size())) break;
-            size_t off = 0;
-            while (off < pkt.size()) {
-                size_t consumed = 0;
-                auto st = nasdaq::itch::v5::dispatch_itch(Bytes{pkt.data() + off, pkt.size() - off}, h, consumed);
-                if (st != status::ok || consumed == 0) break;
-                off += consumed;
-            }
-        }
+        run(merge, [&h](Bytes in, size_t& consumed, const msg_context& ctx) {
+            return nasdaq::itch::v5::dispatch_itch(in, h, consumed, ctx);
+        });
         return 0;
 #else
         std::cerr << "ITCH generated handlers not found. Generate code first." << std::endl; return 2;
 #endif
     }
 }
-